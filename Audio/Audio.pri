@@ -1,5 +1,5 @@
 SOURCES += Audio/AudioDevice.cpp  Audio/BWFFile.cpp  Audio/soundin.cpp \
-	Audio/soundout.cpp
+	Audio/soundout.cpp Audio/RxArchive.cpp
 
 HEADERS += Audio/AudioDevice.hpp  Audio/BWFFile.hpp  Audio/soundin.h \
-	Audio/soundout.h
+	Audio/soundout.h Audio/RxArchive.hpp
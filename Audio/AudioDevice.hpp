@@ -32,6 +32,11 @@ public:
 
   Channel channel () const {return m_channel;}
 
+  // a source that can deliver more than one frame rate offers the
+  // rate it has chosen before it starts writing, the default is to
+  // accept only what the device was built for
+  virtual bool setSourceFrameRate (unsigned) {return false;}
+
 protected:
   AudioDevice (QObject * parent = nullptr)
     : QIODevice {parent}
@@ -0,0 +1,431 @@
+#include "RxArchive.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <QFile>
+#include <QDataStream>
+#include <QMutexLocker>
+
+namespace
+{
+  quint32 const SEGMENT_MAGIC {0x57535241}; // "WSRA"
+  quint32 const INDEX_MAGIC {0x57535249};   // "WSRI"
+  quint32 const RECORD_MAGIC {0x50455244};  // "PERD"
+  quint32 const VERSION {1};
+  quint32 const SAMPLE_RATE {12000};
+  int const BLOCK {4096};                   // samples
+  int const VERBATIM {3};                   // in place of the predictor order
+  quint32 const MAX_UNARY {1u << 20};       // longer is a damaged stream
+
+  void set_up (QDataStream& s)
+  {
+    s.setVersion (QDataStream::Qt_5_0);
+  }
+
+  class BitWriter final
+  {
+  public:
+    explicit BitWriter (QByteArray& out)
+      : out_ (out)
+      , acc_ {0}
+      , bits_ {0}
+    {
+    }
+
+    // the low n bits of value, n <= 32
+    void put (quint32 value, int n)
+    {
+      acc_ = (acc_ << n) | (value & ((quint64 {1} << n) - 1));
+      bits_ += n;
+      while (bits_ >= 8)
+        {
+          bits_ -= 8;
+          out_.append (static_cast<char> (acc_ >> bits_));
+        }
+      acc_ &= (quint64 {1} << bits_) - 1;
+    }
+
+    // q zeros and a one
+    void unary (quint32 q)
+    {
+      for (; q >= 32; q -= 32) put (0, 32);
+      put (1, q + 1);
+    }
+
+    void finish ()
+    {
+      if (bits_) put (0, 8 - bits_);
+    }
+
+  private:
+    QByteArray& out_;
+    quint64 acc_;
+    int bits_;
+  };
+
+  class BitReader final
+  {
+  public:
+    explicit BitReader (QByteArray const& in)
+      : p_ {reinterpret_cast<quint8 const *> (in.constData ())}
+      , end_ {p_ + in.size ()}
+      , acc_ {0}
+      , bits_ {0}
+    {
+    }
+
+    bool get (int n, quint32 * value)
+    {
+      while (bits_ < n)
+        {
+          if (p_ == end_) return false;
+          acc_ = (acc_ << 8) | *p_++;
+          bits_ += 8;
+        }
+      bits_ -= n;
+      *value = static_cast<quint32> (acc_ >> bits_) & static_cast<quint32> ((quint64 {1} << n) - 1);
+      acc_ &= (quint64 {1} << bits_) - 1;
+      return true;
+    }
+
+    bool unary (quint32 * q)
+    {
+      quint32 bit;
+      for (*q = 0; get (1, &bit); ++*q)
+        {
+          if (bit) return true;
+          if (*q > MAX_UNARY) return false;
+        }
+      return false;
+    }
+
+  private:
+    quint8 const * p_;
+    quint8 const * end_;
+    quint64 acc_;
+    int bits_;
+  };
+
+  quint32 zigzag (qint32 v)
+  {
+    return (static_cast<quint32> (v) << 1) ^ static_cast<quint32> (v >> 31);
+  }
+
+  qint32 unzigzag (quint32 u)
+  {
+    return static_cast<qint32> (u >> 1) ^ -static_cast<qint32> (u & 1);
+  }
+
+  // fixed polynomial predictors of order 0, 1 and 2
+  template<typename T>
+  qint32 prediction (T const * x, int i, int order)
+  {
+    switch (order)
+      {
+      case 0: return 0;
+      case 1: return x[i - 1];
+      default: return 2 * x[i - 1] - x[i - 2];
+      }
+  }
+
+  bool read_record_header (QDataStream& s, RxArchive::Period * period, QString * source,
+                           QString * comment, quint32 * bytes)
+  {
+    quint32 magic;
+    qint64 start;
+    s >> magic >> start >> period->samples >> *source >> *comment >> *bytes;
+    period->start = QDateTime::fromMSecsSinceEpoch (start, Qt::UTC);
+    return QDataStream::Ok == s.status () && RECORD_MAGIC == magic;
+  }
+
+  bool check_segment (QFile& segment, QString * error)
+  {
+    if (!segment.open (QIODevice::ReadOnly))
+      {
+        if (error) *error = segment.fileName () + ": " + segment.errorString ();
+        return false;
+      }
+    QDataStream s {&segment};
+    set_up (s);
+    quint32 magic, version, rate;
+    s >> magic >> version >> rate;
+    if (QDataStream::Ok != s.status () || SEGMENT_MAGIC != magic || VERSION != version
+        || SAMPLE_RATE != rate)
+      {
+        if (error) *error = segment.fileName () + ": not an RX audio archive segment";
+        return false;
+      }
+    return true;
+  }
+
+  // the periods of a segment, from the record headers
+  QList<RxArchive::Period> scan (QFile& segment, QString * error)
+  {
+    QList<RxArchive::Period> result;
+    QDataStream s {&segment};
+    set_up (s);
+    for (auto pos = segment.pos (); pos < segment.size (); )
+      {
+        RxArchive::Period period;
+        QString source, comment;
+        quint32 bytes;
+        segment.seek (pos);
+        if (!read_record_header (s, &period, &source, &comment, &bytes)
+            || segment.pos () + bytes > segment.size ())
+          {
+            if (error) *error = QString {"%1: damaged at offset %2"}.arg (segment.fileName ()).arg (pos);
+            break;
+          }
+        period.offset = pos;
+        result << period;
+        pos = segment.pos () + bytes;
+      }
+    return result;
+  }
+
+  bool write_index (QFile& index, QList<RxArchive::Period> const& periods)
+  {
+    QDataStream s {&index};
+    set_up (s);
+    if (!index.size ()) s << INDEX_MAGIC << VERSION;
+    for (auto const& period : periods)
+      {
+        s << qint64 {period.start.toMSecsSinceEpoch ()} << period.samples << period.offset;
+      }
+    return QDataStream::Ok == s.status () && index.flush ();
+  }
+}
+
+RxArchive::RxArchive (QDir const& directory)
+  : directory_ {directory}
+{
+}
+
+void RxArchive::set_directory (QDir const& directory)
+{
+  QMutexLocker lock {&mutex_};
+  directory_ = directory;
+}
+
+QString RxArchive::segment_path (QDateTime const& start) const
+{
+  return directory_.absoluteFilePath (start.toUTC ().toString ("'RX_'yyMMdd'.rxa'"));
+}
+
+QString RxArchive::append (QDateTime const& start, QString const& source, QString const& comment,
+                           short const * data, int samples)
+{
+  auto payload = encode (data, samples);
+
+  QMutexLocker lock {&mutex_};
+  auto path = segment_path (start);
+  QFile segment {path};
+  QFile index {path + ".idx"};
+  auto fresh = !segment.exists () || !segment.size ();
+  if (!fresh && !index.exists ())
+    {
+      // rebuild a lost index first so it stays complete
+      QString error;
+      if (check_segment (segment, &error))
+        {
+          auto periods = scan (segment, &error);
+          if (index.open (QIODevice::WriteOnly)) write_index (index, periods);
+          index.close ();
+        }
+      segment.close ();
+    }
+  if (!segment.open (QIODevice::WriteOnly | QIODevice::Append))
+    {
+      return path + ": " + segment.errorString ();
+    }
+  QDataStream s {&segment};
+  set_up (s);
+  if (fresh)
+    {
+      s << SEGMENT_MAGIC << VERSION << SAMPLE_RATE;
+    }
+  Period period {start.toUTC (), static_cast<quint32> (samples), segment.size ()};
+  s << RECORD_MAGIC << qint64 {start.toMSecsSinceEpoch ()} << period.samples
+    << source << comment << static_cast<quint32> (payload.size ());
+  s.writeRawData (payload.constData (), payload.size ());
+  if (QDataStream::Ok != s.status () || !segment.flush ())
+    {
+      return path + ": " + segment.errorString ();
+    }
+  segment.close ();
+
+  // a new segment starts a new index, dropping any left behind by a
+  // segment that was deleted or emptied
+  if (!index.open (fresh ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::WriteOnly | QIODevice::Append)
+      || !write_index (index, {period}))
+    {
+      return index.fileName () + ": " + index.errorString ();
+    }
+  return QString {};
+}
+
+QList<RxArchive::Period> RxArchive::periods (QString const& segment_path, QString * error)
+{
+  QFile segment {segment_path};
+  if (!check_segment (segment, error)) return {};
+  auto header_end = segment.pos ();
+
+  QFile index {segment_path + ".idx"};
+  if (index.open (QIODevice::ReadOnly))
+    {
+      QDataStream s {&index};
+      set_up (s);
+      quint32 magic, version;
+      s >> magic >> version;
+      QList<Period> result;
+      bool good {QDataStream::Ok == s.status () && INDEX_MAGIC == magic && VERSION == version};
+      while (good && !s.atEnd ())
+        {
+          qint64 start;
+          Period period;
+          s >> start >> period.samples >> period.offset;
+          period.start = QDateTime::fromMSecsSinceEpoch (start, Qt::UTC);
+          good = QDataStream::Ok == s.status () && period.offset >= header_end
+            && period.offset < segment.size ();
+          result << period;
+        }
+      if (good) return result;
+    }
+  segment.seek (header_end);
+  return scan (segment, error);
+}
+
+bool RxArchive::read (QString const& segment_path, Period const& period, QVector<short> * data,
+                      QString * source, QString * comment, QString * error)
+{
+  QFile segment {segment_path};
+  if (!check_segment (segment, error)) return false;
+  QDataStream s {&segment};
+  set_up (s);
+  Period header;
+  QString source_text, comment_text;
+  quint32 bytes;
+  if (!segment.seek (period.offset)
+      || !read_record_header (s, &header, &source_text, &comment_text, &bytes)
+      || header.samples != period.samples)
+    {
+      if (error) *error = QString {"%1: no period at offset %2"}.arg (segment_path).arg (period.offset);
+      return false;
+    }
+  auto payload = segment.read (bytes);
+  data->resize (header.samples);
+  if (payload.size () != static_cast<int> (bytes)
+      || !decode (payload, data->data (), data->size ()))
+    {
+      if (error) *error = QString {"%1: damaged period at offset %2"}.arg (segment_path).arg (period.offset);
+      return false;
+    }
+  if (source) *source = source_text;
+  if (comment) *comment = comment_text;
+  return true;
+}
+
+QByteArray RxArchive::encode (short const * x, int samples)
+{
+  QByteArray out;
+  out.reserve (samples * 2);
+  BitWriter w {out};
+  std::vector<quint32> u (BLOCK);
+  for (int b = 0; b < samples; b += BLOCK)
+    {
+      int m = std::min (BLOCK, samples - b);
+      short const * y = x + b;
+
+      // the predictor with the smallest residuals
+      int order {0};
+      quint64 least {std::numeric_limits<quint64>::max ()};
+      for (int o = 0; o < 3 && o < m; ++o)
+        {
+          quint64 sum {0};
+          for (int i = o; i < m; ++i) sum += std::abs (y[i] - prediction (y, i, o));
+          if (sum < least)
+            {
+              least = sum;
+              order = o;
+            }
+        }
+      for (int i = order; i < m; ++i) u[i] = zigzag (y[i] - prediction (y, i, order));
+
+      // the Rice parameter that codes them in fewest bits, the size
+      // is convex in k
+      int k {0};
+      quint64 bits {std::numeric_limits<quint64>::max ()};
+      for (int kk = 0; kk < 16; ++kk)
+        {
+          quint64 size {0};
+          for (int i = order; i < m; ++i) size += (u[i] >> kk) + 1 + kk;
+          if (size >= bits) break;
+          bits = size;
+          k = kk;
+        }
+
+      if (4 + 16 * order + bits >= 16 * static_cast<quint64> (m))
+        {
+          w.put (VERBATIM, 2);
+          for (int i = 0; i < m; ++i) w.put (static_cast<quint16> (y[i]), 16);
+        }
+      else
+        {
+          w.put (order, 2);
+          w.put (k, 4);
+          for (int i = 0; i < order; ++i) w.put (static_cast<quint16> (y[i]), 16);
+          for (int i = order; i < m; ++i)
+            {
+              w.unary (u[i] >> k);
+              if (k) w.put (u[i], k);
+            }
+        }
+    }
+  w.finish ();
+  return out;
+}
+
+bool RxArchive::decode (QByteArray const& in, short * x, int samples)
+{
+  BitReader r {in};
+  std::vector<qint32> y (BLOCK);
+  for (int b = 0; b < samples; b += BLOCK)
+    {
+      int m = std::min (BLOCK, samples - b);
+      quint32 order, k, v, q;
+      if (!r.get (2, &order)) return false;
+      if (VERBATIM == static_cast<int> (order))
+        {
+          for (int i = 0; i < m; ++i)
+            {
+              if (!r.get (16, &v)) return false;
+              x[b + i] = static_cast<short> (v);
+            }
+          continue;
+        }
+      if (!r.get (4, &k) || static_cast<int> (order) >= m) return false;
+      for (int i = 0; i < m; ++i)
+        {
+          if (i < static_cast<int> (order))
+            {
+              if (!r.get (16, &v)) return false;
+              y[i] = static_cast<short> (v);
+            }
+          else
+            {
+              if (!r.unary (&q)) return false;
+              v = 0;
+              if (k && !r.get (k, &v)) return false;
+              y[i] = prediction (y.data (), i, order) + unzigzag ((q << k) | v);
+              if (y[i] < std::numeric_limits<short>::min () || y[i] > std::numeric_limits<short>::max ())
+                {
+                  return false;
+                }
+            }
+          x[b + i] = static_cast<short> (y[i]);
+        }
+    }
+  return true;
+}
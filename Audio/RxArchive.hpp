@@ -0,0 +1,71 @@
+#ifndef RX_ARCHIVE_HPP__
+#define RX_ARCHIVE_HPP__
+
+#include <QtGlobal>
+#include <QString>
+#include <QDateTime>
+#include <QDir>
+#include <QList>
+#include <QVector>
+#include <QByteArray>
+#include <QMutex>
+
+//
+// RxArchive - continuous archive of received audio
+//
+// Every period of 12 kHz received audio is appended to a segment file
+// for the UTC day, RX_yyMMdd.rxa, instead of being saved as a WAV file
+// of its own. The samples are compressed losslessly: in blocks of
+// 4096, the best of the fixed polynomial predictors of order 0 to 2
+// is applied and the residuals are Rice coded, with blocks that don't
+// compress stored as they are. Each period record carries its start
+// time and the same metadata as a saved WAV file.
+//
+// A sidecar period index, RX_yyMMdd.rxa.idx, holds the start time,
+// sample count and file offset of each period, so a period can be
+// read without going through the rest of the segment. If the index
+// is missing the segment is scanned record header by record header.
+//
+// The rx_archive tool lists the periods in a segment and extracts
+// any of them as WAV files that can be given to jt9.
+//
+class RxArchive final
+{
+public:
+  struct Period
+  {
+    QDateTime start;
+    quint32 samples;
+    qint64 offset;              // of the period record in the segment
+  };
+
+  explicit RxArchive (QDir const& directory = QDir {});
+
+  void set_directory (QDir const&);
+
+  // the segment a period starting at start goes in
+  QString segment_path (QDateTime const& start) const;
+
+  // append a period, may be called from any thread, returns an error
+  // message or an empty string
+  QString append (QDateTime const& start, QString const& source, QString const& comment,
+                  short const * data, int samples);
+
+  //
+  // reading
+  //
+  static QList<Period> periods (QString const& segment_path, QString * error = nullptr);
+  static bool read (QString const& segment_path, Period const&, QVector<short> * data,
+                    QString * source = nullptr, QString * comment = nullptr,
+                    QString * error = nullptr);
+
+  // the codec
+  static QByteArray encode (short const * data, int samples);
+  static bool decode (QByteArray const&, short * data, int samples);
+
+private:
+  QDir directory_;
+  QMutex mutex_;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include <QAudioDeviceInfo>
 #include <QAudioFormat>
 #include <QAudioInput>
+#include <QList>
 #include <QSysInfo>
 #include <QDebug>
 
@@ -59,7 +60,8 @@ void SoundInput::start(QAudioDeviceInfo const& device, int framesPerBuffer, Audi
 //  qDebug () << "Preferred audio input format:" << format;
   format.setChannelCount (AudioDevice::Mono == channel ? 1 : 2);
   format.setCodec ("audio/pcm");
-  format.setSampleRate (12000 * downSampleFactor);
+  int nominal_rate = 12000 * downSampleFactor;
+  format.setSampleRate (nominal_rate);
   format.setSampleType (QAudioFormat::SignedInt);
   format.setSampleSize (16);
   format.setByteOrder (QAudioFormat::Endian (QSysInfo::ByteOrder));
@@ -68,12 +70,35 @@ void SoundInput::start(QAudioDeviceInfo const& device, int framesPerBuffer, Audi
       Q_EMIT error (tr ("Requested input audio format is not valid."));
       return;
     }
-  else if (!device.isFormatSupported (format))
+
+  // when resampling, fall back to another rate the sink can convert
+  // from if the device can't do the usual one, trying the device's
+  // preferred rate first
+  QList<int> rates {nominal_rate};
+  if (downSampleFactor > 1)
+    {
+      rates << device.preferredFormat ().sampleRate () << 96000 << 192000 << 44100;
+    }
+  auto rate = rates.begin ();
+  for (; rate != rates.end (); ++rate)
+    {
+      format.setSampleRate (*rate);
+      if (device.isFormatSupported (format)
+          && (m_sink->setSourceFrameRate (*rate) || *rate == nominal_rate))
+        {
+          break;
+        }
+    }
+  if (rate == rates.end ())
     {
 //      qDebug () << "Nearest supported audio format:" << device.nearestFormat (format);
       Q_EMIT error (tr ("Requested input audio format is not supported on device."));
       return;
     }
+  if (*rate != nominal_rate)
+    {
+      LOG_INFO ("Audio input at " << *rate << " Hz, resampled in software");
+    }
   // qDebug () << "Selected audio input format:" << format;
 
   m_stream.reset (new QAudioInput {device, format});
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <locale>
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QStringList>
+#include <QFileInfo>
+#include <QDir>
+#include <QAudioFormat>
+#include <QDateTime>
+#include <QVector>
+
+#include "revision_utils.hpp"
+#include "Audio/BWFFile.hpp"
+#include "Audio/RxArchive.hpp"
+
+namespace
+{
+  QTextStream qtout {stdout};
+
+  // named as WSJT-X names saved WAV files so that jt9 picks up the
+  // time from the name
+  QString wav_name (RxArchive::Period const& period)
+  {
+    return period.start.toString (period.samples >= 60 * 12000 ? "yyMMdd_hhmm" : "yyMMdd_hhmmss") + ".wav";
+  }
+
+  void extract (QString const& segment, RxArchive::Period const& period, QDir const& directory, bool force)
+  {
+    QVector<short> data;
+    QString source, comment, error;
+    if (!RxArchive::read (segment, period, &data, &source, &comment, &error))
+      {
+        throw std::runtime_error {error.toStdString ()};
+      }
+    auto file_name = directory.absoluteFilePath (wav_name (period));
+    if (!force && QFileInfo {file_name}.isFile ())
+      {
+        throw std::invalid_argument {"set the `-force' option to overwrite an existing output file"};
+      }
+
+    QAudioFormat format;
+    format.setCodec ("audio/pcm");
+    format.setSampleRate (12000);
+    format.setChannelCount (1);
+    format.setSampleSize (16);
+    format.setSampleType (QAudioFormat::SignedInt);
+    BWFFile::InfoDictionary list_info {
+      {{{'I','S','R','C'}}, source.toLocal8Bit ()},
+      {{{'I','S','F','T'}}, program_title (revision ()).simplified ().toLocal8Bit ()},
+      {{{'I','C','R','D'}}, period.start.toString ("yyyy-MM-ddTHH:mm:ss.zzzZ").toLocal8Bit ()},
+      {{{'I','C','M','T'}}, comment.toLocal8Bit ()},
+    };
+    BWFFile wav {format, file_name, list_info};
+    if (!wav.open (BWFFile::WriteOnly)
+        || 0 > wav.write (reinterpret_cast<char const *> (data.constData ())
+                          , sizeof (short) * data.size ()))
+      {
+        throw std::runtime_error {(file_name + ": " + wav.errorString ()).toStdString ()};
+      }
+    qtout << file_name << '\n';
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app {argc, argv};
+  try
+    {
+      // ensure number forms are in consistent format, do this after
+      // instantiating QApplication so that Qt has correct l18n
+      std::locale::global (std::locale::classic ());
+
+      // Override programs executable basename as application name.
+      app.setApplicationName ("WSJT-X RX Archive");
+      app.setApplicationVersion (version ());
+
+      QCommandLineParser parser;
+      parser.setApplicationDescription (
+                                        "\nTool to list and extract periods of received audio archived by WSJT-X\n\n"
+                                        "\tExtracted periods are written as WAV files that jt9 can decode\n"
+                                        );
+      auto help_option = parser.addHelpOption ();
+      auto version_option = parser.addVersionOption ();
+
+      parser.addOptions ({
+          {{"l", "list"},
+              app.translate ("main", "List the periods in the segment")},
+          {{"t", "time"},
+              app.translate ("main", "Extract the period starting at <time> (yyMMdd_hhmmss UTC)"),
+              app.translate ("main", "time")},
+          {{"n", "number"},
+              app.translate ("main", "Extract period <number> as listed"),
+              app.translate ("main", "number")},
+          {{"a", "all"},
+              app.translate ("main", "Extract all periods")},
+          {{"d", "directory"},
+              app.translate ("main", "Write WAV files to <directory>, default the current directory"),
+              app.translate ("main", "directory")},
+          {{"f", "force"},
+              app.translate ("main", "Overwrite existing files")},
+        });
+      parser.addPositionalArgument ("segment", app.translate ("main", "Archive segment, RX_yyMMdd.rxa"));
+      parser.process (app);
+
+      auto const& arguments = parser.positionalArguments ();
+      if (1 != arguments.size ()) throw std::invalid_argument {"one archive segment required"};
+      auto const& segment = arguments[0];
+      QString error;
+      auto periods = RxArchive::periods (segment, &error);
+      if (error.size ()) std::cerr << "Warning: " << error.toStdString () << '\n';
+
+      if (parser.isSet ("l") || !(parser.isSet ("t") || parser.isSet ("n") || parser.isSet ("a")))
+        {
+          int n {0};
+          for (auto const& period : periods)
+            {
+              qtout << ++n << " - " << period.start.toString ("yyyy-MM-dd hh:mm:ss")
+                    << QString {" %1 s"}.arg (period.samples / 12000., 0, 'f', 1) << '\n';
+            }
+          return 0;
+        }
+
+      QDir directory {parser.isSet ("d") ? parser.value ("d") : QDir::currentPath ()};
+      if (!directory.exists ()) throw std::invalid_argument {"output directory does not exist"};
+      auto force = parser.isSet ("f");
+      if (parser.isSet ("a"))
+        {
+          for (auto const& period : periods) extract (segment, period, directory, force);
+        }
+      else if (parser.isSet ("n"))
+        {
+          bool ok;
+          auto n = parser.value ("n").toInt (&ok);
+          if (!ok || 0 >= n || n > periods.size ()) throw std::invalid_argument {"invalid period number"};
+          extract (segment, periods[n - 1], directory, force);
+        }
+      else
+        {
+          auto time = QDateTime::fromString (parser.value ("t"), "yyMMdd_hhmmss");
+          if (!time.isValid ()) throw std::invalid_argument {"invalid time"};
+          time = time.addYears (100 * ((QDate::currentDate ().year () - time.date ().year ()) / 100));
+          time.setTimeSpec (Qt::UTC);
+          bool found {false};
+          for (auto const& period : periods)
+            {
+              if (period.start <= time && time < period.start.addMSecs (period.samples / 12))
+                {
+                  extract (segment, period, directory, force);
+                  found = true;
+                  break;
+                }
+            }
+          if (!found) throw std::invalid_argument {"no period at that time"};
+        }
+      return 0;
+    }
+  catch (std::exception const& e)
+    {
+      std::cerr << "Error: " << e.what () << '\n';
+    }
+  catch (...)
+    {
+      std::cerr << "Unexpected fatal error\n";
+      throw; // hoping the runtime might tell us more about the exception
+    }
+  return -1;
+}
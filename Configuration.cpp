@@ -179,6 +179,7 @@
 
 #include "pimpl_impl.hpp"
 #include "Logger.hpp"
+#include "StartupTimer.hpp"
 #include "qt_helpers.hpp"
 #include "MetaDataRegistry.hpp"
 #include "SettingsGroup.hpp"
@@ -910,6 +911,7 @@ private:
   bool accept_udp_requests_;
   bool udpWindowToFront_;
   bool udpWindowRestore_;
+  bool publish_spectrum_;
   DataMode data_mode_;
   bool bLowSidelobes_;
   bool sortAlphabetically_;
@@ -1067,6 +1069,7 @@ bool Configuration::broadcast_to_cloudlog () const {return m_->bCloudLog_;}
 bool Configuration::lowSidelobes() const {return m_->bLowSidelobes_;}
 bool Configuration::udpWindowToFront () const {return m_->udpWindowToFront_;}
 bool Configuration::udpWindowRestore () const {return m_->udpWindowRestore_;}
+bool Configuration::publish_spectrum () const {return m_->publish_spectrum_;}
 Bands * Configuration::bands () {return &m_->bands_;}
 Bands const * Configuration::bands () const {return &m_->bands_;}
 StationList * Configuration::stations () {return &m_->stations_;}
@@ -2090,6 +2093,7 @@ void Configuration::impl::initialize_models ()
   ui_->enable_n1mm_broadcast_check_box->setChecked (broadcast_to_n1mm_);
   ui_->udpWindowToFront->setChecked(udpWindowToFront_);
   ui_->udpWindowRestore->setChecked(udpWindowRestore_);
+  ui_->publish_spectrum_check_box->setChecked (publish_spectrum_);
   ui_->calibration_intercept_spin_box->setValue (calibration_.intercept);
   ui_->calibration_slope_ppm_spin_box->setValue (calibration_.slope_ppm);
   ui_->rbLowSidelobes->setChecked(bLowSidelobes_);
@@ -2480,6 +2484,7 @@ void Configuration::impl::read_settings ()
   accept_udp_requests_ = settings_->value ("AcceptUDPRequests", false).toBool ();
   udpWindowToFront_ = settings_->value ("udpWindowToFront",false).toBool ();
   udpWindowRestore_ = settings_->value ("udpWindowRestore",false).toBool ();
+  publish_spectrum_ = settings_->value ("PublishSpectrum", false).toBool ();
   calibration_.intercept = settings_->value ("CalibrationIntercept", 0.).toDouble ();
   calibration_.slope_ppm = settings_->value ("CalibrationSlopePPM", 0.).toDouble ();
   sortAlphabetically_ = settings_->value("SortAlphabetically",true).toBool ();
@@ -2522,6 +2527,8 @@ void Configuration::impl::read_settings ()
 
 void Configuration::impl::find_audio_devices ()
 {
+  // QtMultimedia's backends are not documented as thread safe, so
+  // both enumerations stay on this thread
   //
   // retrieve audio input device
   //
@@ -2545,6 +2552,7 @@ void Configuration::impl::find_audio_devices ()
       update_audio_channels (ui_->sound_output_combo_box, ui_->sound_output_combo_box->currentIndex (), ui_->sound_output_channel_combo_box, true);
       ui_->sound_output_channel_combo_box->setCurrentIndex (next_audio_output_channel_);
     }
+  StartupTimer::mark ("audio devices");
 }
 
 void Configuration::impl::write_settings ()
@@ -2725,6 +2733,7 @@ void Configuration::impl::write_settings ()
   settings_->setValue ("AcceptUDPRequests", accept_udp_requests_);
   settings_->setValue ("udpWindowToFront", udpWindowToFront_);
   settings_->setValue ("udpWindowRestore", udpWindowRestore_);
+  settings_->setValue ("PublishSpectrum", publish_spectrum_);
   settings_->setValue ("CalibrationIntercept", calibration_.intercept);
   settings_->setValue ("CalibrationSlopePPM", calibration_.slope_ppm);
   settings_->setValue ("SortAlphabetically", sortAlphabetically_);
@@ -3302,6 +3311,7 @@ void Configuration::impl::accept ()
 
   udpWindowToFront_ = ui_->udpWindowToFront->isChecked ();
   udpWindowRestore_ = ui_->udpWindowRestore->isChecked ();
+  publish_spectrum_ = ui_->publish_spectrum_check_box->isChecked ();
 
   if (macros_.stringList () != next_macros_.stringList ())
     {
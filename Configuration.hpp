@@ -233,6 +233,7 @@ public:
   bool accept_udp_requests () const;
   bool udpWindowToFront () const;
   bool udpWindowRestore () const;
+  bool publish_spectrum () const;
   Bands * bands ();
   Bands const * bands () const;
   IARURegions::Region region () const;
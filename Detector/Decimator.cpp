@@ -0,0 +1,211 @@
+#include "Decimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#if defined (__SSE__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DECIMATOR_SSE
+#elif defined (__ARM_NEON) || defined (__ARM_NEON__)
+#include <arm_neon.h>
+#define DECIMATOR_NEON
+#endif
+
+namespace
+{
+  unsigned const max_up {160};	// e.g. 40 for 44.1 kHz, 80 for 22.05 kHz
+
+  // FIR lowpass filter designed using ScopeFIR, formerly in fil4.f90
+  //
+  // fsample     = 48000 Hz
+  // Ntaps       = 49
+  // fc          = 4500  Hz
+  // fstop       = 6000  Hz
+  // Ripple      = 1     dB
+  // Stop Atten  = 40    dB
+  // fout        = 12000 Hz
+  float const fil4_taps[] {
+     0.000861074040f, 0.010051920210f, 0.010161983649f, 0.011363155076f,
+     0.008706594219f, 0.002613872664f,-0.005202883094f,-0.011720748164f,
+    -0.013752163325f,-0.009431602741f, 0.000539063909f, 0.012636767098f,
+     0.021494659597f, 0.021951235065f, 0.011564169382f,-0.007656470131f,
+    -0.028965787341f,-0.042637874109f,-0.039203309748f,-0.013153301537f,
+     0.034320769178f, 0.094717832646f, 0.154224604789f, 0.197758325022f,
+     0.213715139513f, 0.197758325022f, 0.154224604789f, 0.094717832646f,
+     0.034320769178f,-0.013153301537f,-0.039203309748f,-0.042637874109f,
+    -0.028965787341f,-0.007656470131f, 0.011564169382f, 0.021951235065f,
+     0.021494659597f, 0.012636767098f, 0.000539063909f,-0.009431602741f,
+    -0.013752163325f,-0.011720748164f,-0.005202883094f, 0.002613872664f,
+     0.008706594219f, 0.011363155076f, 0.010161983649f, 0.010051920210f,
+     0.000861074040f
+  };
+
+  // design parameters for other rates
+  double const pass_band {4500.};
+  double const stop_band {6000.};
+  double const attenuation {60.}; // dB
+
+  unsigned gcd (unsigned a, unsigned b)
+  {
+    while (b)
+      {
+        auto r = a % b;
+        a = b;
+        b = r;
+      }
+    return a;
+  }
+
+  // zeroth order modified Bessel function of the first kind
+  double bessel_i0 (double x)
+  {
+    double sum {1.}, term {1.};
+    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k)
+      {
+        term *= (x / (2. * k)) * (x / (2. * k));
+        sum += term;
+      }
+    return sum;
+  }
+
+  // Kaiser windowed sinc low-pass at L times the input rate, with a
+  // gain of L to make up for the zeros implied by up-sampling
+  std::vector<double> design (unsigned up, unsigned inputRate, size_t taps)
+  {
+    double const pi {4. * std::atan (1.)};
+    double const beta {0.1102 * (attenuation - 8.7)};
+    double const fc {(pass_band + stop_band) / 2. / (double (up) * inputRate)};
+    size_t const n {taps * up};
+    double const centre {(n - 1) / 2.};
+    std::vector<double> h (n);
+    for (size_t k = 0; k < n; ++k)
+      {
+        double t = k - centre;
+        double sinc = t != 0. ? std::sin (2. * pi * fc * t) / (pi * t) : 2. * fc;
+        double r = 2. * t / (n - 1);
+        h[k] = up * sinc * bessel_i0 (beta * std::sqrt (std::max (0., 1. - r * r))) / bessel_i0 (beta);
+      }
+    return h;
+  }
+
+  inline float dot (float const * a, float const * b, size_t n)
+  {
+#if defined (DECIMATOR_SSE)
+    __m128 acc = _mm_setzero_ps ();
+    for (size_t i = 0; i < n; i += 4)
+      {
+        acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+      }
+    acc = _mm_add_ps (acc, _mm_movehl_ps (acc, acc));
+    acc = _mm_add_ss (acc, _mm_shuffle_ps (acc, acc, 1));
+    return _mm_cvtss_f32 (acc);
+#elif defined (DECIMATOR_NEON)
+    float32x4_t acc = vdupq_n_f32 (0.f);
+    for (size_t i = 0; i < n; i += 4)
+      {
+        acc = vmlaq_f32 (acc, vld1q_f32 (a + i), vld1q_f32 (b + i));
+      }
+    float32x2_t s = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+    return vget_lane_f32 (vpadd_f32 (s, s), 0);
+#else
+    float acc[4] {0.f, 0.f, 0.f, 0.f};
+    for (size_t i = 0; i < n; i += 4)
+      {
+        acc[0] += a[i] * b[i];
+        acc[1] += a[i + 1] * b[i + 1];
+        acc[2] += a[i + 2] * b[i + 2];
+        acc[3] += a[i + 3] * b[i + 3];
+      }
+    return (acc[0] + acc[2]) + (acc[1] + acc[3]);
+#endif
+  }
+}
+
+bool Decimator::supports (unsigned inputRate, unsigned outputRate)
+{
+  return outputRate && inputRate >= outputRate
+    && outputRate / gcd (inputRate, outputRate) <= max_up;
+}
+
+Decimator::Decimator (unsigned inputRate, unsigned outputRate)
+  : m_inputRate {inputRate}
+  , m_outputRate {outputRate}
+{
+  Q_ASSERT (supports (inputRate, outputRate));
+  auto g = gcd (inputRate, outputRate);
+  m_up = outputRate / g;
+  m_down = inputRate / g;
+
+  std::vector<double> h;
+  if (48000u == inputRate && 12000u == outputRate)
+    {
+      h.assign (std::begin (fil4_taps), std::end (fil4_taps));
+    }
+  else if (m_up > 1 || m_down > 1)
+    {
+      double const pi {4. * std::atan (1.)};
+      double dw {2. * pi * (stop_band - pass_band) / inputRate};
+      h = design (m_up, inputRate, static_cast<size_t> (std::ceil ((attenuation - 8.) / (2.285 * dw))) + 1);
+    }
+  else
+    {
+      h.assign (1, 1.);		// same rate, just copy
+    }
+
+  // split into phases, each padded to a multiple of four taps at the
+  // oldest end and stored time reversed so an output sample is the
+  // inner product of a phase with a contiguous run of input
+  size_t taps {(h.size () + m_up - 1) / m_up};
+  m_taps = (taps + 3) & ~size_t {3};
+  m_coefficients.assign (m_up * m_taps, 0.f);
+  for (unsigned p = 0; p < m_up; ++p)
+    {
+      for (size_t j = 0; p + j * m_up < h.size (); ++j)
+        {
+          m_coefficients[p * m_taps + m_taps - 1 - j] = h[p + j * m_up];
+        }
+    }
+  m_history.reserve (m_taps - 1 + 16384);
+  reset ();
+}
+
+void Decimator::reset ()
+{
+  m_history.assign (m_taps - 1, 0.f);
+  // first output at the end of the first block of M inputs, as fil4 did
+  m_position = (m_down - 1) / m_up;
+  m_phase = (m_down - 1) % m_up;
+}
+
+size_t Decimator::framesNeeded (size_t outputFrames) const
+{
+  if (!outputFrames) return 0;
+  return m_position + (m_phase + (outputFrames - 1) * quint64 {m_down}) / m_up + 1;
+}
+
+size_t Decimator::process (qint16 const * source, size_t numFrames, qint16 * dest)
+{
+  auto old = m_history.size ();
+  m_history.resize (old + numFrames);
+  std::copy (source, source + numFrames, m_history.begin () + old);
+
+  qint16 * out {dest};
+  float const * x {m_history.data ()};
+  while (m_position < numFrames)
+    {
+      auto y = std::lround (dot (&m_coefficients[m_phase * m_taps], x + m_position, m_taps));
+      *out++ = static_cast<qint16> (qBound<long> (std::numeric_limits<qint16>::min (), y,
+                                                  std::numeric_limits<qint16>::max ()));
+      m_phase += m_down;
+      m_position += m_phase / m_up;
+      m_phase %= m_up;
+    }
+  m_position -= numFrames;
+
+  // keep just what the next call needs
+  std::copy (m_history.end () - (m_taps - 1), m_history.end (), m_history.begin ());
+  m_history.resize (m_taps - 1);
+  return out - dest;
+}
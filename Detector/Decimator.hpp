@@ -0,0 +1,57 @@
+#ifndef DECIMATOR_HPP__
+#define DECIMATOR_HPP__
+
+#include <cstddef>
+#include <vector>
+#include <QtGlobal>
+
+//
+// Polyphase FIR sample rate converter from an audio device rate down
+// to the decoder rate
+//
+// The ratio of the rates is reduced to up/down factors L/M and the
+// anti-alias low-pass is split into L phases, so only the taps that
+// contribute to an output sample are evaluated, M input samples per
+// output apart. Incoming samples are appended to a history buffer
+// which is moved down once per call rather than once per sample, and
+// the inner products are vectorized where SSE or NEON is available.
+//
+// 48 kHz to 12 kHz uses the 49 tap filter of the old fil4 routine so
+// the decoder sees the same data as before; other rates get a Kaiser
+// windowed sinc with the same 4.5 kHz pass band and 6 kHz stop band.
+//
+class Decimator
+{
+public:
+  explicit Decimator (unsigned inputRate = 48000u, unsigned outputRate = 12000u);
+
+  // true if inputRate can be converted to outputRate
+  static bool supports (unsigned inputRate, unsigned outputRate);
+
+  unsigned inputRate () const {return m_inputRate;}
+  unsigned outputRate () const {return m_outputRate;}
+
+  void reset ();		// discard history
+
+  // number of input frames that complete exactly the next outputFrames
+  // output samples
+  size_t framesNeeded (size_t outputFrames) const;
+
+  // convert numFrames input samples, returning the number of output
+  // samples written to dest
+  size_t process (qint16 const * source, size_t numFrames, qint16 * dest);
+
+private:
+  unsigned m_inputRate;
+  unsigned m_outputRate;
+  unsigned m_up;		// L
+  unsigned m_down;		// M
+  size_t m_taps;		// per phase, a multiple of 4
+  std::vector<float> m_coefficients; // m_up phases, time reversed
+  std::vector<float> m_history;	// m_taps - 1 old samples then new ones
+  size_t m_position;		// newest input of next output, from
+				// the first new sample
+  unsigned m_phase;
+};
+
+#endif
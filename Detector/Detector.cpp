@@ -7,10 +7,6 @@
 
 #include "moc_Detector.cpp"
 
-extern "C" {
-  void   fil4_(qint16*, qint32*, qint16*, qint32*);
-}
-
 extern dec_data_t dec_data;
 
 Detector::Detector (unsigned frameRate, double periodLengthInSeconds,
@@ -20,14 +16,28 @@ Detector::Detector (unsigned frameRate, double periodLengthInSeconds,
   , m_period (periodLengthInSeconds)
   , m_downSampleFactor (downSampleFactor)
   , m_samplesPerFFT {max_buffer_size}
+  , m_decimator {frameRate * downSampleFactor, frameRate}
   , m_buffer ((downSampleFactor > 1) ?
               new short [max_buffer_size * downSampleFactor] : nullptr)
   , m_bufferPos (0)
 {
-  (void)m_frameRate;            // quell compiler warning
   clear ();
 }
 
+bool Detector::setSourceFrameRate (unsigned rate)
+{
+  if (m_downSampleFactor < 2 || !Decimator::supports (rate, m_frameRate))
+    {
+      return false;
+    }
+  if (rate != m_decimator.inputRate ())
+    {
+      m_decimator = Decimator {rate, m_frameRate};
+      m_bufferPos = 0;
+    }
+  return true;
+}
+
 void Detector::setBlockSize (unsigned n)
 {
   m_samplesPerFFT = n;
@@ -67,9 +77,12 @@ qint64 Detector::writeData (char const * data, qint64 maxSize)
 
   // no torn frames
   Q_ASSERT (!(maxSize % static_cast<qint64> (bytesPerFrame ())));
+  // room left in the decoder buffer, after down sampling
+  size_t samplesAcceptable (sizeof (dec_data.d2) /
+                            sizeof (dec_data.d2[0]) - dec_data.params.kin);
   // these are in terms of input frames (not down sampled)
-  size_t framesAcceptable ((sizeof (dec_data.d2) /
-                            sizeof (dec_data.d2[0]) - dec_data.params.kin) * m_downSampleFactor);
+  size_t framesAcceptable (m_downSampleFactor > 1 ?
+                           m_decimator.framesNeeded (samplesAcceptable) : samplesAcceptable);
   size_t framesAccepted (qMin (static_cast<size_t> (maxSize /
                                                     bytesPerFrame ()), framesAcceptable));
 
@@ -80,33 +93,29 @@ qint64 Detector::writeData (char const * data, qint64 maxSize)
     }
 
     for (unsigned remaining = framesAccepted; remaining; ) {
-      size_t numFramesProcessed (qMin (m_samplesPerFFT *
-                                       m_downSampleFactor - m_bufferPos, remaining));
+      size_t numFramesProcessed;
 
       if(m_downSampleFactor > 1) {
+        // feed the decimator up to the end of the current block of
+        // output, in pieces that fit the staging buffer
+        unsigned samplesWanted (m_bufferPos < static_cast<unsigned> (m_samplesPerFFT) ?
+                                m_samplesPerFFT - m_bufferPos : 1u);
+        numFramesProcessed = qMin (qMin (m_decimator.framesNeeded (samplesWanted),
+                                         static_cast<size_t> (remaining)),
+                                   max_buffer_size * m_downSampleFactor);
         store (&data[(framesAccepted - remaining) * bytesPerFrame ()],
-               numFramesProcessed, &m_buffer[m_bufferPos]);
-        m_bufferPos += numFramesProcessed;
-
-        if(m_bufferPos==m_samplesPerFFT*m_downSampleFactor) {
-          qint32 framesToProcess (m_samplesPerFFT * m_downSampleFactor);
-          qint32 framesAfterDownSample (m_samplesPerFFT);
-          if(m_downSampleFactor > 1 && dec_data.params.kin>=0 &&
-             dec_data.params.kin < (NTMAX*12000 - framesAfterDownSample)) {
-            fil4_(&m_buffer[0], &framesToProcess, &dec_data.d2[dec_data.params.kin],
-                  &framesAfterDownSample);
-            dec_data.params.kin += framesAfterDownSample;
-          } else {
-            // qDebug() << "framesToProcess     = " << framesToProcess;
-            // qDebug() << "dec_data.params.kin = " << dec_data.params.kin;
-            // qDebug() << "secondInPeriod      = " << secondInPeriod();
-            // qDebug() << "framesAfterDownSample" << framesAfterDownSample;
-          }
+               numFramesProcessed, &m_buffer[0]);
+        size_t samplesAfterDownSample (m_decimator.process (&m_buffer[0], numFramesProcessed,
+                                                            &dec_data.d2[dec_data.params.kin]));
+        dec_data.params.kin += samplesAfterDownSample;
+        m_bufferPos += samplesAfterDownSample;
+        if (m_bufferPos >= static_cast<unsigned> (m_samplesPerFFT)) {
           Q_EMIT framesWritten (dec_data.params.kin);
           m_bufferPos = 0;
         }
 
       } else {
+        numFramesProcessed = qMin (m_samplesPerFFT - m_bufferPos, remaining);
         store (&data[(framesAccepted - remaining) * bytesPerFrame ()],
                numFramesProcessed, &dec_data.d2[dec_data.params.kin]);
         m_bufferPos += numFramesProcessed;
@@ -2,6 +2,7 @@
 #define DETECTOR_HPP__
 #include "Audio/AudioDevice.hpp"
 #include <QScopedArrayPointer>
+#include "Decimator.hpp"
 
 //
 // output device that distributes data in predefined chunks via a signal
@@ -18,7 +19,8 @@ public:
   // if the data buffer were not global storage and fixed size then we
   // might want maximum size passed as constructor arguments
   //
-  // we down sample by a factor of 4
+  // we down sample by a factor of 4, or from another source frame
+  // rate offered via setSourceFrameRate, to frameRate
   //
   // the samplesPerFFT argument is the number after down sampling
   //
@@ -27,6 +29,7 @@ public:
 
   void setTRPeriod(double p) {m_period=p;}
   bool reset () override;
+  bool setSourceFrameRate (unsigned) override;
 
   Q_SIGNAL void framesWritten (qint64) const;
   Q_SLOT void setBlockSize (unsigned);
@@ -47,12 +50,13 @@ private:
   unsigned m_downSampleFactor;
   qint32 m_samplesPerFFT;	// after any down sampling
   static size_t const max_buffer_size {7 * 512};
+  Decimator m_decimator;
   QScopedArrayPointer<short> m_buffer; // de-interleaved sample buffer
-  // big enough for all the
-  // samples for one increment of
-  // data (a signals worth) at
-  // the input sample rate
-  unsigned m_bufferPos;
+                                       // staging input for the
+                                       // decimator
+  unsigned m_bufferPos;                // samples since the last
+                                       // framesWritten signal, after
+                                       // any down sampling
 };
 
 #endif
@@ -1,5 +1,8 @@
 #include "Modulator.hpp"
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <qmath.h>
 #include <QDateTime>
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -24,6 +27,13 @@ extern float gran();		// Noise generator (for tests only)
 
 double constexpr Modulator::m_twoPi;
 
+namespace
+{
+  // longer messages are generated on the fly rather than use too much
+  // memory
+  unsigned const max_cached_frames {48000 * 120};
+}
+
 //    float wpm=20.0;
 //    unsigned m_nspd=1.2*48000.0/wpm;
 //    m_nspd=3072;                           //18.75 WPM
@@ -42,6 +52,10 @@ Modulator::Modulator (unsigned frameRate, double periodLengthInSeconds,
   , m_cwLevel {false}
   , m_j0 {-1}
   , m_toneFrequency0 {1500.0}
+  , m_waveStart {0}
+  , m_waveFrequency {0.0}
+  , m_waveAmp {0.0}
+  , m_wavePrecomputed {false}
 {
 }
 
@@ -100,6 +114,8 @@ void Modulator::start (QString mode, unsigned symbolsLength, double framesPerSym
         }
     }
 
+  renderWaveform ();
+
   initialize (QIODevice::ReadOnly, channel);
   Q_EMIT stateChanged ((m_state = (synchronize && m_silentFrames) ?
                         Synchronizing : Active));
@@ -117,6 +133,131 @@ void Modulator::start (QString mode, unsigned symbolsLength, double framesPerSym
     }
 }
 
+//
+// Render the message from the current frame to the end of its fade
+// out, this matches what readData() would synthesize sample by sample
+// but the phase is advanced by complex rotation rather than calling
+// qSin() for every sample.
+//
+void Modulator::renderWaveform ()
+{
+  dropWaveform ();
+  if (m_tuning || m_bFastMode || m_fSpread > 0.0 || m_TRperiod == 3.0 || m_nsps == 6)
+    {
+      return;                   // generated on the fly
+    }
+  unsigned i0 = (m_symbolsLength - 0.017) * 4.0 * m_nsps;
+  unsigned i1 = m_symbolsLength * 4.0 * m_nsps;
+  if (m_ic > i1 || i1 - m_ic >= max_cached_frames)
+    {
+      return;
+    }
+
+  m_waveStart = m_ic;
+  m_waveFrequency = m_frequency;
+  m_wavePrecomputed = m_toneSpacing < 0 && itone[0] < 100;
+  m_wave.resize (i1 + 1 - m_ic);
+  auto wave = m_wave.data ();
+  double amp = std::numeric_limits<qint16>::max ();
+  if (m_wavePrecomputed)
+    {
+      for (unsigned ic = m_ic; ic <= i1; ++ic)
+        {
+          *wave++ = qRound (amp * foxcom_.wave[ic]);
+        }
+      m_waveAmp = amp;
+      return;
+    }
+
+  if (m_ic > i0 + 1)
+    {
+      amp *= std::pow (0.98, m_ic - 1 - i0); // part way through fade out
+    }
+  double const baud (12000.0 / m_nsps);
+  double phi {m_phi};
+  double c {0.}, s {0.}, cw {1.}, sw {0.}, dphi {0.};
+  unsigned isym0 {std::numeric_limits<unsigned>::max ()};
+  for (unsigned ic = m_ic; ic <= i1; ++ic)
+    {
+      unsigned isym = ic / (4.0 * m_nsps);
+      if (isym != isym0)
+        {
+          double toneFrequency;
+          if (itone[0] >= 100)
+            {
+              toneFrequency = itone[0];
+            }
+          else if (m_toneSpacing == 0.0)
+            {
+              toneFrequency = m_frequency + itone[isym] * baud;
+            }
+          else
+            {
+              toneFrequency = m_frequency + itone[isym] * m_toneSpacing;
+            }
+          dphi = m_twoPi * toneFrequency / m_frameRate;
+          m_waveSegments << WaveSegment {ic, phi, dphi};
+          c = std::cos (phi);
+          s = std::sin (phi);
+          cw = std::cos (dphi);
+          sw = std::sin (dphi);
+          isym0 = isym;
+        }
+      auto t = c * cw - s * sw;
+      s = s * cw + c * sw;
+      c = t;
+      phi += dphi;
+      if (phi > m_twoPi) phi -= m_twoPi;
+      if (ic > i0) amp *= 0.98;
+      *wave++ = qRound (amp * s);
+    }
+  m_waveAmp = amp;
+}
+
+//
+// Discard the precomputed waveform, leaving the phase and amplitude
+// where synthesis of the rest of the message can carry on from.
+//
+void Modulator::dropWaveform ()
+{
+  if (!m_wave.isEmpty () && !m_wavePrecomputed && m_waveSegments.size ())
+    {
+      auto segment = std::upper_bound (m_waveSegments.begin (), m_waveSegments.end (), m_ic
+                                       , [] (unsigned ic, WaveSegment const& seg) {
+                                           return ic < seg.start_;
+                                         });
+      if (segment != m_waveSegments.begin ())
+        {
+          --segment;
+          m_phi = std::fmod (segment->phi_ + (m_ic - segment->start_) * segment->dphi_, m_twoPi);
+          m_isym0 = std::numeric_limits<unsigned>::max (); // recalculate tone
+          unsigned i0 = (m_symbolsLength - 0.017) * 4.0 * m_nsps;
+          m_amp = std::numeric_limits<qint16>::max ();
+          if (m_ic > i0 + 1) m_amp *= std::pow (0.98, m_ic - 1 - i0);
+        }
+    }
+  m_wave.clear ();
+  m_waveSegments.clear ();
+}
+
+bool Modulator::waveformValid (unsigned end) const
+{
+  return !m_wave.isEmpty ()
+    && !m_tuning && m_fSpread <= 0.0
+    && end + 1 == m_waveStart + unsigned (m_wave.size ())
+    && m_ic >= m_waveStart
+    && (m_wavePrecomputed || m_frequency == m_waveFrequency);
+}
+
+void Modulator::refreshWaveform ()
+{
+  if (Idle != m_state)
+    {
+      dropWaveform ();
+      renderWaveform ();
+    }
+}
+
 void Modulator::tune (bool newState)
 {
   m_tuning = newState;
@@ -278,6 +419,26 @@ qint64 Modulator::readData (char * data, qint64 maxSize)
 
         qint16 sample;
 
+        if (!m_wave.isEmpty () && !waveformValid (i1)) {
+          dropWaveform ();      // e.g. TX frequency changed, synthesize the rest
+        }
+        if (!m_wave.isEmpty () && m_ic <= i1) {
+          // copy from the precomputed waveform
+          if (Mono == channel () && !m_addNoise) {
+            qint64 n = qMin (qint64 (end - samples), qint64 (i1 + 1 - m_ic));
+            std::memcpy (samples, m_wave.constData () + (m_ic - m_waveStart), n * sizeof (qint16));
+            samples += n;
+            framesGenerated += n;
+            m_ic += n;
+          }
+          while (samples != end && m_ic <= i1) {
+            samples = load (postProcessSample (m_wave[m_ic - m_waveStart]), samples);
+            ++framesGenerated;
+            ++m_ic;
+          }
+          if (m_ic > i1) m_amp = m_waveAmp;
+        }
+
         while (samples != end && m_ic <= i1) {
           isym=0;
           if(!m_tuning and m_TRperiod!=3.0) isym=m_ic/(4.0*m_nsps);   //Actual fsample=48000
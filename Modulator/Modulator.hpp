@@ -3,6 +3,7 @@
 
 #include <QAudio>
 #include <QPointer>
+#include <QVector>
 
 #include "Audio/AudioDevice.hpp"
 
@@ -15,6 +16,11 @@ class SoundOutput;
 // Output can be muted while underway, preserving waveform timing when
 // transmission is resumed.
 //
+// Where possible the message waveform is rendered once when a
+// transmission starts, so the audio thread only has to copy samples.
+// Tuning, fast modes, frequency spread, and CW ID are generated on the
+// fly as is the rest of a message if the TX frequency is changed.
+//
 class Modulator
   : public AudioDevice
 {
@@ -42,6 +48,7 @@ public:
   Q_SLOT void stop (bool quick = false);
   Q_SLOT void tune (bool newState = true);
   Q_SLOT void setFrequency (double newFrequency) {m_frequency = newFrequency;}
+  Q_SLOT void refreshWaveform (); // tones have changed during transmission
   Q_SIGNAL void stateChanged (ModulatorState) const;
 
 protected:
@@ -53,6 +60,9 @@ protected:
 
 private:
   qint16 postProcessSample (qint16 sample) const;
+  void renderWaveform ();
+  void dropWaveform ();
+  bool waveformValid (unsigned end) const;
 
   QPointer<SoundOutput> m_stream;
   bool m_quickClose;
@@ -91,6 +101,20 @@ private:
   unsigned m_isym0;
   int m_j0;
   double m_toneFrequency0;
+
+  // precomputed message waveform
+  struct WaveSegment            // one per symbol, to recover the phase
+  {
+    unsigned start_;
+    double phi_;
+    double dphi_;
+  };
+  QVector<qint16> m_wave;
+  QVector<WaveSegment> m_waveSegments;
+  unsigned m_waveStart;         // frame index of m_wave[0]
+  double m_waveFrequency;
+  double m_waveAmp;             // amplitude after the last frame
+  bool m_wavePrecomputed;       // from foxcom_.wave
 };
 
 #endif
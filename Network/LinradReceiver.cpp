@@ -0,0 +1,322 @@
+#include "LinradReceiver.hpp"
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <QString>
+#include <QThread>
+#include <QSemaphore>
+#include <QUdpSocket>
+#include <QElapsedTimer>
+#ifdef Q_OS_LINUX
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <poll.h>
+#endif
+
+#include "pimpl_impl.hpp"
+
+namespace
+{
+  int const PACKET_SIZE {1416};
+  int const BATCH {64};                        // datagrams per receive
+  int const SOCKET_BUFFER {8 * 1024 * 1024};   // the OS may give less
+  int const POLL_MSEC {100};                   // how often to check for stop
+  int const MAX_GAP {4096};                    // over 7 s of r*4 data
+  int const MAX_LATE {64};                     // further back resyncs
+}
+
+static_assert (sizeof (LinradReceiver::Packet) == PACKET_SIZE, "timf2 packets are 1416 bytes");
+
+class LinradReceiver::impl final
+  : public QThread
+{
+public:
+  struct Slot
+  {
+    Packet packet;
+    unsigned gap;
+  };
+
+  explicit impl (unsigned ring_packets)
+    : mask_ {1}
+    , head_ {0}
+    , tail_ {0}
+    , stop_ {false}
+    , port_ {0}
+    , bound_ {false}
+  {
+    while (mask_ < ring_packets) mask_ <<= 1;
+    ring_.resize (mask_);
+    scratch_.resize (BATCH);
+    --mask_;
+    reset ();
+  }
+
+  ~impl ()
+  {
+    halt ();
+  }
+
+  void reset ()
+  {
+    head_ = 0;
+    tail_ = 0;
+    have_last_ = false;
+    pending_gap_ = 0;
+    packets_ = 0;
+    lost_ = 0;
+    late_ = 0;
+    overruns_ = 0;
+    bad_ = 0;
+    resyncs_ = 0;
+    packets_per_second_ = 0.;
+  }
+
+  void halt ()
+  {
+    stop_ = true;
+    wait ();
+    stop_ = false;
+  }
+
+  void run () override;
+  bool readable (QUdpSocket *);
+  int receive (QUdpSocket *, Packet * buffers[], int sizes[], int n);
+  bool sequence (quint16 iblk, unsigned * gap);
+
+  unsigned mask_;
+  std::vector<Slot> ring_;
+  std::vector<Packet> scratch_;                // for when the ring is full
+  std::atomic<unsigned> head_;                 // written by the receiver
+  std::atomic<unsigned> tail_;                 // written by the consumer
+  std::atomic<bool> stop_;
+  quint16 port_;
+  bool bound_;
+  QString reason_;
+  QSemaphore started_;
+
+  // receiver thread only
+  bool have_last_;
+  quint16 last_;
+  unsigned pending_gap_;
+
+  std::atomic<quint64> packets_;
+  std::atomic<quint64> lost_;
+  std::atomic<quint64> late_;
+  std::atomic<quint64> overruns_;
+  std::atomic<quint64> bad_;
+  std::atomic<quint64> resyncs_;
+  std::atomic<double> packets_per_second_;
+};
+
+void LinradReceiver::impl::run ()
+{
+  QUdpSocket socket;
+  bound_ = socket.bind (port_, QUdpSocket::ShareAddress);
+  if (!bound_)
+    {
+      reason_ = socket.errorString ();
+      started_.release ();
+      return;
+    }
+  // Room for a few seconds of packets in case this thread is starved
+  socket.setSocketOption (QUdpSocket::ReceiveBufferSizeSocketOption, SOCKET_BUFFER);
+  started_.release ();
+
+  Packet * buffers[BATCH];
+  int sizes[BATCH];
+  QElapsedTimer timer;
+  quint64 packets0 {0};
+  timer.start ();
+  while (!stop_)
+    {
+      if (!readable (&socket)) continue;
+      auto head = head_.load (std::memory_order_relaxed);
+      int room = mask_ + 1 - (head - tail_.load (std::memory_order_acquire));
+      int n = std::min (room, BATCH);
+      bool full = !n;
+      if (full)
+        {
+          // keep draining the socket so that the loss is accounted for
+          n = BATCH;
+          for (int i = 0; i < n; ++i) buffers[i] = &scratch_[i];
+        }
+      else
+        {
+          for (int i = 0; i < n; ++i) buffers[i] = &ring_[(head + i) & mask_].packet;
+        }
+
+      int received = receive (&socket, buffers, sizes, n);
+      int accepted {0};
+      for (int i = 0; i < received; ++i)
+        {
+          unsigned gap;
+          if (sizes[i] != PACKET_SIZE)
+            {
+              ++bad_;
+              continue;
+            }
+          if (!sequence (buffers[i]->iblk, &gap)) continue;
+          if (full)
+            {
+              ++overruns_;
+              pending_gap_ += gap + 1;
+              continue;
+            }
+          auto& slot = ring_[(head + accepted) & mask_];
+          if (&slot.packet != buffers[i])      // close up after discards
+            {
+              std::memcpy (&slot.packet, buffers[i], PACKET_SIZE);
+            }
+          slot.gap = gap + pending_gap_;
+          pending_gap_ = 0;
+          ++accepted;
+        }
+      if (accepted)
+        {
+          head_.store (head + accepted, std::memory_order_release);
+          packets_ += accepted;
+        }
+
+      if (timer.elapsed () >= 1000)
+        {
+          quint64 packets = packets_;
+          packets_per_second_ = 1000. * (packets - packets0) / timer.restart ();
+          packets0 = packets;
+        }
+    }
+}
+
+bool LinradReceiver::impl::readable (QUdpSocket * socket)
+{
+#ifdef Q_OS_LINUX
+  pollfd pfd {static_cast<int> (socket->socketDescriptor ()), POLLIN, 0};
+  return poll (&pfd, 1, POLL_MSEC) > 0;
+#else
+  return socket->hasPendingDatagrams () || socket->waitForReadyRead (POLL_MSEC);
+#endif
+}
+
+int LinradReceiver::impl::receive (QUdpSocket * socket, Packet * buffers[], int sizes[], int n)
+{
+#ifdef Q_OS_LINUX
+  // one system call for as many datagrams as are waiting
+  mmsghdr messages[BATCH];
+  iovec iov[BATCH];
+  std::memset (messages, 0, n * sizeof messages[0]);
+  for (int i = 0; i < n; ++i)
+    {
+      iov[i].iov_base = buffers[i];
+      iov[i].iov_len = PACKET_SIZE;
+      messages[i].msg_hdr.msg_iov = &iov[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+  int received = recvmmsg (static_cast<int> (socket->socketDescriptor ()), messages, n, MSG_DONTWAIT, nullptr);
+  for (int i = 0; i < received; ++i)
+    {
+      sizes[i] = messages[i].msg_hdr.msg_flags & MSG_TRUNC ? -1 : static_cast<int> (messages[i].msg_len);
+    }
+  return std::max (received, 0);
+#else
+  int received {0};
+  while (received < n && socket->hasPendingDatagrams ())
+    {
+      auto size = socket->pendingDatagramSize ();
+      sizes[received] = socket->readDatagram (reinterpret_cast<char *> (buffers[received]), PACKET_SIZE);
+      if (size != PACKET_SIZE) sizes[received] = -1;
+      ++received;
+    }
+  return received;
+#endif
+}
+
+// Check the block number of a packet against the last one accepted,
+// false if the packet is to be discarded
+bool LinradReceiver::impl::sequence (quint16 iblk, unsigned * gap)
+{
+  *gap = 0;
+  if (!have_last_)
+    {
+      have_last_ = true;
+      last_ = iblk;
+      return true;
+    }
+  int step = static_cast<qint16> (static_cast<quint16> (iblk - last_));
+  if (step > 1 && step <= MAX_GAP)
+    {
+      *gap = step - 1;
+      lost_ += *gap;
+    }
+  else if (step <= 0 && step > -MAX_LATE)
+    {
+      ++late_;
+      return false;
+    }
+  else if (step != 1)
+    {
+      ++resyncs_;
+    }
+  last_ = iblk;
+  return true;
+}
+
+LinradReceiver::LinradReceiver (unsigned ring_packets)
+  : m_ {ring_packets}
+{
+}
+
+LinradReceiver::~LinradReceiver ()
+{
+}
+
+bool LinradReceiver::start (quint16 port, QString * reason)
+{
+  stop ();
+  m_->reset ();
+  m_->port_ = port;
+  m_->start (QThread::HighestPriority);
+  m_->started_.acquire ();
+  if (!m_->bound_)
+    {
+      m_->wait ();
+      if (reason) *reason = m_->reason_;
+      return false;
+    }
+  return true;
+}
+
+void LinradReceiver::stop ()
+{
+  m_->halt ();
+}
+
+bool LinradReceiver::is_running () const
+{
+  return m_->isRunning ();
+}
+
+auto LinradReceiver::front (unsigned * gap) -> Packet *
+{
+  auto tail = m_->tail_.load (std::memory_order_relaxed);
+  if (tail == m_->head_.load (std::memory_order_acquire)) return nullptr;
+  auto& slot = m_->ring_[tail & m_->mask_];
+  if (gap) *gap = slot.gap;
+  return &slot.packet;
+}
+
+void LinradReceiver::pop ()
+{
+  auto tail = m_->tail_.load (std::memory_order_relaxed);
+  if (tail != m_->head_.load (std::memory_order_acquire))
+    {
+      m_->tail_.store (tail + 1, std::memory_order_release);
+    }
+}
+
+auto LinradReceiver::statistics () const -> Statistics
+{
+  return {m_->packets_, m_->lost_, m_->late_, m_->overruns_, m_->bad_
+      , m_->resyncs_, m_->packets_per_second_};
+}
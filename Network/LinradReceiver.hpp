@@ -0,0 +1,78 @@
+#ifndef LINRAD_RECEIVER_HPP_
+#define LINRAD_RECEIVER_HPP_
+
+#include <QtGlobal>
+#include "pimpl_h.hpp"
+
+class QString;
+
+//
+// LinradReceiver - receive the timf2 UDP packets sent by Linrad (or
+//                  an SDR program emulating it) on a thread of its own
+//
+// Datagrams are read in batches straight into the slots of a single
+// producer, single consumer ring, so that a consumer held up for a
+// while, e.g. the QMAP or MAP65 SoundInThread waiting for the GUI,
+// does not let the socket buffer overflow.
+//
+// The Linrad block number of each packet is checked, every packet
+// handed to the consumer carries the number of packets missing just
+// before it so that the gap can be zero filled, keeping the sample
+// stream in step with time. Packets older than one already accepted
+// are counted as late and discarded. A large jump either way, as
+// when Linrad is restarted, just resynchronizes.
+//
+class LinradReceiver final
+{
+public:
+  // The timf2 network packet, 1416 bytes
+  struct Packet
+  {
+    double cfreq;
+    int msec;
+    float userfreq;
+    int iptr;
+    quint16 iblk;
+    qint8 nrx;
+    char iusb;
+    double d8[174];
+  };
+
+  struct Statistics
+  {
+    quint64 packets;            // accepted
+    quint64 lost;               // missing from the block sequence
+    quint64 late;               // out of order or duplicates, discarded
+    quint64 overruns;           // discarded because the ring was full
+    quint64 bad;                // datagrams of the wrong size
+    quint64 resyncs;            // large jumps in the block sequence
+    double packets_per_second;  // over the last second
+  };
+
+  explicit LinradReceiver (unsigned ring_packets = 4096);
+  ~LinradReceiver ();
+
+  // bind to port and start receiving, false and a reason if that fails
+  bool start (quint16 port, QString * reason = nullptr);
+  void stop ();
+  bool is_running () const;
+
+  //
+  // consumer side, to be called from one thread only
+  //
+  // front() returns the oldest packet received, or nullptr if there
+  // is none, and sets *gap to the number of packets lost just before
+  // it; the packet stays valid until pop() is called
+  //
+  Packet * front (unsigned * gap = nullptr);
+  void pop ();
+
+  // may be called from any thread
+  Statistics statistics () const;
+
+private:
+  class impl;
+  pimpl<impl> m_;
+};
+
+#endif
@@ -10,6 +10,9 @@
 #include <QHostInfo>
 #include <QTimer>
 #include <QQueue>
+#include <QList>
+#include <QVector>
+#include <QHash>
 #include <QByteArray>
 #include <QColor>
 #include <QDebug>
@@ -27,6 +30,16 @@
 #define TRACE_UDP(MSG)
 #endif
 
+namespace
+{
+  // DecodeBatch messages are kept  small enough to fit in one Ethernet
+  // frame, larger datagrams are fragmented and more likely to be lost
+  int constexpr max_batch_size {1400}; // bytes
+
+  // longest time a decode is held back waiting for more to batch with
+  int constexpr batch_hold_time {500}; // mS
+}
+
 class MessageClient::impl
   : public QUdpSocket
 {
@@ -45,10 +58,15 @@ public:
     , TTL_ {TTL}
     , schema_ {2}  // use 2 prior to negotiation not 1 which is broken
     , heartbeat_timer_ {new QTimer {this}}
+    , batch_timer_ {new QTimer {this}}
+    , batch_count_ {0}
   {
     connect (heartbeat_timer_, &QTimer::timeout, this, &impl::heartbeat);
     connect (this, &QIODevice::readyRead, this, &impl::pending_datagrams);
 
+    batch_timer_->setSingleShot (true);
+    connect (batch_timer_, &QTimer::timeout, this, &impl::flush_decodes);
+
     heartbeat_timer_->start (NetworkMessage::pulse * 1000);
   }
 
@@ -70,6 +88,10 @@ public:
   void pending_datagrams ();
   void heartbeat ();
   void closedown ();
+  void batch_decode (bool is_new, QTime time, qint32 snr, float delta_time, quint32 delta_frequency
+                     , QString const& mode, QString const& message_text, bool low_confidence
+                     , bool off_air);
+  void flush_decodes ();
   StreamStatus check_status (QDataStream const&) const;
   void send_message (QByteArray const&, bool queue_if_pending = true, bool allow_duplicates = false);
   void send_message (QDataStream const& out, QByteArray const& message, bool queue_if_pending = true, bool allow_duplicates = false)
@@ -101,6 +123,19 @@ public:
   // hold messages sent before host lookup completes asynchronously
   QQueue<QByteArray> pending_messages_;
   QByteArray last_message_;
+
+  // decodes  waiting  to be  sent as  a DecodeBatch  message, see
+  // NetworkMessage.hpp for the format
+  QTimer * batch_timer_;
+  bool batch_new_;
+  QTime batch_time_;
+  QString batch_mode_;
+  bool batch_off_air_;
+  QList<QByteArray> batch_strings_;
+  QHash<QByteArray, quint16> batch_string_index_;
+  QByteArray batch_records_;
+  quint16 batch_count_;
+  int batch_size_;
 };
 
 #include "MessageClient.moc"
@@ -453,6 +488,8 @@ void MessageClient::impl::closedown ()
 {
    if (server_port_ && !server_.isNull ())
     {
+      flush_decodes ();
+
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::Close, id_, schema_};
       TRACE_UDP ("");
@@ -460,6 +497,99 @@ void MessageClient::impl::closedown ()
     }
 }
 
+void MessageClient::impl::batch_decode (bool is_new, QTime time, qint32 snr, float delta_time
+                                        , quint32 delta_frequency, QString const& mode
+                                        , QString const& message_text, bool low_confidence
+                                        , bool off_air)
+{
+  if (batch_count_
+      && (is_new != batch_new_ || time != batch_time_ || mode != batch_mode_ || off_air != batch_off_air_))
+    {
+      flush_decodes ();         // batches share these fields
+    }
+
+  QVector<QByteArray> tokens;
+  for (auto const& token : message_text.split (' '))
+    {
+      tokens << token.toUtf8 ();
+    }
+  auto record_size = 2 + 2 + 2 + 1 + 1 + 2 * tokens.size ();
+  auto new_strings_size = 0;
+  for (auto const& token : tokens)
+    {
+      if (!batch_string_index_.contains (token))
+        {
+          new_strings_size += 4 + token.size ();
+        }
+    }
+  if (batch_count_ && batch_size_ + new_strings_size + 2 + record_size > max_batch_size)
+    {
+      flush_decodes ();
+    }
+
+  if (!batch_count_)
+    {
+      batch_new_ = is_new;
+      batch_time_ = time;
+      batch_mode_ = mode;
+      batch_off_air_ = off_air;
+      // fixed header  fields: magic, schema, type,  id, new, time,
+      // mode, off air, string count and decode count
+      batch_size_ = 4 + 4 + 4 + 4 + id_.toUtf8 ().size () + 1 + 4 + 4 + mode.toUtf8 ().size () + 1 + 2 + 2;
+      batch_timer_->start (batch_hold_time);
+    }
+
+  QByteArray record;
+  QDataStream out {&record, QIODevice::WriteOnly};
+  out << static_cast<qint16> (qBound (-32768, snr, 32767))
+      << static_cast<qint16> (qBound (-32768, qRound (delta_time * 1000.f), 32767))
+      << static_cast<quint16> (qMin (delta_frequency, 65535u))
+      << static_cast<quint8> (low_confidence ? 1 : 0)
+      << static_cast<quint8> (tokens.size ());
+  for (auto const& token : tokens)
+    {
+      auto iter = batch_string_index_.find (token);
+      if (iter == batch_string_index_.end ())
+        {
+          iter = batch_string_index_.insert (token, batch_strings_.size ());
+          batch_strings_ << token;
+          batch_size_ += 4 + token.size ();
+        }
+      out << *iter;
+    }
+  QDataStream records {&batch_records_, QIODevice::WriteOnly | QIODevice::Append};
+  records << static_cast<quint16> (record.size ());
+  records.writeRawData (record.constData (), record.size ());
+  batch_size_ += 2 + record.size ();
+  ++batch_count_;
+}
+
+void MessageClient::impl::flush_decodes ()
+{
+  batch_timer_->stop ();
+  if (!batch_count_) return;
+
+  if (server_port_ && !server_.isNull ())
+    {
+      QByteArray message;
+      NetworkMessage::Builder out {&message, NetworkMessage::DecodeBatch, id_, schema_};
+      out << batch_new_ << batch_time_ << batch_mode_.toUtf8 () << batch_off_air_
+          << static_cast<quint16> (batch_strings_.size ());
+      for (auto const& string : batch_strings_)
+        {
+          out << string;
+        }
+      out << batch_count_;
+      out.writeRawData (batch_records_.constData (), batch_records_.size ());
+      TRACE_UDP ("new:" << batch_new_ << "time:" << batch_time_ << "mode:" << batch_mode_ << "off air:" << batch_off_air_ << "strings:" << batch_strings_.size () << "decodes:" << batch_count_ << "size:" << message.size ());
+      send_message (out, message);
+    }
+  batch_strings_.clear ();
+  batch_string_index_.clear ();
+  batch_records_.clear ();
+  batch_count_ = 0;
+}
+
 void MessageClient::impl::send_message (QByteArray const& message, bool queue_if_pending, bool allow_duplicates)
 {
   if (server_port_)
@@ -590,6 +720,7 @@ void MessageClient::status_update (Frequency f, QString const& mode, QString con
 {
   if (m_->server_port_ && !m_->server_.isNull ())
     {
+      m_->flush_decodes ();
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::Status, m_->id_, m_->schema_};
       out << f << mode.toUtf8 () << dx_call.toUtf8 () << report.toUtf8 () << tx_mode.toUtf8 ()
@@ -608,6 +739,13 @@ void MessageClient::decode (bool is_new, QTime time, qint32 snr, float delta_tim
 {
    if (m_->server_port_ && !m_->server_.isNull ())
     {
+      if (m_->schema_ >= NetworkMessage::decode_batch_schema
+          && message_text.count (' ') < 255) // token count is a quint8
+        {
+          m_->batch_decode (is_new, time, snr, delta_time, delta_frequency, mode, message_text
+                            , low_confidence, off_air);
+          return;
+        }
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::Decode, m_->id_, m_->schema_};
       out << is_new << time << snr << delta_time << delta_frequency << mode.toUtf8 ()
@@ -617,12 +755,18 @@ void MessageClient::decode (bool is_new, QTime time, qint32 snr, float delta_tim
     }
 }
 
+void MessageClient::flush_decodes ()
+{
+  m_->flush_decodes ();
+}
+
 void MessageClient::WSPR_decode (bool is_new, QTime time, qint32 snr, float delta_time, Frequency frequency
                                  , qint32 drift, QString const& callsign, QString const& grid, qint32 power
                                  , bool off_air)
 {
    if (m_->server_port_ && !m_->server_.isNull ())
     {
+      m_->flush_decodes ();
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::WSPRDecode, m_->id_, m_->schema_};
       out << is_new << time << snr << delta_time << frequency << drift << callsign.toUtf8 ()
@@ -636,6 +780,7 @@ void MessageClient::decodes_cleared ()
 {
    if (m_->server_port_ && !m_->server_.isNull ())
     {
+      m_->flush_decodes ();
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::Clear, m_->id_, m_->schema_};
       TRACE_UDP ("");
@@ -654,6 +799,7 @@ void MessageClient::qso_logged (QDateTime time_off, QString const& dx_call, QStr
 {
    if (m_->server_port_ && !m_->server_.isNull ())
     {
+      m_->flush_decodes ();
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::QSOLogged, m_->id_, m_->schema_};
       out << time_off << dx_call.toUtf8 () << dx_grid.toUtf8 () << dial_frequency << mode.toUtf8 ()
@@ -670,6 +816,7 @@ void MessageClient::logged_ADIF (QByteArray const& ADIF_record)
 {
    if (m_->server_port_ && !m_->server_.isNull ())
     {
+      m_->flush_decodes ();
       QByteArray message;
       NetworkMessage::Builder out {&message, NetworkMessage::LoggedADIF, m_->id_, m_->schema_};
       QByteArray ADIF {"\n<adif_ver:5>3.1.0\n<programid:6>WSJT-X\n<EOH>\n" + ADIF_record + " <EOR>"};
@@ -68,6 +68,11 @@ public:
   Q_SLOT void decode (bool is_new, QTime time, qint32 snr, float delta_time, quint32 delta_frequency
                       , QString const& mode, QString const& message, bool low_confidence
                       , bool off_air);
+
+  // send any decodes held back for batching now, call this when a
+  // decode pass is complete
+  Q_SLOT void flush_decodes ();
+
   Q_SLOT void WSPR_decode (bool is_new, QTime time, qint32 snr, float delta_time, Frequency
                            , qint32 drift, QString const& callsign, QString const& grid, qint32 power
                            , bool off_air);
@@ -7,6 +7,7 @@ Network/NetworkAccessManager.cpp \
 Network/NetworkMessage.cpp \
 Network/NetworkServerLookup.cpp \
 Network/PSKReporter.cpp \
+Network/SpectrumFeed.cpp \
 Network/wsprnet.cpp
 
 HEADERS    += \
@@ -18,4 +19,5 @@ Network/NetworkAccessManager.hpp \
 Network/NetworkMessage.hpp \
 Network/NetworkServerLookup.hpp \
 Network/PSKReporter.hpp \
+Network/SpectrumFeed.hpp \
 Network/wsprnet.h
@@ -35,7 +35,7 @@ namespace NetworkMessage
       }
 #endif
 #if QT_VERSION >= QT_VERSION_CHECK (5, 4, 0)
-    else if (schema <= 3)
+    else if (schema <= 4)
       {
         setVersion (QDataStream::Qt_5_4); // Qt schema version
       }
@@ -80,7 +80,7 @@ namespace NetworkMessage
         }
 #endif
 #if QT_VERSION >= QT_VERSION_CHECK (5, 4, 0)
-      else if (schema_ <= 3)
+      else if (schema_ <= 4)
         {
           parent->setVersion (QDataStream::Qt_5_4);
         }
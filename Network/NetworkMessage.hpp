@@ -73,6 +73,14 @@
  *
  * Schema Version 3:- this schema uses the QDataStream::Qt_5_4 version.
  *
+ * Schema Version 4:- this schema uses the QDataStream::Qt_5_4 version
+ *  exactly  as  schema  3  does.  A  peer that  negotiates  schema 4
+ *  additionally  accepts the  DecodeBatch message  type (see below),
+ *  clients that have negotiated  schema 4 or higher may send decodes
+ *  as DecodeBatch  messages instead of individual  Decode messages.
+ *  Servers  must  not  advertise  schema  4 unless  they  understand
+ *  DecodeBatch messages.
+ *
  *
  * Backward Compatibility
  * ----------------------
@@ -529,6 +537,51 @@
  *      ffffffff will remove the sort-order value from the internal table.
  *      Callsigns without a sort order will be valued at zero for sorting purposes
  *      in the hound display.
+ *
+ *
+ * DecodeBatch    Out      17                     quint32
+ *                         Id (unique key)        utf8
+ *                         New                    bool
+ *                         Time                   QTime
+ *                         Mode                   utf8
+ *                         Off air                bool
+ *                         String count           quint16
+ *                           String               utf8  (repeated)
+ *                         Decode count           quint16
+ *                           Record size          quint16  (repeated)
+ *                           Record               Record size bytes
+ *
+ *                         Record:
+ *                           snr                  qint16
+ *                           Delta time (mS)      qint16
+ *                           Delta frequency (Hz) quint16
+ *                           Flags                quint8
+ *                           Token count          quint8
+ *                             Token              quint16 (repeated)
+ *
+ *      This message  is only sent  to servers that  have negotiated
+ *      schema  4 or  higher, it  carries several  decodes, normally
+ *      all the decodes of one T/R period, that share the same 'New',
+ *      'Time',  'Mode' and  'Off air'  values of  the Decode message
+ *      above.  Clients  limit  the  size  of  each  DecodeBatch  so
+ *      that  it  fits  in  a single  Ethernet  frame,  a busy period
+ *      may therefore be sent as more than one DecodeBatch.
+ *
+ *      The  message  text  of  each decode  is split  on  each space
+ *      character into  tokens, which may be  empty, each token  is
+ *      sent once in the  string table  and referenced by its zero
+ *      based  index.  The message  text  is recovered exactly  by
+ *      joining the referenced tokens with single spaces. Callsigns,
+ *      grids and reports that repeat within a period are therefore
+ *      only sent once.
+ *
+ *      Flags bit 0 is the 'Low confidence' field of the Decode
+ *      message,  other bits are reserved and shall be zero.
+ *
+ *      Each  record is  prefixed by its  size in bytes  so that new
+ *      fields may be added to the end of a record in the future, as
+ *      with  messages, readers  shall  skip any  record bytes  after
+ *      the fields they know about.
  */
 
 #include <QDataStream>
@@ -561,12 +614,16 @@ namespace NetworkMessage
       SwitchConfiguration,
       Configure,
       AnnotationInfo,
+      DecodeBatch,
       maximum_message_type_     // ONLY add new message types
                                 // immediately before here
     };
 
   quint32 constexpr pulse {15}; // seconds
 
+  // lowest negotiated schema number that allows DecodeBatch messages
+  quint32 constexpr decode_batch_schema {4};
+
   //
   // NetworkMessage::Builder - build a message containing serialized Qt types
   //
@@ -579,7 +636,7 @@ namespace NetworkMessage
     // increment this if a newer Qt schema is required and add decode
     // logic to the Builder and Reader class implementations
 #if QT_VERSION >= QT_VERSION_CHECK (5, 4, 0)
-    static quint32 constexpr schema_number {3};
+    static quint32 constexpr schema_number {4};
 #elif QT_VERSION >= QT_VERSION_CHECK (5, 2, 0)
     static quint32 constexpr schema_number {2};
 #else
@@ -5,10 +5,20 @@
 // Updated by Bill Somerville, G4WJS
 //
 // Reports will be sent in batch mode every 5 minutes.
+//
+// Spots pass through an aggregation stage before they are queued, a
+// spot of a call already reported on the same band and mode within
+// the cache time out is dropped, and queued spots with the same call,
+// band and mode are coalesced into one before each report. Reports are
+// packed into IPFIX messages no larger than a typical path MTU when
+// using UDP. When using TCP/IP and the connection stalls, reports are
+// held back, rather than buffered without limit, until the socket
+// drains.
 
 #include <fstream>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include <QObject>
 #include <QString>
 #include <QDateTime>
@@ -17,6 +27,7 @@
 #include <QTcpSocket>
 #include <QHostInfo>
 #include <QQueue>
+#include <QHash>
 #include <QByteArray>
 #include <QDataStream>
 #include <QTimer>
@@ -27,6 +38,7 @@
 
 #include "Logger.hpp"
 #include "Configuration.hpp"
+#include "models/Bands.hpp"
 #include "pimpl_impl.hpp"
 
 
@@ -44,14 +56,14 @@ namespace
   int FLUSH_INTERVAL {MIN_SEND_INTERVAL + 5}; // in send intervals
   bool ALIGNMENT_PADDING {true};
   int MIN_PAYLOAD_LENGTH {508};
-  int MAX_PAYLOAD_LENGTH {10000};
+  int MAX_PAYLOAD_LENGTH {10000}; // TCP/IP
+  int MAX_UDP_PAYLOAD_LENGTH {1400}; // avoid IP fragmentation
   int CACHE_TIMEOUT {300}; // default to 5 minutes for repeating spots
-  QMap<QString, time_t> spot_cache;
+  int CACHE_EXPIRY {600}; // cached spots are forgotten after 10 minutes
+  qint64 MAX_PENDING_WRITE {64 * 1024}; // bytes buffered on a stalled TCP/IP connection
+  int MAX_QUEUED_SPOTS {20000};
 }
 
-static int added;
-static int removed;
-
 class PSKReporter::impl final
   : public QObject
 {
@@ -69,6 +81,12 @@ public:
     , send_receiver_data_ {0}
     , flush_counter_ {0u}
     , prog_id_ {program_info}
+    , held_back_ {false}
+    , spots_added_ {0u}
+    , spots_dropped_ {0u}
+    , spots_sent_ {0u}
+    , spots_pending_ {0u}
+    , bytes_sent_ {0u}
   {
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
     observation_id_ = qrand();
@@ -148,12 +166,24 @@ public:
   {
     // Using deleteLater for the deleter as we may eventually
     // be called from the disconnected handler above.
+    held_back_ = false;
     if (config_->psk_reporter_tcpip ())
       {
         LOG_LOG_LOCATION (logger_, trace, "create TCP/IP socket");
         socket_.reset (new QTcpSocket, &QObject::deleteLater);
         send_descriptors_ = 1;
         send_receiver_data_ = 1;
+
+        // resume sending held back reports once a stalled connection
+        // drains
+        connect (socket_.data (), &QIODevice::bytesWritten, this, [this] (qint64) {
+            if (held_back_ && !stalled ())
+              {
+                LOG_LOG_LOCATION (logger_, debug, "connection drained, resuming");
+                held_back_ = false;
+                send_report ();
+              }
+          });
       }
     else
       {
@@ -197,6 +227,20 @@ public:
     report_timer_.stop ();
   }
 
+  bool stalled () const
+  {
+    return socket_ && QAbstractSocket::TcpSocket == socket_->socketType ()
+      && socket_->bytesToWrite () > MAX_PENDING_WRITE;
+  }
+
+  int max_payload_length () const
+  {
+    return socket_ && QAbstractSocket::UdpSocket == socket_->socketType ()
+      ? MAX_UDP_PAYLOAD_LENGTH : MAX_PAYLOAD_LENGTH;
+  }
+
+  void add_spot (QString const& call, QString const& grid, Radio::Frequency, QString const& mode, int snr);
+  void coalesce_spots ();
   void send_report (bool send_residue = false);
   void build_preamble (QDataStream&);
   void eclipse_load(QString filename);
@@ -243,11 +287,10 @@ public:
   QByteArray tx_residue_;
   struct Spot
   {
-    bool operator == (Spot const& rhs)
+    bool operator == (Spot const& rhs) const
     {
       return
         call_ == rhs.call_
-        && grid_ == rhs.grid_
         && mode_ == rhs.mode_
         && std::abs (Radio::FrequencyDelta (freq_ - rhs.freq_)) < 50;
     }
@@ -262,6 +305,18 @@ public:
   QQueue<Spot> spots_;
   QTimer report_timer_;
   QTimer descriptor_timer_;
+
+  // aggregation stage, maps call/band/mode to the time last queued
+  QHash<QString, qint64> spot_cache_;
+  QHash<QString, QString> interned_modes_;
+  bool held_back_;              // report held back on a stalled connection
+
+  // statistics
+  quint64 spots_added_;
+  quint64 spots_dropped_;
+  quint64 spots_sent_;
+  unsigned spots_pending_;      // encoded but not yet in a sent datagram
+  quint64 bytes_sent_;
 };
   
 #include "PSKReporter.moc"
@@ -458,10 +513,116 @@ void PSKReporter::impl::build_preamble (QDataStream& message)
   }
 }
 
+void PSKReporter::impl::add_spot (QString const& call, QString const& grid, Radio::Frequency freq
+                                  , QString const& mode, int snr)
+{
+  ++spots_added_;
+  auto now = QDateTime::currentDateTimeUtc ();
+  auto secs = now.toMSecsSinceEpoch () / 1000;
+
+  // share one copy of each mode string between all queued spots
+  auto mode_iter = interned_modes_.find (mode);
+  if (mode_iter == interned_modes_.end ())
+    {
+      mode_iter = interned_modes_.insert (mode, mode);
+    }
+
+  auto key = call + '/' + config_->bands ()->find (freq) + '/' + *mode_iter;
+  auto cached = spot_cache_.find (key);
+
+  // we allow all spots through +/- 6 hours around an eclipse for the
+  // HamSCI group, and all VHF and up spots
+  if (cached == spot_cache_.end () || freq > 49000000 || eclipse_active (now)
+      || secs - *cached > CACHE_TIMEOUT)
+    {
+      if (spots_.size () >= MAX_QUEUED_SPOTS)
+        {
+          // we are not keeping up, most likely a stalled connection,
+          // discard the oldest spot
+          spots_.dequeue ();
+          ++spots_dropped_;
+          LOG_LOG_LOCATION (logger_, warning, "spot queue full, dropped oldest spot");
+        }
+      spots_.enqueue ({call, grid, snr, freq, *mode_iter, now});
+      spot_cache_[key] = secs;
+    }
+  else
+    {
+      ++spots_dropped_;
+      LOG_LOG_LOCATION (logger_, trace, "duplicate spot: " << key << " reduction: "
+                        << 100. * spots_dropped_ / spots_added_ << "%");
+    }
+
+  // remove expired cache items to save a little memory, cheap enough
+  // to do every 64 spots
+  if (!(spots_added_ % 64))
+    {
+      auto iter = spot_cache_.begin ();
+      while (iter != spot_cache_.end ())
+        {
+          if (secs - *iter > CACHE_EXPIRY)
+            {
+              iter = spot_cache_.erase (iter);
+            }
+          else
+            {
+              ++iter;
+            }
+        }
+    }
+}
+
+// merge queued spots of the same call on the same frequency (within
+// the Spot equality window) and mode, keeping the best SNR and latest
+// time
+void PSKReporter::impl::coalesce_spots ()
+{
+  if (spots_.size () < 2) return;
+  QQueue<Spot> coalesced;
+  QHash<QString, QList<int>> by_call;
+  for (auto const& spot : spots_)
+    {
+      auto& candidates = by_call[spot.call_];
+      auto merged = false;
+      for (auto index : candidates)
+        {
+          auto& target = coalesced[index];
+          if (target == spot)
+            {
+              target.snr_ = std::max (target.snr_, spot.snr_);
+              if (spot.time_ > target.time_) target.time_ = spot.time_;
+              if (target.grid_.isEmpty ()) target.grid_ = spot.grid_;
+              merged = true;
+              break;
+            }
+        }
+      if (!merged)
+        {
+          candidates << coalesced.size ();
+          coalesced.enqueue (spot);
+        }
+    }
+  if (coalesced.size () < spots_.size ())
+    {
+      LOG_LOG_LOCATION (logger_, debug, "coalesced " << spots_.size () << " spots to " << coalesced.size ());
+    }
+  spots_.swap (coalesced);
+}
+
 void PSKReporter::impl::send_report (bool send_residue)
 {
   LOG_LOG_LOCATION (logger_, trace, "sending residue: " << send_residue);
   if (QAbstractSocket::ConnectedState != socket_->state ()) return;
+  if (stalled ())
+    {
+      // hold back, spots stay queued until the connection drains
+      LOG_LOG_LOCATION (logger_, warning, "connection stalled with " << socket_->bytesToWrite ()
+                        << " bytes pending, holding back " << spots_.size () << " spots");
+      held_back_ = true;
+      return;
+    }
+
+  coalesce_spots ();
 
   QDataStream message {&payload_, QIODevice::WriteOnly | QIODevice::Append};
   QDataStream tx_out {&tx_data_, QIODevice::WriteOnly | QIODevice::Append};
@@ -504,6 +665,7 @@ void PSKReporter::impl::send_report (bool send_residue)
           if (spots_.size ())
             {
               auto const& spot = spots_.dequeue ();
+              ++spots_pending_;
 
               // Sender information
               writeUtfString (tx_out, spot.call_);
@@ -537,13 +699,13 @@ void PSKReporter::impl::send_report (bool send_residue)
           auto len = payload_.size () + tx_data_.size ();
           len += num_pad_bytes (tx_data_.size ());
           len += num_pad_bytes (len);
-          if (len > MAX_PAYLOAD_LENGTH // our upper datagram size limit
+          if (len > max_payload_length () // our upper datagram size limit
               || (!spots_.size () && len > MIN_PAYLOAD_LENGTH) // spots drained and above lower datagram size limit
               || (flush && !spots_.size ())) // send what we have, possibly no spots
             {
               if (tx_data_.size ())
                 {
-                  if (len <= MAX_PAYLOAD_LENGTH)
+                  if (len <= max_payload_length ())
                     {
                       tx_data_size = tx_data_.size ();
                     }
@@ -565,9 +727,22 @@ void PSKReporter::impl::send_report (bool send_residue)
 #endif
                                                );
 
+              // the last spot goes in the next datagram if it didn't fit
+              unsigned carried = tx_data_size < tx_data_.size () ? 1u : 0u;
+
               // Send data to PSK Reporter site
-              socket_->write (payload_); // TODO: handle errors
-              LOG_LOG_LOCATION (logger_, debug, "sent spots");
+              if (socket_->write (payload_) < 0)
+                {
+                  LOG_LOG_LOCATION (logger_, warning, "write failed: " << socket_->errorString ());
+                }
+              else
+                {
+                  bytes_sent_ += payload_.size ();
+                  spots_sent_ += spots_pending_ - carried;
+                }
+              spots_pending_ = carried;
+              LOG_LOG_LOCATION (logger_, debug, "sent spots: " << spots_sent_ << " bytes: " << bytes_sent_
+                                << " bytes/spot: " << (spots_sent_ ? double (bytes_sent_) / spots_sent_ : 0.));
               flush = false;    // break loop
               message.device ()->seek (0u);
               payload_.clear ();  // Fresh message
@@ -578,6 +753,12 @@ void PSKReporter::impl::send_report (bool send_residue)
               break;
             }
         }
+      if (stalled ())
+        {
+          LOG_LOG_LOCATION (logger_, warning, "connection stalled, holding back " << spots_.size () << " spots");
+          held_back_ = true;
+          break;
+        }
       LOG_LOG_LOCATION (logger_, debug, "remaining spots: " << spots_.size ());
     }
 }
@@ -631,45 +812,7 @@ bool PSKReporter::addRemoteStation (QString const& call, QString const& grid, Ra
         {
            reconnect ();
         }
-      // remove any earlier spots of this call to reduce pskreporter load
-#ifdef DEBUGPSK
-      static std::fstream fs;
-      if (!fs.is_open()) fs.open("/temp/psk.log", std::fstream::in | std::fstream::out | std::fstream::app);
-#endif
-      added++;
-
-      QDateTime qdateNow = QDateTime::currentDateTime().toUTC();
-      // we allow all spots through +/- 6 hours around an eclipse for the HamSCI group
-      if (!spot_cache.contains(call) || freq > 49000000 || eclipse_active(qdateNow)) // then it's a new spot
-      {
-        m_->spots_.enqueue ({call, grid, snr, freq, mode, QDateTime::currentDateTimeUtc ()});
-        spot_cache.insert(call, time(NULL));
-#ifdef DEBUGPSK
-        if (fs.is_open()) fs << "Adding   " << call << " freq=" << freq << " " << spot_cache[call] <<  " count=" << m_->spots_.count() << std::endl;
-#endif
-      }
-      else if (time(NULL) - spot_cache[call] > CACHE_TIMEOUT) // then the cache has expired  
-      {
-        m_->spots_.enqueue ({call, grid, snr, freq, mode, QDateTime::currentDateTimeUtc ()});
-#ifdef DEBUGPSK
-        if (fs.is_open()) fs << "Adding # " << call << spot_cache[call] << " count=" << m_->spots_.count() << std::endl;
-#endif
-        spot_cache[call] = time(NULL);
-      }
-      else
-      {
-        removed++;
-#ifdef DEBUGPSK
-        if (fs.is_open()) fs << "Removing " << call << " " << time(NULL) << " reduction=" << removed/(double)added*100 << "%" << std::endl;
-#endif
-      }
-      // remove cached items over 10 minutes old to save a little memory
-      QMapIterator<QString, time_t> i(spot_cache);
-      time_t tmptime = time(NULL);
-      while(i.hasNext()) {
-          i.next();
-          if (tmptime - i.value() > 600) spot_cache.remove(i.key());
-      }
+      m_->add_spot (call, grid, freq, mode, snr);
       return true;
     }
   return false;
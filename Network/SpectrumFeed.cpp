@@ -0,0 +1,256 @@
+#include "SpectrumFeed.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <QString>
+#include <QSharedMemory>
+
+#include "pimpl_impl.hpp"
+
+static_assert (sizeof (std::atomic<quint32>) == sizeof (quint32), "atomic quint32 must be a plain 32-bit word");
+static_assert (ATOMIC_INT_LOCK_FREE == 2, "atomic int must be lock free to be shared between processes");
+
+namespace
+{
+  int segment_size ()
+  {
+    return sizeof (SpectrumFeed::Header) + sizeof (SpectrumFeed::Average)
+      + SpectrumFeed::ring_slots * sizeof (SpectrumFeed::Slot);
+  }
+
+  // copy all but the sequence number of a sequence locked block,
+  // false if the writer was busy with it
+  template<typename T>
+  bool read_locked (T const& block, T * out, std::size_t first_field)
+  {
+    for (int tries = 0; tries < 100; ++tries)
+      {
+        auto sequence = block.sequence.load (std::memory_order_acquire);
+        if (sequence & 1) continue;
+        std::memcpy (reinterpret_cast<char *> (out) + first_field
+                     , reinterpret_cast<char const *> (&block) + first_field
+                     , sizeof (T) - first_field);
+        std::atomic_thread_fence (std::memory_order_acquire);
+        if (block.sequence.load (std::memory_order_relaxed) == sequence)
+          {
+            out->sequence.store (sequence, std::memory_order_relaxed);
+            return true;
+          }
+      }
+    return false;
+  }
+
+  // the writer's side of the sequence lock
+  template<typename T, typename F>
+  void write_locked (T * block, F update)
+  {
+    auto sequence = block->sequence.load (std::memory_order_relaxed);
+    block->sequence.store (sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    update (block);
+    block->sequence.store (sequence + 2, std::memory_order_release);
+  }
+}
+
+class SpectrumFeed::impl final
+{
+public:
+  Header * header () const {return static_cast<Header *> (memory_.data ());}
+
+  Average * average () const
+  {
+    return reinterpret_cast<Average *> (static_cast<char *> (memory_.data ()) + sizeof (Header));
+  }
+
+  Slot * slot (quint32 index) const
+  {
+    return reinterpret_cast<Slot *> (static_cast<char *> (memory_.data ()) + sizeof (Header)
+                                     + sizeof (Average)) + index % ring_slots;
+  }
+
+  QSharedMemory memory_;
+  QString error_;
+};
+
+SpectrumFeed::SpectrumFeed ()
+{
+}
+
+SpectrumFeed::~SpectrumFeed ()
+{
+  close ();
+}
+
+bool SpectrumFeed::open (QString const& key)
+{
+  if (m_->memory_.isAttached ())
+    {
+      if (m_->memory_.key () == key) return true;
+      close ();
+    }
+  m_->memory_.setKey (key);
+  if (!m_->memory_.create (segment_size ()))
+    {
+      // left behind by an instance that crashed
+      if (QSharedMemory::AlreadyExists != m_->memory_.error ()
+          || !m_->memory_.attach ()
+          || m_->memory_.size () < segment_size ())
+        {
+          m_->error_ = m_->memory_.errorString ();
+          m_->memory_.detach ();
+          return false;
+        }
+    }
+  std::memset (m_->memory_.data (), 0, segment_size ());
+  auto * header = m_->header ();
+  header->version = version;
+  header->header_size = sizeof (Header);
+  header->average_size = sizeof (Average);
+  header->slot_size = sizeof (Slot);
+  header->slots = ring_slots;
+  header->max_bins = max_bins;
+  std::atomic_thread_fence (std::memory_order_release);
+  header->magic = magic;        // last, marks the segment as ready
+  m_->error_.clear ();
+  return true;
+}
+
+void SpectrumFeed::close ()
+{
+  if (m_->memory_.isAttached ())
+    {
+      m_->header ()->magic = 0;
+      m_->memory_.detach ();
+    }
+}
+
+bool SpectrumFeed::is_open () const
+{
+  return m_->memory_.isAttached ();
+}
+
+QString SpectrumFeed::error_string () const
+{
+  return m_->error_;
+}
+
+void SpectrumFeed::write (qint64 time, qint64 dial_frequency, float bin_width, float power, float tr_period,
+                          int half_symbol, QString const& mode, float const * spectrum, int bins,
+                          float const * average, float const * yellow)
+{
+  if (!m_->memory_.isAttached ()) return;
+  bins = std::max (0, std::min (bins, int (max_bins)));
+  auto * header = m_->header ();
+  auto count = header->count.load (std::memory_order_relaxed) + 1;
+  write_locked (m_->slot (count - 1), [&] (Slot * slot) {
+      slot->serial = count;
+      slot->time = time;
+      slot->dial_frequency = dial_frequency;
+      slot->bin_width = bin_width;
+      slot->power = power;
+      slot->tr_period = tr_period;
+      slot->half_symbol = half_symbol;
+      slot->bins = bins;
+      auto const& mode_name = mode.toLatin1 ().left (sizeof slot->mode - 1);
+      std::memset (slot->mode, 0, sizeof slot->mode);
+      std::memcpy (slot->mode, mode_name.constData (), mode_name.size ());
+      std::copy (spectrum, spectrum + bins, slot->spectrum);
+    });
+  header->count.store (count, std::memory_order_release);
+
+  if (average && yellow)
+    {
+      write_locked (m_->average (), [&] (Average * block) {
+          block->half_symbol = half_symbol;
+          block->time = time;
+          block->bins = bins;
+          std::copy (average, average + bins, block->average);
+          std::copy (yellow, yellow + bins, block->yellow);
+        });
+    }
+}
+
+class SpectrumFeed::Reader::impl final
+{
+public:
+  QSharedMemory memory_;
+  QString error_;
+
+  char * base () const {return static_cast<char *> (memory_.data ());}
+  Header const * header () const {return reinterpret_cast<Header const *> (base ());}
+};
+
+SpectrumFeed::Reader::Reader ()
+{
+}
+
+SpectrumFeed::Reader::~Reader ()
+{
+  detach ();
+}
+
+bool SpectrumFeed::Reader::attach (QString const& key)
+{
+  detach ();
+  m_->memory_.setKey (key);
+  if (!m_->memory_.attach (QSharedMemory::ReadOnly))
+    {
+      m_->error_ = m_->memory_.errorString ();
+      return false;
+    }
+  auto const * header = m_->header ();
+  if (m_->memory_.size () < int (sizeof (Header))
+      || magic != header->magic
+      || version != header->version
+      || sizeof (Header) != header->header_size
+      || sizeof (Average) != header->average_size
+      || sizeof (Slot) != header->slot_size
+      || ring_slots != int (header->slots)
+      || max_bins != int (header->max_bins)
+      || m_->memory_.size () < segment_size ())
+    {
+      m_->error_ = "not a spectrum feed of a version this reader understands";
+      m_->memory_.detach ();
+      return false;
+    }
+  m_->error_.clear ();
+  return true;
+}
+
+void SpectrumFeed::Reader::detach ()
+{
+  if (m_->memory_.isAttached ()) m_->memory_.detach ();
+}
+
+QString SpectrumFeed::Reader::error_string () const
+{
+  return m_->error_;
+}
+
+bool SpectrumFeed::Reader::is_live () const
+{
+  return m_->memory_.isAttached () && magic == m_->header ()->magic;
+}
+
+quint32 SpectrumFeed::Reader::count () const
+{
+  if (!m_->memory_.isAttached ()) return 0;
+  return m_->header ()->count.load (std::memory_order_acquire);
+}
+
+bool SpectrumFeed::Reader::read (quint32 serial, Slot * slot) const
+{
+  auto written = count ();
+  if (!serial || serial > written || written - serial >= quint32 (ring_slots)) return false;
+  auto const * source = reinterpret_cast<Slot const *> (m_->base () + sizeof (Header) + sizeof (Average))
+    + (serial - 1) % ring_slots;
+  return read_locked (*source, slot, offsetof (Slot, serial)) && slot->serial == serial;
+}
+
+bool SpectrumFeed::Reader::read_average (Average * average) const
+{
+  if (!m_->memory_.isAttached ()) return false;
+  auto const * source = reinterpret_cast<Average const *> (m_->base () + sizeof (Header));
+  return read_locked (*source, average, offsetof (Average, half_symbol));
+}
@@ -0,0 +1,136 @@
+#ifndef SPECTRUM_FEED_HPP_
+#define SPECTRUM_FEED_HPP_
+
+#include <atomic>
+#include <QtGlobal>
+#include "pimpl_h.hpp"
+
+class QString;
+
+//
+// SpectrumFeed - publish the waterfall spectra in shared memory
+//
+// Every half-symbol spectrum computed by symspec() for the waterfall
+// is written to a ring of slots in a shared memory segment along with
+// its time, the dial frequency and the mode, so that other programs,
+// band activity dashboards or skimmers, can use the same spectra
+// without acquiring and transforming the audio again. The running
+// average spectrum of the current period and its flattened "yellow"
+// curve are published alongside.
+//
+// There is a single writer and any number of readers. Each slot and
+// the average block is guarded by a sequence lock: the sequence number
+// is odd while the writer is updating it, so a reader copies the data
+// out between two reads of the sequence and tries again if they
+// differ. Readers never block the writer, the shared memory lock is
+// never used.
+//
+// The segment is a QSharedMemory with the key "<application name> -
+// spectrum", e.g. "WSJT-X - spectrum" or "WSJT-X - <rig name> -
+// spectrum". It is laid out as a Header, an Average and then
+// Header::slots Slots, all in native byte order. A reader should
+// check the magic number, the version and the structure sizes in the
+// header before using the rest. The magic number is cleared when
+// publishing stops.
+//
+// The spectrum_feed tool attaches as a reader and prints what it sees.
+//
+class SpectrumFeed final
+{
+public:
+  static quint32 constexpr magic {0x46535357}; // "WSSF"
+  static quint32 constexpr version {1};
+  static int constexpr max_bins {6827};        // NSMAX
+  static int constexpr ring_slots {64};
+
+  struct Header
+  {
+    quint32 magic;
+    quint32 version;
+    quint32 header_size;        // sizeof (Header)
+    quint32 average_size;       // sizeof (Average)
+    quint32 slot_size;          // sizeof (Slot)
+    quint32 slots;              // number of slots in the ring
+    quint32 max_bins;
+    quint32 reserved;
+    std::atomic<quint32> count; // slots written, the latest is in
+                                // slot (count - 1) % slots
+    quint32 reserved2[7];
+  };
+
+  struct Slot
+  {
+    std::atomic<quint32> sequence; // odd while being written
+    quint32 serial;             // Header::count after this was written
+    qint64 time;                // of the end of the half-symbol, ms
+                                // since the epoch UTC
+    qint64 dial_frequency;      // Hz
+    float bin_width;            // Hz
+    float power;                // audio level, dB
+    float tr_period;            // s
+    qint32 half_symbol;         // in the period, from 1
+    qint32 bins;                // valid entries in spectrum
+    char mode[12];              // e.g. "FT8", nul terminated
+    float spectrum[max_bins];   // power, linear, bin 0 at 0 Hz
+  };
+
+  struct Average
+  {
+    std::atomic<quint32> sequence; // odd while being written
+    qint32 half_symbol;         // half-symbols averaged
+    qint64 time;                // as Slot::time
+    qint32 bins;
+    qint32 reserved;
+    float average[max_bins];    // mean power over the period so far
+    float yellow[max_bins];     // flattened, 0 to 50
+  };
+
+  explicit SpectrumFeed ();
+  ~SpectrumFeed ();
+
+  // create the segment, does nothing if it is already open
+  bool open (QString const& key);
+  void close ();
+  bool is_open () const;
+  QString error_string () const;
+
+  // publish a half-symbol spectrum, average and yellow may be null
+  void write (qint64 time, qint64 dial_frequency, float bin_width, float power, float tr_period,
+              int half_symbol, QString const& mode, float const * spectrum, int bins,
+              float const * average, float const * yellow);
+
+  //
+  // reading, for tools
+  //
+  class Reader final
+  {
+  public:
+    explicit Reader ();
+    ~Reader ();
+
+    bool attach (QString const& key);
+    void detach ();
+    QString error_string () const;
+
+    // false once the writer has stopped publishing, reattach to pick
+    // up a restarted feed
+    bool is_live () const;
+
+    quint32 count () const;     // slots written so far
+
+    // copy the slot holding spectrum serial, false if it has been
+    // overwritten or not written yet
+    bool read (quint32 serial, Slot * slot) const;
+    bool read_average (Average * average) const;
+
+  private:
+    class impl;
+    pimpl<impl> m_;
+  };
+
+private:
+  class impl;
+  pimpl<impl> m_;
+};
+
+#endif
@@ -10,13 +10,78 @@ import ipfix.message
 import socketserver
 import socket
 
+class Stats:
+    '''Accumulate message, byte, and spot counts to measure the
+    efficiency of reports, duplicate spots are those of a call seen
+    before with the same band and mode.'''
+
+    def __init__ (self, mtu):
+        self.lock = threading.Lock ()
+        self.mtu = mtu
+        self.messages = 0
+        self.bytes = 0
+        self.largest = 0
+        self.oversize = 0
+        self.spots = 0
+        self.duplicates = 0
+        self.seen = set ()
+
+    def message (self, length):
+        with self.lock:
+            self.messages += 1
+            self.bytes += length
+            self.largest = max (self.largest, length)
+            if self.mtu and length > self.mtu:
+                self.oversize += 1
+                logging.warning (f'message of {length} bytes exceeds MTU of {self.mtu}')
+
+    def stream (self, length):
+        with self.lock:
+            self.bytes += length
+
+    def record (self, rec):
+        if 'senderCallsign' not in rec:
+            return
+        key = (rec['senderCallsign'], rec.get ('frequency', 0) // 1000000, rec.get ('mode'))
+        with self.lock:
+            self.spots += 1
+            if key in self.seen:
+                self.duplicates += 1
+                logging.info (f'duplicate spot: {key}')
+            self.seen.add (key)
+
+    def report (self):
+        with self.lock:
+            per_spot = self.bytes / self.spots if self.spots else 0.
+            logging.warning (f'messages: {self.messages} bytes: {self.bytes} largest: {self.largest}'
+                             f' oversize: {self.oversize} spots: {self.spots}'
+                             f' duplicates: {self.duplicates} bytes/spot: {per_spot:.1f}')
+
+class CountingReader:
+    '''Wrap a stream to count the bytes read from it.'''
+
+    def __init__ (self, stream):
+        self.stream = stream
+        self.count = 0
+
+    def read (self, size=-1):
+        data = self.stream.read (size)
+        self.count += len (data)
+        return data
+
+    def take (self):
+        count, self.count = self.count, 0
+        return count
+
 class IPFixDatagramHandler (socketserver.DatagramRequestHandler):
 
     def handle (self):
         logging.info (f'Connection from {self.client_address}')
         try:
             self.server.msg_buffer.from_bytes (self.packet)
+            stats.message (len (self.packet))
             for rec in self.server.msg_buffer.namedict_iterator ():
+                stats.record (rec)
                 logging.info (f't: {self.server.msg_buffer.get_export_time()}: {rec}')
         except:
             logging.error ('Unexpected exception:', sys.exc_info ()[0])
@@ -34,9 +99,16 @@ class IPFixStreamHandler (socketserver.StreamRequestHandler):
     def handle (self):
         logging.info (f'Connection from {self.client_address}')
         try:
-            msg_reader = ipfix.reader.from_stream (self.rfile)
+            reader = CountingReader (self.rfile)
+            msg_reader = ipfix.reader.from_stream (reader)
             for rec in msg_reader.namedict_iterator ():
+                stats.record (rec)
+                stats.stream (reader.take ())
                 logging.info (f't: {msg_reader.msg.get_export_time()}: {rec}')
+                if args.stall:
+                    # a slow collector, exercises the sender's back
+                    # pressure handling
+                    time.sleep (args.stall)
             logging.info (f'{self.client_address} closed their connection')
         except ConnectionResetError:
             logging.info (f'{self.client_address} connection reset')
@@ -52,7 +124,11 @@ if __name__ == "__main__":
     ap = argparse.ArgumentParser (description='Dump IPFIX data collected over UDP')
     ap.add_argument ('-l', '--log', metavar='loglevel', default='WARNING', help='logging level')
     ap.add_argument ('-s', '--spec', metavar='specfile', help='iespec file to read')
+    ap.add_argument ('-m', '--mtu', metavar='bytes', type=int, default=1500, help='warn of UDP messages larger than this, 0 to disable')
+    ap.add_argument ('-t', '--stall', metavar='seconds', type=float, default=0., help='delay after reading each TCP/IP record')
+    ap.add_argument ('-r', '--report', metavar='seconds', type=float, default=60., help='statistics reporting interval')
     args = ap.parse_args ()
+    stats = Stats (args.mtu)
 
     log_level = getattr (logging, args.log.upper (), None)
     if not isinstance (log_level, int):
@@ -83,7 +159,8 @@ if __name__ == "__main__":
 
     try:
         while True:
-            time.sleep (1000)
+            time.sleep (args.report)
+            stats.report ()
     except KeyboardInterrupt:
         logging.warning ('Closing down servers')
         udp_server.shutdown ()
@@ -91,4 +168,5 @@ if __name__ == "__main__":
 
     udp_thread.join ()
     tcp_thread.join ()
+    stats.report ()
     logging.info ('Servers closed')
@@ -0,0 +1,270 @@
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <locale>
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QStringList>
+#include <QFile>
+#include <QFileInfo>
+#include <QHostAddress>
+#include <QUdpSocket>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QDateTime>
+
+#include "revision_utils.hpp"
+#include "Network/LinradReceiver.hpp"
+
+extern "C"
+{
+  // lib/rice8.c
+  void rice8_decode_ (unsigned char const buf[], int const * nbytes, signed char x[], int const * n, int * ierr);
+}
+
+//
+// Send recorded QMAP (.qm, .iq) or MAP65 (.tf2, .iq) data as Linrad
+// timf2 UDP packets, at the real time rate or faster, to load test
+// the QMAP and MAP65 network input.
+//
+
+namespace
+{
+  QTextStream qtout {stdout};
+
+  int const RATE {96000};               // complex samples per second
+  int const NSAMPLES {60 * RATE};
+
+  struct Recording
+  {
+    double fcenter;
+    int nrx;                            // Linrad format, see recvpkt.f90
+    std::vector<char> data;             // packed as in timf2 packets
+    int bytes_per_sample;
+  };
+
+  // QMAP .qm file, see save_qm.f90 and qm_stream.f90: 8-bit I/Q,
+  // sent as r*4 data
+  Recording read_qm (QFile& file)
+  {
+    // prog_id, mycall, mygrid, fcenter, nutc, ntx30a, ntx30b, ndop00,
+    // ndop58, ia, ib, fac0, nxtra(15)
+    char header[42 + 8 + 7 * 4 + 4 + 15 * 4];
+    if (file.read (header, sizeof header) != sizeof header)
+      {
+        throw std::runtime_error {"short .qm header"};
+      }
+    double fcenter;
+    qint32 ia, ib;
+    float fac0;
+    qint32 nxtra[15];
+    std::memcpy (&fcenter, header + 42, sizeof fcenter);
+    std::memcpy (&ia, header + 42 + 8 + 5 * 4, sizeof ia);
+    std::memcpy (&ib, header + 42 + 8 + 6 * 4, sizeof ib);
+    std::memcpy (&fac0, header + 42 + 8 + 7 * 4, sizeof fac0);
+    std::memcpy (nxtra, header + 42 + 8 + 8 * 4, sizeof nxtra);
+    if (ia < 1 || ib > NSAMPLES || ia > ib)
+      {
+        throw std::runtime_error {"bad .qm header"};
+      }
+    Recording r {fcenter, -1, std::vector<char> (NSAMPLES * 2 * sizeof (float)), 2 * sizeof (float)};
+    auto dd = reinterpret_cast<float *> (r.data.data ());
+    if (nxtra[0] < 2)
+      {
+        // original format, one gain for the whole file
+        float fac = fac0 > 0.f ? 1.f / fac0 : 1.f;
+        std::vector<qint8> id1 (2 * (ib - ia + 1));
+        if (file.read (reinterpret_cast<char *> (id1.data ()), id1.size ()) != qint64 (id1.size ()))
+          {
+            throw std::runtime_error {"short .qm file"};
+          }
+        auto d = dd + 2 * (ia - 1);
+        for (auto v : id1) *d++ = fac * v;
+        return r;
+      }
+
+    // blocks in file order, the index is not needed for that
+    std::vector<qint8> id1;
+    std::vector<unsigned char> code;
+    for (;;)
+      {
+        struct
+        {
+          qint32 ja;
+          qint32 n;
+          float fac;
+          qint32 nbytes;
+        } block;
+        if (nxtra[1] && file.pos () >= nxtra[1] - 1) break; // reached the index
+        auto got = file.read (reinterpret_cast<char *> (&block), sizeof block);
+        if (!got) break;                // recording cut short
+        if (got != sizeof block || block.ja < 1 || block.n < 1 || block.ja + block.n - 1 > NSAMPLES
+            || block.nbytes < 0 || block.nbytes > 2 * block.n || block.fac <= 0.f)
+          {
+            throw std::runtime_error {"bad .qm block"};
+          }
+        int n = 2 * block.n;
+        id1.resize (n);
+        if (block.nbytes)
+          {
+            int ierr;
+            code.resize (block.nbytes);
+            if (file.read (reinterpret_cast<char *> (code.data ()), block.nbytes) != block.nbytes)
+              {
+                throw std::runtime_error {"short .qm file"};
+              }
+            rice8_decode_ (code.data (), &block.nbytes, reinterpret_cast<signed char *> (id1.data ()), &n, &ierr);
+            if (ierr)
+              {
+                throw std::runtime_error {"bad .qm block"};
+              }
+          }
+        else if (file.read (reinterpret_cast<char *> (id1.data ()), n) != n)
+          {
+            throw std::runtime_error {"short .qm file"};
+          }
+        if (block.ja > ib || block.ja + block.n - 1 < ia) continue;
+        auto d = dd + 2 * (block.ja - 1);
+        for (auto v : id1) *d++ = v / block.fac;
+      }
+    return r;
+  }
+
+  // QMAP .iq or MAP65 .tf2 file: fcenter then 16-bit I/Q for one or
+  // two polarizations
+  Recording read_iq (QFile& file)
+  {
+    double fcenter;
+    if (file.read (reinterpret_cast<char *> (&fcenter), sizeof fcenter) != sizeof fcenter)
+      {
+        throw std::runtime_error {"short file"};
+      }
+    auto size = file.size () - qint64 (sizeof fcenter);
+    bool xpol = size >= qint64 (4 * 56 * RATE * sizeof (qint16));
+    Recording r {fcenter, xpol ? 2 : 1, std::vector<char> (), int ((xpol ? 4 : 2) * sizeof (qint16))};
+    r.data.resize (std::min<qint64> (size, qint64 (NSAMPLES) * r.bytes_per_sample));
+    r.data.resize (file.read (r.data.data (), r.data.size ()));
+    return r;
+  }
+}
+
+int main (int argc, char * argv[])
+{
+  QCoreApplication app {argc, argv};
+  try
+    {
+      std::locale::global (std::locale::classic ());
+
+      app.setApplicationName ("Linrad UDP Replay");
+      app.setApplicationVersion (version ());
+
+      QCommandLineParser parser;
+      parser.setApplicationDescription ("\nSend recorded .qm, .iq or .tf2 data as Linrad timf2 UDP packets");
+      auto help_option = parser.addHelpOption ();
+      auto version_option = parser.addVersionOption ();
+      parser.addOptions ({
+          {{"a", "address"},
+              app.translate ("main", "Destination address, default 127.0.0.1"),
+              app.translate ("main", "ADDRESS"), "127.0.0.1"},
+          {{"p", "port"},
+              app.translate ("main", "Destination UDP port, default 50004"),
+              app.translate ("main", "PORT"), "50004"},
+          {{"s", "speed"},
+              app.translate ("main", "Multiple of the real time rate, 0 for as fast as possible"),
+              app.translate ("main", "FACTOR"), "1"},
+          {{"d", "drop"},
+              app.translate ("main", "Percentage of packets to drop at random"),
+              app.translate ("main", "PERCENT"), "0"},
+          {{"l", "loop"},
+              app.translate ("main", "Repeat the files until interrupted")},
+        });
+      parser.addPositionalArgument ("files", app.translate ("main", "Files to send, one minute each"), "FILE...");
+      parser.process (app);
+      if (parser.isSet (help_option) || parser.isSet (version_option)) return 0;
+
+      auto files = parser.positionalArguments ();
+      if (!files.size ()) parser.showHelp (1);
+      QHostAddress address {parser.value ("address")};
+      auto port = static_cast<quint16> (parser.value ("port").toUInt ());
+      auto speed = parser.value ("speed").toDouble ();
+      auto drop = parser.value ("drop").toDouble ();
+
+      QUdpSocket socket;
+      std::mt19937 rng;
+      std::uniform_real_distribution<double> percent {0., 100.};
+      LinradReceiver::Packet packet;
+      std::memset (&packet, 0, sizeof packet);
+      quint16 iblk {0};
+      int iptr {0};
+      quint64 sent {0}, dropped {0};
+      QElapsedTimer timer;
+      timer.start ();
+      double t {0.};                    // seconds of data sent
+
+      do
+        {
+          for (auto const& name : files)
+            {
+              QFile file {name};
+              if (!file.open (QIODevice::ReadOnly))
+                {
+                  throw std::runtime_error {QString {"cannot open %1: %2"}.arg (name).arg (file.errorString ()).toStdString ()};
+                }
+              auto recording = QFileInfo {name}.suffix () == "qm" ? read_qm (file) : read_iq (file);
+              int samples = sizeof packet.d8 / recording.bytes_per_sample;
+              qint64 count = recording.data.size () / recording.bytes_per_sample;
+              qtout << QString {"%1: %2 MHz, %3 samples, %4 packets"}.arg (name)
+                .arg (recording.fcenter, 0, 'f', 3).arg (count).arg ((count + samples - 1) / samples) << '\n';
+              qtout.flush ();
+              for (qint64 k = 0; k < count; k += samples)
+                {
+                  packet.cfreq = recording.fcenter;
+                  packet.msec = QDateTime::currentMSecsSinceEpoch () % 86400000;
+                  packet.iptr = iptr;
+                  packet.iblk = iblk++;
+                  packet.nrx = recording.nrx;
+                  auto n = std::min<qint64> (samples, count - k) * recording.bytes_per_sample;
+                  std::memset (packet.d8, 0, sizeof packet.d8);
+                  std::memcpy (packet.d8, recording.data.data () + k * recording.bytes_per_sample, n);
+                  iptr = (iptr + sizeof packet.d8) % (1 << 20);
+                  t += double (samples) / RATE;
+                  if (speed > 0.)
+                    {
+                      auto wait = qint64 (1000000. * t / speed) - timer.nsecsElapsed () / 1000;
+                      if (wait > 0) QThread::usleep (wait);
+                    }
+                  if (drop > 0. && percent (rng) < drop)
+                    {
+                      ++dropped;
+                      continue;
+                    }
+                  if (socket.writeDatagram (reinterpret_cast<char const *> (&packet), sizeof packet, address, port) != sizeof packet)
+                    {
+                      throw std::runtime_error {socket.errorString ().toStdString ()};
+                    }
+                  ++sent;
+                }
+            }
+        }
+      while (parser.isSet ("loop"));
+
+      qtout << QString {"%1 packets sent, %2 dropped in %3 s"}.arg (sent).arg (dropped).arg (timer.elapsed () / 1000., 0, 'f', 1) << '\n';
+    }
+  catch (std::exception const& e)
+    {
+      std::cerr << "Error: " << e.what () << '\n';
+      return -1;
+    }
+  catch (...)
+    {
+      std::cerr << "Unexpected error\n";
+      return -1;
+    }
+  return 0;
+}
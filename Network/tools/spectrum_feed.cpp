@@ -0,0 +1,144 @@
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <memory>
+#include <locale>
+
+#include <QCoreApplication>
+#include <QTextStream>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QDateTime>
+#include <QThread>
+
+#include "revision_utils.hpp"
+#include "Network/SpectrumFeed.hpp"
+
+//
+// Attach to the spectrum feed published by WSJT-X and print a line
+// for each half-symbol spectrum, with the strongest bin, as an
+// example reader and to check the feed.
+//
+
+namespace
+{
+  QTextStream qtout {stdout};
+}
+
+int main (int argc, char * argv[])
+{
+  QCoreApplication app {argc, argv};
+  try
+    {
+      std::locale::global (std::locale::classic ());
+
+      app.setApplicationName ("WSJT-X Spectrum Feed");
+      app.setApplicationVersion (version ());
+
+      QCommandLineParser parser;
+      parser.setApplicationDescription ("\nPrint the spectra published by WSJT-X in shared memory");
+      auto help_option = parser.addHelpOption ();
+      auto version_option = parser.addVersionOption ();
+      parser.addOptions ({
+          {{"r", "rig-name"},
+              app.translate ("main", "Read the feed of the WSJT-X instance started with --rig-name RIG"),
+              app.translate ("main", "RIG")},
+          {{"n", "number"},
+              app.translate ("main", "Stop after NUMBER spectra, default no limit"),
+              app.translate ("main", "NUMBER"), "0"},
+          {{"a", "average"},
+              app.translate ("main", "Also print the strongest bin of the average spectrum")},
+        });
+      parser.process (app);
+      if (parser.isSet (help_option) || parser.isSet (version_option)) return 0;
+
+      auto key = QString {"WSJT-X"};
+      if (parser.isSet ("rig-name")) key += " - " + parser.value ("rig-name");
+      key += " - spectrum";
+      auto limit = parser.value ("number").toUInt ();
+
+      SpectrumFeed::Reader reader;
+      if (!reader.attach (key))
+        {
+          throw std::runtime_error {(key + ": " + reader.error_string ()).toStdString ()};
+        }
+      std::unique_ptr<SpectrumFeed::Slot> slot {new SpectrumFeed::Slot};
+      std::unique_ptr<SpectrumFeed::Average> average {new SpectrumFeed::Average};
+      auto next = reader.count () + 1;
+      unsigned printed {0};
+      unsigned missed {0};
+      while (!limit || printed < limit)
+        {
+          if (!reader.is_live ()) // WSJT-X stopped publishing
+            {
+              qtout << "Feed stopped, waiting for it to start again\n";
+              qtout.flush ();
+              reader.detach ();
+              while (!reader.attach (key))
+                {
+                  QThread::msleep (1000);
+                }
+              next = reader.count () + 1;
+              continue;
+            }
+          auto count = reader.count ();
+          if (count + 1 < next) // the feed was restarted
+            {
+              next = count + 1;
+            }
+          if (next > count)
+            {
+              QThread::msleep (20);
+              continue;
+            }
+          if (count - next >= quint32 (SpectrumFeed::ring_slots)) // fallen behind
+            {
+              missed += count - next;
+              next = count;
+            }
+          if (!reader.read (next, slot.get ()))
+            {
+              ++missed;
+              ++next;
+              continue;
+            }
+          ++next;
+          int peak {0};
+          for (int i = 1; i < slot->bins; ++i)
+            {
+              if (slot->spectrum[i] > slot->spectrum[peak]) peak = i;
+            }
+          qtout << QDateTime::fromMSecsSinceEpoch (slot->time, Qt::UTC).toString ("hh:mm:ss.zzz")
+                << QString {" %1 %2 %3 %4 dB peak %5 Hz"}
+            .arg (slot->dial_frequency / 1.e6, 0, 'f', 6)
+            .arg (QString::fromLatin1 (slot->mode), -6)
+            .arg (slot->half_symbol, 3)
+            .arg (slot->power, 5, 'f', 1)
+            .arg (peak * slot->bin_width, 6, 'f', 1);
+          if (parser.isSet ("average") && reader.read_average (average.get ()))
+            {
+              int average_peak {0};
+              for (int i = 1; i < average->bins; ++i)
+                {
+                  if (average->average[i] > average->average[average_peak]) average_peak = i;
+                }
+              qtout << QString {", average peak %1 Hz"}.arg (average_peak * slot->bin_width, 6, 'f', 1);
+            }
+          qtout << '\n';
+          qtout.flush ();
+          ++printed;
+        }
+      qtout << QString {"%1 spectra printed, %2 missed"}.arg (printed).arg (missed) << '\n';
+    }
+  catch (std::exception const& e)
+    {
+      std::cerr << "Error: " << e.what () << '\n';
+      return -1;
+    }
+  catch (...)
+    {
+      std::cerr << "Unexpected error\n";
+      return -1;
+    }
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "StartupTimer.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <sstream>
+
+#include "Logger.hpp"
+
+namespace
+{
+  using clock_type = std::chrono::steady_clock;
+
+  struct Phase
+  {
+    std::string name;
+    clock_type::duration elapsed; // since start
+    clock_type::duration taken;
+    bool main_thread;
+  };
+
+  std::mutex mutex;
+  bool running {false};
+  clock_type::time_point started;
+  clock_type::time_point last_mark;
+  std::vector<Phase> phases;
+
+  double ms (clock_type::duration d)
+  {
+    return std::chrono::duration<double, std::milli> (d).count ();
+  }
+}
+
+namespace StartupTimer
+{
+  void start ()
+  {
+    std::lock_guard<std::mutex> lock {mutex};
+    running = true;
+    started = last_mark = clock_type::now ();
+    phases.clear ();
+  }
+
+  void mark (char const * phase)
+  {
+    auto now = clock_type::now ();
+    std::lock_guard<std::mutex> lock {mutex};
+    if (!running) return;
+    phases.push_back ({phase, now - started, now - last_mark, true});
+    last_mark = now;
+    LOG_INFO ("Startup: " << phase << " took " << std::fixed << std::setprecision (1)
+              << ms (phases.back ().taken) << " ms, " << ms (phases.back ().elapsed) << " ms since start");
+  }
+
+  void mark (char const * phase, double milliseconds)
+  {
+    auto now = clock_type::now ();
+    std::lock_guard<std::mutex> lock {mutex};
+    if (!running) return;
+    auto taken = std::chrono::duration_cast<clock_type::duration> (std::chrono::duration<double, std::milli> (milliseconds));
+    phases.push_back ({phase, now - started, taken, false});
+    LOG_INFO ("Startup: " << phase << " took " << std::fixed << std::setprecision (1)
+              << milliseconds << " ms in the background, finished " << ms (phases.back ().elapsed)
+              << " ms since start");
+  }
+
+  void report ()
+  {
+    auto now = clock_type::now ();
+    std::lock_guard<std::mutex> lock {mutex};
+    if (!running) return;
+    running = false;
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision (1)
+            << "Startup took " << ms (now - started) << " ms:";
+    for (auto const& phase : phases)
+      {
+        summary << "\n  " << std::setw (9) << ms (phase.taken) << " ms  " << phase.name
+                << (phase.main_thread ? "" : " (background)");
+      }
+    LOG_INFO (summary.str ());
+  }
+}
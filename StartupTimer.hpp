@@ -0,0 +1,22 @@
+#ifndef STARTUP_TIMER_HPP__
+#define STARTUP_TIMER_HPP__
+
+//
+// StartupTimer - time the phases of program startup
+//
+// mark() records that a phase has finished and logs how long it took
+// and the time since start() was called. Work done on other threads
+// is marked with the time it took, as measured by the caller.
+// report() logs a summary of all the phases, after which further
+// marks are ignored so that reloading things later on doesn't add to
+// the log.
+//
+namespace StartupTimer
+{
+  void start ();
+  void mark (char const * phase);
+  void mark (char const * phase, double milliseconds); // from any thread
+  void report ();
+}
+
+#endif
@@ -153,6 +153,8 @@ public:
     , do_pwr_ {false}
     , do_pwr2_ {false}
     , do_swr_ {false}
+    , poll_frequency_ {0}
+    , poll_mode_ {RIG_MODE_NONE}
   {
   }
 
@@ -176,6 +178,8 @@ public:
     , do_pwr_ {false}
     , do_pwr2_ {false}
     , do_swr_ {false}
+    , poll_frequency_ {0}
+    , poll_mode_ {RIG_MODE_NONE}
   {
   }
 
@@ -221,6 +225,10 @@ public:
   bool do_pwr2_;
   bool do_swr_;
 
+  // carried between poll steps
+  freq_t poll_frequency_;
+  rmode_t poll_mode_;
+
   static int debug_callback (enum rig_debug_level_e level, rig_ptr_t arg, char const * format, va_list ap);
 };
 
@@ -1117,166 +1125,194 @@ void HamlibTransceiver::do_mode (MODE mode)
 
 void HamlibTransceiver::do_poll ()
 {
-  freq_t f;
-  rmode_t m;
-  pbwidth_t w;
-  split_t s;
-
-  if (m_->get_vfo_works_ && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_VFO))
+  for (unsigned step = 0; do_poll_step (step); ++step)
     {
-      vfo_t v;
-      m_->error_check (rig_get_vfo (m_->rig_.data (), &v), tr ("getting current VFO")); // has side effect of establishing current VFO inside hamlib
-      CAT_TRACE ("VFO=" << rig_strvfo (v));
-      m_->reversed_ = RIG_VFO_B == v;
     }
+}
 
-  if ((WSJT_RIG_NONE_CAN_SPLIT || !m_->is_dummy_)
-      && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_SPLIT_VFO) && m_->split_query_works_)
-    {
-      vfo_t v {RIG_VFO_NONE};		// so we can tell if it doesn't get updated :(
-      auto rc = rig_get_split_vfo (m_->rig_.data (), RIG_VFO_CURR, &s, &v);
-      if (-RIG_OK == rc && RIG_SPLIT_ON == s)
-        {
-          CAT_TRACE ("rig_get_split_vfo split=" << s << " VFO=" << rig_strvfo (v));
-          update_split (true);
-          // if (RIG_VFO_A == v)
-          // 	{
-          // 	  m_->reversed_ = true;	// not sure if this helps us here
-          // 	}
-        }
-      else if (-RIG_OK == rc)	// not split
-        {
-          CAT_TRACE ("rig_get_split_vfo split=" << s << " VFO=" << rig_strvfo (v));
-          update_split (false);
-        }
-      else
-        {
-          // Some rigs (Icom) don't have a way of reporting SPLIT
-          // mode
-          CAT_TRACE ("rig_get_split_vfo can't do on this rig");
-          // just report how we see it based on prior commands
-          m_->split_query_works_ = false;
-        }
-    }
+// each step is one query of the rig so that PTT and QSY requests are
+// not held up by a whole poll cycle
+bool HamlibTransceiver::do_poll_step (unsigned step)
+{
+  freq_t& f = m_->poll_frequency_;
+  rmode_t& m = m_->poll_mode_;
+  pbwidth_t w;
+  split_t s;
 
-  if (m_->freq_query_works_)
+  switch (step)
     {
-      // only read if possible and when receiving or simplex
-      if (!state ().ptt () || !state ().split ())
+    case 0:                    // VFO
+      if (m_->get_vfo_works_ && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_VFO))
         {
-          m_->error_check (rig_get_freq (m_->rig_.data (), RIG_VFO_CURR, &f), tr ("getting current VFO frequency"));
-          f = std::round (f);
-          CAT_TRACE ("rig_get_freq frequency=" << Radio::frequency (f));
-          update_rx_frequency (f);
+          vfo_t v;
+          m_->error_check (rig_get_vfo (m_->rig_.data (), &v), tr ("getting current VFO")); // has side effect of establishing current VFO inside hamlib
+          CAT_TRACE ("VFO=" << rig_strvfo (v));
+          m_->reversed_ = RIG_VFO_B == v;
         }
+      break;
 
+    case 1:                    // split
       if ((WSJT_RIG_NONE_CAN_SPLIT || !m_->is_dummy_)
-          && state ().split ()
-          && (rig_get_caps_int (m_->model_, RIG_CAPS_TARGETABLE_VFO) & RIG_TARGETABLE_FREQ)
-          && !m_->one_VFO_)
+          && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_SPLIT_VFO) && m_->split_query_works_)
         {
-          // only read "other" VFO if in split, this allows rigs like
-          // FlexRadio to work in Kenwood TS-2000 mode despite them
-          // not having a FB; command
-
-          // we can only probe current VFO unless rig supports reading
-          // the other one directly because we can't glitch the Rx
-          m_->error_check (rig_get_freq (m_->rig_.data ()
-                                         , m_->reversed_
-                                         ? (m_->rig_->state.vfo_list & RIG_VFO_A ? RIG_VFO_A : RIG_VFO_MAIN)
-                                         : (m_->rig_->state.vfo_list & RIG_VFO_B ? RIG_VFO_B : RIG_VFO_SUB)
-                                         , &f), tr ("getting other VFO frequency"));
-          f = std::round (f);
-          CAT_TRACE ("rig_get_freq other VFO=" << f);
-          update_other_frequency (f);
+          vfo_t v {RIG_VFO_NONE};		// so we can tell if it doesn't get updated :(
+          auto rc = rig_get_split_vfo (m_->rig_.data (), RIG_VFO_CURR, &s, &v);
+          if (-RIG_OK == rc && RIG_SPLIT_ON == s)
+            {
+              CAT_TRACE ("rig_get_split_vfo split=" << s << " VFO=" << rig_strvfo (v));
+              update_split (true);
+              // if (RIG_VFO_A == v)
+              // 	{
+              // 	  m_->reversed_ = true;	// not sure if this helps us here
+              // 	}
+            }
+          else if (-RIG_OK == rc)	// not split
+            {
+              CAT_TRACE ("rig_get_split_vfo split=" << s << " VFO=" << rig_strvfo (v));
+              update_split (false);
+            }
+          else
+            {
+              // Some rigs (Icom) don't have a way of reporting SPLIT
+              // mode
+              CAT_TRACE ("rig_get_split_vfo can't do on this rig");
+              // just report how we see it based on prior commands
+              m_->split_query_works_ = false;
+            }
         }
-    }
+      break;
 
-  // only read when receiving or simplex if direct VFO addressing unavailable
-  if ((!state ().ptt () || !state ().split ())
-      && m_->mode_query_works_)
-    {
-      // We have to ignore errors here because Yaesu FTdx... rigs can
-      // report the wrong mode when transmitting split with different
-      // modes per VFO. This is unfortunate because that is exactly
-      // what you need to do to get 4kHz Rx b.w and modulation into
-      // the rig through the data socket or USB. I.e.  USB for Rx and
-      // DATA-USB for Tx.
-      auto rc = rig_get_mode (m_->rig_.data (), RIG_VFO_CURR, &m, &w);
-      if (RIG_OK == rc)
+    case 2:                    // frequencies
+      if (m_->freq_query_works_)
         {
-          CAT_TRACE ("rig_get_mode mode=" << rig_strrmode (m) << " bw=" << w);
-          update_mode (m_->map_mode (m));
+          // only read if possible and when receiving or simplex
+          if (!state ().ptt () || !state ().split ())
+            {
+              m_->error_check (rig_get_freq (m_->rig_.data (), RIG_VFO_CURR, &f), tr ("getting current VFO frequency"));
+              f = std::round (f);
+              CAT_TRACE ("rig_get_freq frequency=" << Radio::frequency (f));
+              update_rx_frequency (f);
+            }
+
+          if ((WSJT_RIG_NONE_CAN_SPLIT || !m_->is_dummy_)
+              && state ().split ()
+              && (rig_get_caps_int (m_->model_, RIG_CAPS_TARGETABLE_VFO) & RIG_TARGETABLE_FREQ)
+              && !m_->one_VFO_)
+            {
+              // only read "other" VFO if in split, this allows rigs like
+              // FlexRadio to work in Kenwood TS-2000 mode despite them
+              // not having a FB; command
+
+              // we can only probe current VFO unless rig supports reading
+              // the other one directly because we can't glitch the Rx
+              m_->error_check (rig_get_freq (m_->rig_.data ()
+                                             , m_->reversed_
+                                             ? (m_->rig_->state.vfo_list & RIG_VFO_A ? RIG_VFO_A : RIG_VFO_MAIN)
+                                             : (m_->rig_->state.vfo_list & RIG_VFO_B ? RIG_VFO_B : RIG_VFO_SUB)
+                                             , &f), tr ("getting other VFO frequency"));
+              f = std::round (f);
+              CAT_TRACE ("rig_get_freq other VFO=" << f);
+              update_other_frequency (f);
+            }
         }
-      else
+      break;
+
+    case 3:                    // mode
+      // only read when receiving or simplex if direct VFO addressing unavailable
+      if ((!state ().ptt () || !state ().split ())
+          && m_->mode_query_works_)
         {
-          CAT_TRACE ("rig_get_mode mode failed with rc: " << rc << " ignoring");
+          // We have to ignore errors here because Yaesu FTdx... rigs can
+          // report the wrong mode when transmitting split with different
+          // modes per VFO. This is unfortunate because that is exactly
+          // what you need to do to get 4kHz Rx b.w and modulation into
+          // the rig through the data socket or USB. I.e.  USB for Rx and
+          // DATA-USB for Tx.
+          auto rc = rig_get_mode (m_->rig_.data (), RIG_VFO_CURR, &m, &w);
+          if (RIG_OK == rc)
+            {
+              CAT_TRACE ("rig_get_mode mode=" << rig_strrmode (m) << " bw=" << w);
+              update_mode (m_->map_mode (m));
+            }
+          else
+            {
+              CAT_TRACE ("rig_get_mode mode failed with rc: " << rc << " ignoring");
+            }
         }
-    }
+      break;
 
-  if (RIG_PTT_NONE != m_->rig_->state.pttport.type.ptt && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_PTT))
-  {
-    ptt_t p;
-    auto rc = rig_get_ptt (m_->rig_.data (), RIG_VFO_CURR, &p);
-    if (-RIG_ENAVAIL != rc && -RIG_ENIMPL != rc) // may fail if
-      // Net rig ctl and target doesn't
-      // support command
+    case 4:                    // PTT
+      if (RIG_PTT_NONE != m_->rig_->state.pttport.type.ptt && rig_get_function_ptr (m_->model_, RIG_FUNCTION_GET_PTT))
       {
-        m_->error_check (rc, tr ("getting PTT state"));
-        CAT_TRACE ("rig_get_ptt PTT=" << p);
-        update_PTT (!(RIG_PTT_OFF == p));
-     }
-   }
-
-  if (ptt_on_) {
-    // update PWR and SWR
-    value_t strength;
-    int rc;
-    if (do_swr_) {
-        rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_SWR, &strength);
-        if (RIG_OK == rc && ptt_on_) {
-          // printf ("SWR %.3f\n",strength.f);
-          if (strength.f >= 1.000)
+        ptt_t p;
+        auto rc = rig_get_ptt (m_->rig_.data (), RIG_VFO_CURR, &p);
+        if (-RIG_ENAVAIL != rc && -RIG_ENIMPL != rc) // may fail if
+          // Net rig ctl and target doesn't
+          // support command
           {
-            update_swr (strength.f*100);
-          }
-          else
-          {
-            update_swr (0);
-          }
-        } else {
-          CAT_TRACE ("rig_get_level RIG_LEVEL_SWR failed with rc:" << rc << "ignoring");
-          update_swr (0);
+            m_->error_check (rc, tr ("getting PTT state"));
+            CAT_TRACE ("rig_get_ptt PTT=" << p);
+            update_PTT (!(RIG_PTT_OFF == p));
+         }
+       }
+      break;
+
+    case 5:                    // meters
+      if (ptt_on_) {
+        // update PWR and SWR
+        value_t strength;
+        int rc;
+        if (do_swr_) {
+            rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_SWR, &strength);
+            if (RIG_OK == rc && ptt_on_) {
+              // printf ("SWR %.3f\n",strength.f);
+              if (strength.f >= 1.000)
+              {
+                update_swr (strength.f*100);
+              }
+              else
+              {
+                update_swr (0);
+              }
+            } else {
+              CAT_TRACE ("rig_get_level RIG_LEVEL_SWR failed with rc:" << rc << "ignoring");
+              update_swr (0);
+            }
         }
-    }
-    if (do_pwr_) {
-      rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_RFPOWER_METER_WATTS, &strength);
-      if (RIG_OK == rc) {
-          update_power (strength.f*1000);
-      } else {
-          CAT_TRACE ("rig_get_level RFPOWER_METER_WATTS failed with rc:" << rc << "ignoring");
-          update_power (0);
-      }
-    } else if (do_pwr2_) {
-      rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &strength);
-      if (RIG_OK == rc) {
-          unsigned int mwpower;
-          rc = rig_power2mW(m_->rig_.data (),&mwpower,strength.f,f,m);
-          if (RIG_OK != rc) {
-            CAT_TRACE ("rig_power2mW failed with rc:" << rc << "ignoring");
-            mwpower=0;
+        if (do_pwr_) {
+          rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_RFPOWER_METER_WATTS, &strength);
+          if (RIG_OK == rc) {
+              update_power (strength.f*1000);
+          } else {
+              CAT_TRACE ("rig_get_level RFPOWER_METER_WATTS failed with rc:" << rc << "ignoring");
+              update_power (0);
+          }
+        } else if (do_pwr2_) {
+          rc = rig_get_level (m_->rig_.data (), RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &strength);
+          if (RIG_OK == rc) {
+              unsigned int mwpower;
+              rc = rig_power2mW(m_->rig_.data (),&mwpower,strength.f,f,m);
+              if (RIG_OK != rc) {
+                CAT_TRACE ("rig_power2mW failed with rc:" << rc << "ignoring");
+                mwpower=0;
+              }
+              update_power (mwpower);
+              // printf ("POWER %.3f %.1f\n",strength.f,mwpower / 1000.);
+          } else {
+              CAT_TRACE ("rig_get_level RFPOWER failed with rc:" << rc << "ignoring");
+              update_power (0);
           }
-          update_power (mwpower);
-          // printf ("POWER %.3f %.1f\n",strength.f,mwpower / 1000.);
+        } else  update_power (0);
       } else {
-          CAT_TRACE ("rig_get_level RFPOWER failed with rc:" << rc << "ignoring");
-          update_power (0);
+        update_power (0);
+        update_swr (0);
       }
-    } else  update_power (0);
-  } else {
-    update_power (0);
-    update_swr (0);
-  }
+      return false;
+
+    default:
+      return false;
+    }
+  return true;
 }
 
 void HamlibTransceiver::do_ptt (bool on)
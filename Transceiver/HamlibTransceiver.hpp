@@ -34,6 +34,7 @@ private:
   void do_tune (bool) override;
 
   void do_poll () override;
+  bool do_poll_step (unsigned step) override;
 
   bool ptt_on_ = false;
   bool do_pwr_;
@@ -1,44 +1,80 @@
 #include "PollingTransceiver.hpp"
 
 #include <exception>
+#include <algorithm>
 
 #include <QObject>
 #include <QString>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "moc_PollingTransceiver.cpp"
 
 namespace
 {
   unsigned const polls_to_stabilize {3};
+  int const fast_interval {500}; // mS, needed for displaying PWR and SWR
 }
 
 PollingTransceiver::PollingTransceiver (logger_type * logger, int poll_interval, QObject * parent)
   : TransceiverBase {logger, parent}
   , interval_ {poll_interval * 1000}
   , poll_timer_ {nullptr}
+  , step_timer_ {nullptr}
+  , polling_ {false}
+  , step_ {0}
+  , cycle_time_ {0}
+  , last_cycle_time_ {0}
+  , coalesced_ {0}
+  , interrupted_ {0}
+  , held_ {false}
+  , held_force_ {false}
   , retries_ {0}
 {
 }
 
+bool PollingTransceiver::do_poll_step (unsigned step)
+{
+  if (!step)
+    {
+      do_poll ();
+    }
+  return false;
+}
+
+int PollingTransceiver::next_interval () const
+{
+  auto interval = interval_ ? interval_ : fast_interval;
+  if (retries_ || state ().ptt ())
+    {
+      // expecting changes
+      interval = fast_interval;
+    }
+  // don't let a slow rig spend most of its time being polled, leave
+  // room for requests
+  return std::max (interval, static_cast<int> (2 * last_cycle_time_));
+}
+
 void PollingTransceiver::start_timer ()
 {
-  if (interval_)
+  if (!poll_timer_)
     {
-      if (!poll_timer_)
-        {
-          poll_timer_ = new QTimer {this}; // pass ownership to
-                                           // QObject which handles
-                                           // destruction for us
+      poll_timer_ = new QTimer {this}; // pass ownership to
+                                       // QObject which handles
+                                       // destruction for us
 
-          connect (poll_timer_, &QTimer::timeout, this,
-                   &PollingTransceiver::handle_timeout);
-        }
-      poll_timer_->start (interval_);
+      connect (poll_timer_, &QTimer::timeout, this,
+               &PollingTransceiver::handle_timeout);
+
+      step_timer_ = new QTimer {this};
+      step_timer_->setSingleShot (true);
+      connect (step_timer_, &QTimer::timeout, this,
+               &PollingTransceiver::handle_step);
     }
-  else
+  auto interval = next_interval ();
+  if (!poll_timer_->isActive () || poll_timer_->interval () != interval)
     {
-      stop_timer ();
+      poll_timer_->start (interval);
     }
 }
 
@@ -48,11 +84,37 @@ void PollingTransceiver::stop_timer ()
     {
       poll_timer_->stop ();
     }
+  abort_poll ();
+  if (coalesced_ || interrupted_)
+    {
+      CAT_DEBUG ("coalesced polls: " << coalesced_ << " interrupted polls: " << interrupted_);
+      coalesced_ = interrupted_ = 0;
+    }
+}
+
+// only when stopping, requests let the cycle carry on
+void PollingTransceiver::abort_poll ()
+{
+  if (polling_)
+    {
+      step_timer_->stop ();
+      polling_ = false;
+    }
+  held_ = held_force_ = false;
+}
+
+void PollingTransceiver::note_request ()
+{
+  if (polling_)
+    {
+      ++interrupted_;
+    }
+  start_timer ();
 }
 
 void PollingTransceiver::do_post_start ()
 {
-  interval_ = 500;  // needed for displaying PWR and SWR
+  last_cycle_time_ = 0;
   start_timer ();
   if (!next_state_.online ())
     {
@@ -84,6 +146,7 @@ void PollingTransceiver::do_post_frequency (Frequency f, MODE m)
         }
       retries_ = polls_to_stabilize;
     }
+  note_request ();
 }
 
 void PollingTransceiver::do_post_tx_frequency (Frequency f, MODE)
@@ -96,6 +159,7 @@ void PollingTransceiver::do_post_tx_frequency (Frequency f, MODE)
       next_state_.split (f); // setting non-zero TX frequency means split
       retries_ = polls_to_stabilize;
     }
+  note_request ();
 }
 
 void PollingTransceiver::do_post_mode (MODE m)
@@ -107,6 +171,7 @@ void PollingTransceiver::do_post_mode (MODE m)
       next_state_.mode (m);
       retries_ = polls_to_stabilize;
     }
+  note_request ();
 }
 
 void PollingTransceiver::do_post_ptt (bool p)
@@ -122,6 +187,7 @@ void PollingTransceiver::do_post_ptt (bool p)
     {
       next_state_.ptt(p);         // ensure this is initialized
     }
+  note_request ();
 }
 
 bool PollingTransceiver::do_pre_update ()
@@ -134,7 +200,34 @@ bool PollingTransceiver::do_pre_update ()
   return true;
 }
 
+bool PollingTransceiver::do_hold_update (bool force_signal)
+{
+  if (!polling_)
+    {
+      return false;
+    }
+  // some of the state is from this cycle and some from the last, it
+  // is signalled when the cycle completes
+  held_ = true;
+  held_force_ = held_force_ || force_signal;
+  return true;
+}
+
 void PollingTransceiver::handle_timeout ()
+{
+  if (polling_)
+    {
+      // the last cycle is still running, it will do
+      ++coalesced_;
+      return;
+    }
+  polling_ = true;
+  step_ = 0;
+  cycle_time_ = 0;
+  handle_step ();
+}
+
+void PollingTransceiver::handle_step ()
 {
   QString message;
   bool force_signal {false};
@@ -143,7 +236,23 @@ void PollingTransceiver::handle_timeout ()
   // inform our parent of the failure via the offline() message
   try
     {
-      do_poll ();              // tell sub-classes to update our state
+      bool more;
+      {
+        QElapsedTimer timer;
+        timer.start ();
+        more = do_poll_step (step_++); // tell sub-classes to update our state
+        cycle_time_ += timer.elapsed ();
+      }
+      if (more)
+        {
+          // return to the event loop so requests are serviced before
+          // the next step
+          step_timer_->start (0);
+          return;
+        }
+      polling_ = false;
+      last_cycle_time_ = cycle_time_;
+      record_latency (poll_operation, cycle_time_);
 
       // Signal new state if it what we expected or, hasn't become
       // what we expected after polls_to_stabilize polls. Unsolicited
@@ -166,6 +275,9 @@ void PollingTransceiver::handle_timeout ()
           force_signal = true;
         }
 
+      auto held = held_;
+      auto held_force = held_force_;
+      held_ = held_force_ = false;
       if (force_signal)
         {
           // reset everything, record and signal the current state
@@ -174,6 +286,12 @@ void PollingTransceiver::handle_timeout ()
           last_signalled_state_ = state ();
           update_complete (true);
         }
+      else if (held)
+        {
+          // a request was serviced during the cycle
+          update_complete (held_force);
+        }
+      start_timer ();           // adapt the poll rate
     }
   catch (std::exception const& e)
     {
@@ -185,6 +303,8 @@ void PollingTransceiver::handle_timeout ()
     }
   if (!message.isEmpty ())
     {
+      polling_ = false;
+      held_ = held_force_ = false;
       offline (message);
     }
 }
@@ -19,6 +19,21 @@ class QTimer;
 //  the abstract  poll() operation  for sub-classes to  implement. The
 //  poll operation is invoked every poll_interval seconds.
 //
+//  Sub-classes  may instead  split a  poll into  steps, each  a single
+//  query of the rig, by  implementing do_poll_step(). Steps are run as
+//  separate events  so that state change  requests, like PTT and QSY,
+//  are serviced  between steps  rather than waiting  for a  whole poll
+//  cycle. The cycle then carries on where it left off, so that polls
+//  always complete however often requests arrive, and update signals
+//  are  held back  until it  does so  that clients  never see  a part
+//  polled state. A poll timer expiry while a cycle is still in
+//  progress is coalesced with it.
+//
+//  The poll rate is adaptive, polls are fast while transmitting (for
+//  PWR and  SWR display) and while  waiting for a rig  to stabilise, at
+//  the  poll_interval  otherwise,  and  are  slowed  down  when  a  poll
+//  cycle takes a large part of the interval.
+//
 // Responsibilities
 //
 //  Because some rig interfaces don't immediately update after a state
@@ -43,6 +58,11 @@ protected:
   // in a non-intrusive manner.
   virtual void do_poll () = 0;
 
+  // Sub-classes may implement this to do part of a poll, step counts
+  // from zero and the return value is true if there are more steps in
+  // the poll cycle. The default does the whole poll in one step.
+  virtual bool do_poll_step (unsigned step);
+
   void do_post_start () override final;
   void do_post_stop () override final;
   void do_post_frequency (Frequency, MODE) override final;
@@ -50,15 +70,31 @@ protected:
   void do_post_mode (MODE) override final;
   void do_post_ptt (bool = true) override final;
   bool do_pre_update () override final;
+  bool do_hold_update (bool force_signal) override final;
 
 private:
   void start_timer ();
   void stop_timer ();
+  int next_interval () const;
+  void abort_poll ();
+  void note_request ();
 
   Q_SLOT void handle_timeout ();
+  Q_SLOT void handle_step ();
 
   int interval_;    // polling interval in milliseconds
   QTimer * poll_timer_;
+  QTimer * step_timer_;         // runs the next step of a poll cycle
+  bool polling_;                // poll cycle in progress
+  unsigned step_;               // next step of poll cycle
+  qint64 cycle_time_;           // time spent on rig queries this cycle
+  qint64 last_cycle_time_;
+  unsigned coalesced_;          // poll timer expiries during a cycle
+  unsigned interrupted_;        // cycles with requests serviced
+                                // between their steps
+  bool held_;                   // update signal held until the
+                                // cycle completes
+  bool held_force_;             // and it was to be forced
 
   // keep a record of the last state signalled so we can elide
   // duplicate updates
@@ -73,7 +73,10 @@ void TransceiverBase::set (TransceiverState const& s,
             }
           if (ptt_off)
             {
-              do_ptt (false);
+              {
+                time_operation t {this, ptt_operation};
+                do_ptt (false);
+              }
               do_post_ptt (false);
               QThread::msleep (100); // some rigs cannot process CAT
                                      // commands while switching from
@@ -89,6 +92,7 @@ void TransceiverBase::set (TransceiverState const& s,
               && ((s.frequency () != requested_.frequency () // and QSY
                    || (s.mode () != UNK && s.mode () != requested_.mode ())))) // or mode change
             {
+              time_operation t {this, frequency_operation};
               do_frequency (s.frequency (), s.mode (), ptt_off);
               do_post_frequency (s.frequency (), s.mode ());
               // record what actually changed
@@ -104,6 +108,7 @@ void TransceiverBase::set (TransceiverState const& s,
                   // || s.split () != requested_.split ())) // or split change
                   || (s.tx_frequency () && ptt_on)) // or about to tx split
                 {
+                  time_operation t {this, tx_frequency_operation};
                   do_tx_frequency (s.tx_frequency (), s.mode (), ptt_on);
                   do_post_tx_frequency (s.tx_frequency (), s.mode ());
 
@@ -114,7 +119,10 @@ void TransceiverBase::set (TransceiverState const& s,
             }
           if (ptt_on)
             {
-              do_ptt (true);
+              {
+                time_operation t {this, ptt_operation};
+                do_ptt (true);
+              }
               do_post_ptt (true);
               QThread::msleep (100); // some rigs cannot process CAT
                                      // commands while switching from
@@ -197,6 +205,7 @@ void TransceiverBase::shutdown ()
     }
   actual_ = TransceiverState {};
   requested_ = TransceiverState {};
+  report_latencies ();
 }
 
 void TransceiverBase::stop () noexcept
@@ -277,6 +286,10 @@ void TransceiverBase::update_swr (unsigned int p)
 void TransceiverBase::update_complete (bool force_signal)
 {
   CAT_TRACE ("force signal: " << force_signal);
+  if (do_hold_update (force_signal))
+    {
+      return;
+    }
   if ((do_pre_update ()
        && actual_ != last_)
       || force_signal)
@@ -286,6 +299,42 @@ void TransceiverBase::update_complete (bool force_signal)
     }
 }
 
+void TransceiverBase::record_latency (Operation operation, qint64 milliseconds)
+{
+  int bucket {0};
+  while (bucket < latency_buckets - 1 && milliseconds >= (qint64 {1} << bucket))
+    {
+      ++bucket;
+    }
+  ++latencies_[operation][bucket];
+}
+
+void TransceiverBase::report_latencies ()
+{
+  static char const * const names[] {"poll", "PTT", "frequency", "TX frequency"};
+  for (int operation = 0; operation < operation_count; ++operation)
+    {
+      auto& histogram = latencies_[operation];
+      unsigned count {0};
+      QString buckets;
+      for (int bucket = 0; bucket < latency_buckets; ++bucket)
+        {
+          count += histogram[bucket];
+          if (histogram[bucket])
+            {
+              buckets += bucket < latency_buckets - 1
+                ? QString {" <%1mS: %2"}.arg (1 << bucket).arg (histogram[bucket])
+                : QString {" >=%1mS: %2"}.arg (1 << (bucket - 1)).arg (histogram[bucket]);
+            }
+        }
+      if (count)
+        {
+          CAT_INFO (names[operation] << " latency count: " << count << buckets);
+        }
+      histogram.fill (0);
+    }
+}
+
 void TransceiverBase::offline (QString const& reason)
 {
   CAT_TRACE ("reason: " << reason);
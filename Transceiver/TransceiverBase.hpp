@@ -2,8 +2,10 @@
 #define TRANSCEIVER_BASE_HPP__
 
 #include <stdexcept>
+#include <array>
 
 #include <QString>
+#include <QElapsedTimer>
 
 #include "Logger.hpp"
 #include "Transceiver.hpp"
@@ -56,6 +58,9 @@
 //  Transceiver implementation, thus allowing multiple state component
 //  updates to be signalled together if required.
 //
+//  Keeps latency histograms of CAT operations which are written to the
+//  log when the Transceiver is shut down.
+//
 class TransceiverBase
   : public Transceiver
 {
@@ -65,6 +70,7 @@ protected:
   TransceiverBase (logger_type * logger, QObject * parent)
     : Transceiver {logger, parent}
     , last_sequence_number_ {0}
+    , latencies_ {}
   {}
 
 public:
@@ -118,6 +124,10 @@ protected:
 
   virtual bool do_pre_update () {return true;}
 
+  // return true to hold back an update signal, the sub-class must
+  // then call update_complete () itself when it is ready
+  virtual bool do_hold_update (bool /* force_signal */) {return false;}
+
   // sub classes report rig state changes with these methods
   void update_rx_frequency (Frequency);
   void update_other_frequency (Frequency = 0);
@@ -133,10 +143,18 @@ protected:
   // sub class may asynchronously take the rig offline by calling this
   void offline (QString const& reason);
 
+  // CAT operations that have latency statistics
+  enum Operation {poll_operation, ptt_operation, frequency_operation
+                  , tx_frequency_operation, operation_count};
+
+  // sub classes may record the latency of operations they initiate
+  void record_latency (Operation, qint64 milliseconds);
+
 private:
   void startup ();
   void shutdown ();
   bool maybe_low_resolution (Frequency low_res, Frequency high_res);
+  void report_latencies ();
 
   // use this convenience class to notify in update methods
   class may_update
@@ -152,10 +170,31 @@ private:
     bool force_signal_;
   };
 
+  // use this convenience class to time operations
+  class time_operation
+  {
+  public:
+    explicit time_operation (TransceiverBase * self, Operation operation)
+      : self_ {self}
+      , operation_ {operation}
+    {
+      timer_.start ();
+    }
+    ~time_operation () {self_->record_latency (operation_, timer_.elapsed ());}
+  private:
+    TransceiverBase * self_;
+    Operation operation_;
+    QElapsedTimer timer_;
+  };
+
   TransceiverState requested_;
   TransceiverState actual_;
   TransceiverState last_;
   unsigned last_sequence_number_;    // from set state operation
+
+  // counts in buckets of <1mS, <2mS, <4mS, ... and the remainder
+  static int constexpr latency_buckets {13};
+  std::array<std::array<unsigned, latency_buckets>, operation_count> latencies_;
 };
 
 // some loggimg macros
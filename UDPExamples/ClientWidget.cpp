@@ -452,7 +452,8 @@ void ClientWidget::decode_added (bool /*is_new*/, ClientKey const& key, QTime /*
                                  , float /*delta_time*/, quint32 /*delta_frequency*/, QString const& /*mode*/
                                  , QString const& /*message*/, bool /*low_confidence*/, bool /*off_air*/)
 {
-  if (key == key_ && !columns_resized_)
+  if (key != key_) return;
+  if (!columns_resized_)
     {
       decodes_stack_->setCurrentIndex (0);
       decodes_table_view_->resizeColumnsToContents ();
@@ -466,7 +467,8 @@ void ClientWidget::beacon_spot_added (bool /*is_new*/, ClientKey const& key, QTi
                                       , QString const& /*callsign*/, QString const& /*grid*/, qint32 /*power*/
                                       , bool /*off_air*/)
 {
-  if (key == key_ && !columns_resized_)
+  if (key != key_) return;
+  if (!columns_resized_)
     {
       decodes_stack_->setCurrentIndex (1);
       beacons_table_view_->resizeColumnsToContents ();
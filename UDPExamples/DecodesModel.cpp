@@ -1,12 +1,11 @@
 #include "DecodesModel.hpp"
 
-#include <QStandardItem>
+#include <algorithm>
+
 #include <QModelIndex>
 #include <QVariant>
-#include <QTime>
-#include <QString>
+#include <QDateTime>
 #include <QFont>
-#include <QList>
 
 namespace
 {
@@ -33,125 +32,206 @@ namespace
   }
 
   QFont text_font {"Courier", 10};
+}
 
-  QList<QStandardItem *> make_row (MessageServer::ClientKey const& key, QTime time, qint32 snr
-                                   , float delta_time, quint32 delta_frequency, QString const& mode
-                                   , QString const& message, bool low_confidence, bool off_air, bool is_fast)
-  {
-    auto client_item = new QStandardItem {QString {"%1(%2)"}.arg (key.second).arg (key.first.toString ())};
-    client_item->setData (QVariant::fromValue (key));
-
-    auto time_item = new QStandardItem {time.toString (is_fast || "~" == mode ? "hh:mm:ss" : "hh:mm")};
-    time_item->setData (time);
-    time_item->setTextAlignment (Qt::AlignRight);
-
-    auto snr_item = new QStandardItem {QString::number (snr)};
-    snr_item->setData (snr);
-    snr_item->setTextAlignment (Qt::AlignRight);
-
-    auto dt = new QStandardItem {QString::number (delta_time)};
-    dt->setData (delta_time);
-    dt->setTextAlignment (Qt::AlignRight);
-
-    auto df = new QStandardItem {QString::number (delta_frequency)};
-    df->setData (delta_frequency);
-    df->setTextAlignment (Qt::AlignRight);
-
-    auto md = new QStandardItem {mode};
-    md->setTextAlignment (Qt::AlignHCenter);
-
-    auto confidence = new QStandardItem {confidence_string (low_confidence)};
-    confidence->setTextAlignment (Qt::AlignHCenter);
-
-    auto live = new QStandardItem {live_string (off_air)};
-    live->setTextAlignment (Qt::AlignHCenter);
-
-    QList<QStandardItem *> row {
-      client_item, time_item, snr_item, dt, df, md, confidence, live, new QStandardItem {message}};
-    Q_FOREACH (auto& item, row)
-      {
-        item->setEditable (false);
-        item->setFont (text_font);
-        item->setTextAlignment (item->textAlignment () | Qt::AlignVCenter);
-      }
-    return row;
-  }
+DecodesModel::DecodesModel (QObject * parent, int retention_minutes)
+  : QAbstractTableModel {parent}
+  , retention_ {retention_minutes * 60 * 1000ll}
+  , row_count_ {0}
+{
+}
+
+int DecodesModel::rowCount (QModelIndex const& parent) const
+{
+  return parent.isValid () ? 0 : row_count_;
+}
+
+int DecodesModel::columnCount (QModelIndex const& parent) const
+{
+  return parent.isValid () ? 0 : sizeof headings / sizeof headings[0];
+}
+
+QVariant DecodesModel::data (QModelIndex const& index, int role) const
+{
+  if (!index.isValid () || index.row () >= row_count_) return QVariant {};
+
+  auto const& decode = decode_at (index.row ());
+  switch (role)
+    {
+    case Qt::DisplayRole:
+      switch (index.column ())
+        {
+        case 0: return QString {"%1(%2)"}.arg (decode.key_.second).arg (decode.key_.first.toString ());
+        case 1: return decode.time_.toString (decode.is_fast_ || "~" == decode.mode_ ? "hh:mm:ss" : "hh:mm");
+        case 2: return QString::number (decode.snr_);
+        case 3: return QString::number (decode.delta_time_);
+        case 4: return QString::number (decode.delta_frequency_);
+        case 5: return decode.mode_;
+        case 6: return confidence_string (decode.low_confidence_);
+        case 7: return live_string (decode.off_air_);
+        case 8: return decode.message_;
+        }
+      break;
+
+    case Qt::UserRole + 1:
+      switch (index.column ())
+        {
+        case 0: return QVariant::fromValue (decode.key_);
+        case 1: return decode.time_;
+        case 2: return decode.snr_;
+        case 3: return decode.delta_time_;
+        case 4: return decode.delta_frequency_;
+        }
+      break;
+
+    case Qt::TextAlignmentRole:
+      switch (index.column ())
+        {
+        case 1: case 2: case 3: case 4:
+          return static_cast<int> (Qt::AlignRight | Qt::AlignVCenter);
+        case 5: case 6: case 7:
+          return static_cast<int> (Qt::AlignHCenter | Qt::AlignVCenter);
+        default:
+          return static_cast<int> (Qt::AlignLeft | Qt::AlignVCenter);
+        }
+
+    case Qt::FontRole:
+      return text_font;
+    }
+  return QVariant {};
 }
 
-DecodesModel::DecodesModel (QObject * parent)
-  : QStandardItemModel {0, sizeof headings / sizeof headings[0], parent}
+QVariant DecodesModel::headerData (int section, Qt::Orientation orientation, int role) const
 {
-  int column {0};
-  for (auto const& heading : headings)
+  if (Qt::Horizontal == orientation && Qt::DisplayRole == role
+      && section >= 0 && section < columnCount ())
     {
-      setHeaderData (column++, Qt::Horizontal, tr (heading));
+      return tr (headings[section]);
     }
+  return QAbstractTableModel::headerData (section, orientation, role);
 }
 
 void DecodesModel::add_decode (bool is_new, ClientKey const& key, QTime time, qint32 snr, float delta_time
                                , quint32 delta_frequency, QString const& mode, QString const& message
                                , bool low_confidence, bool off_air, bool is_fast)
 {
-  if (!is_new)
+  evict_expired ();
+
+  // decodes nearly always belong to the latest period so search from
+  // the newest end
+  auto period = std::find_if (periods_.rbegin (), periods_.rend (), [&time] (Period const& p) {
+      return p.time_ == time;
+    });
+
+  if (!is_new && period != periods_.rend () && period->client_decodes_.value (key))
     {
-      int target_row {-1};
-      for (auto row = 0; row < rowCount (); ++row)
+      // replayed decodes that we already have are ignored
+      auto const& decodes = period->decodes_;
+      if (std::any_of (decodes.begin (), decodes.end (), [&] (Decode const& d) {
+            return d.key_ == key && d.snr_ == snr && d.delta_time_ == delta_time
+              && d.delta_frequency_ == delta_frequency && d.mode_ == mode
+              && d.low_confidence_ == low_confidence && d.off_air_ == off_air
+              && d.message_ == message;
+          }))
         {
-          if (item (row, 0)->data ().value<ClientKey> () == key)
-            {
-              auto row_time = item (row, 1)->data ().toTime ();
-              if (row_time == time
-                  && item (row, 2)->data ().toInt () == snr
-                  && item (row, 3)->data ().toFloat () == delta_time
-                  && item (row, 4)->data ().toUInt () == delta_frequency
-                  && data (index (row, 5)).toString () == mode
-                  && data (index (row, 7)).toString () == confidence_string (low_confidence)
-                  && data (index (row, 6)).toString () == live_string (off_air)
-                  && data (index (row, 8)).toString () == message)
-                {
-                  return;
-                }
-              if (time <= row_time)
-                {
-                  target_row = row; // last row with same time
-                }
-            }
-        }
-      if (target_row >= 0)
-        {
-          insertRow (target_row + 1, make_row (key, time, snr, delta_time, delta_frequency, mode
-                                               , message, low_confidence, off_air, is_fast));
           return;
         }
     }
 
-  appendRow (make_row (key, time, snr, delta_time, delta_frequency, mode, message, low_confidence
-                       , off_air, is_fast));
+  if (period == periods_.rend ())
+    {
+      periods_.push_back ({time, QDateTime::currentMSecsSinceEpoch (), row_count_, {}, {}});
+      period = periods_.rbegin ();
+    }
+
+  auto row = period->first_row_ + static_cast<int> (period->decodes_.size ());
+  beginInsertRows (QModelIndex {}, row, row);
+  period->decodes_.push_back ({key, time, snr, delta_time, delta_frequency, mode, message
+        , low_confidence, off_air, is_fast});
+  ++period->client_decodes_[key];
+  ++row_count_;
+  renumber (periods_.size () - (period - periods_.rbegin ()));
+  endInsertRows ();
 }
 
 void DecodesModel::decodes_cleared (ClientKey const& key)
 {
-  for (auto row = rowCount () - 1; row >= 0; --row)
+  for (std::size_t p = 0; p < periods_.size (); ++p)
     {
-      if (item (row, 0)->data ().value<ClientKey> () == key)
+      auto& period = periods_[p];
+      if (!period.client_decodes_.value (key)) continue;
+
+      // remove each contiguous run of this client's decodes, last
+      // first so that row numbers ahead of the run stay valid
+      auto& decodes = period.decodes_;
+      int end = static_cast<int> (decodes.size ());
+      while (end > 0)
         {
-          removeRow (row);
+          while (end > 0 && !(decodes[end - 1].key_ == key)) --end;
+          auto begin = end;
+          while (begin > 0 && decodes[begin - 1].key_ == key) --begin;
+          if (begin < end)
+            {
+              beginRemoveRows (QModelIndex {}, period.first_row_ + begin, period.first_row_ + end - 1);
+              decodes.erase (decodes.begin () + begin, decodes.begin () + end);
+              row_count_ -= end - begin;
+              renumber (p + 1);
+              endRemoveRows ();
+            }
+          end = begin;
         }
+      period.client_decodes_.remove (key);
     }
+  periods_.erase (std::remove_if (periods_.begin (), periods_.end (), [] (Period const& p) {
+        return p.decodes_.empty ();
+      }), periods_.end ());
 }
 
 void DecodesModel::do_reply (QModelIndex const& source, quint8 modifiers)
 {
-  auto row = source.row ();
-  Q_EMIT reply (item (row, 0)->data ().value<ClientKey> ()
-                , item (row, 1)->data ().toTime ()
-                , item (row, 2)->data ().toInt ()
-                , item (row, 3)->data ().toFloat ()
-                , item (row, 4)->data ().toInt ()
-                , data (index (row, 5)).toString ()
-                , data (index (row, 8)).toString ()
-                , confidence_string (true) == data (index (row, 7)).toString ()
-                , modifiers);
+  if (!source.isValid () || source.row () >= row_count_) return;
+  auto const& decode = decode_at (source.row ());
+  Q_EMIT reply (decode.key_, decode.time_, decode.snr_, decode.delta_time_, decode.delta_frequency_
+                , decode.mode_, decode.message_, decode.low_confidence_, modifiers);
+}
+
+void DecodesModel::evict_expired ()
+{
+  auto cutoff = QDateTime::currentMSecsSinceEpoch () - retention_;
+  std::size_t expired {0};
+  int rows {0};
+  while (expired < periods_.size () && periods_[expired].arrived_ < cutoff)
+    {
+      rows += static_cast<int> (periods_[expired++].decodes_.size ());
+    }
+  if (expired)
+    {
+      if (rows) beginRemoveRows (QModelIndex {}, 0, rows - 1);
+      periods_.erase (periods_.begin (), periods_.begin () + expired);
+      row_count_ -= rows;
+      renumber (0);
+      if (rows) endRemoveRows ();
+    }
+}
+
+// recalculate the first row of each period from first_period onwards
+void DecodesModel::renumber (std::size_t first_period)
+{
+  auto row = first_period ? periods_[first_period - 1].first_row_
+    + static_cast<int> (periods_[first_period - 1].decodes_.size ()) : 0;
+  for (auto p = first_period; p < periods_.size (); ++p)
+    {
+      periods_[p].first_row_ = row;
+      row += static_cast<int> (periods_[p].decodes_.size ());
+    }
+}
+
+auto DecodesModel::decode_at (int row) const -> Decode const&
+{
+  auto period = std::upper_bound (periods_.begin (), periods_.end (), row, [] (int r, Period const& p) {
+      return r < p.first_row_;
+    }) - 1;
+  return period->decodes_[row - period->first_row_];
 }
 
 #include "moc_DecodesModel.cpp"
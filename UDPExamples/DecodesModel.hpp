@@ -1,35 +1,47 @@
 #ifndef WSJTX_UDP_DECODES_MODEL_HPP__
 #define WSJTX_UDP_DECODES_MODEL_HPP__
 
-#include <QStandardItemModel>
+#include <deque>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QTime>
+#include <QString>
 
 #include "MessageServer.hpp"
 
-class QTime;
-class QString;
 class QModelIndex;
+class QVariant;
 
 //
 // Decodes Model - simple data model for all decodes
 //
-// The model is a basic table with uniform row format. Rows consist of
-// QStandardItem instances containing the string representation of the
-// column data  and if the underlying  field is not a  string then the
-// UserRole+1 role contains the underlying data item.
+// The model is a  basic table with uniform row format.  The DisplayRole
+// of each column  is the string representation of the  column data and
+// if the  underlying field is not  a string then the  UserRole+1 role
+// contains the underlying data item.
+//
+// Decodes are held in a ring of  buckets, one per T/R period time, in
+// arrival order.  Each bucket  keeps a count of decodes per client so
+// that clearing the decodes of one client only visits the buckets that
+// client has contributed to. Buckets older than the retention time are
+// evicted as new decodes arrive so that  a long running server with many
+// clients has bounded memory and view costs.
 //
 // Three slots  are provided to add  a new decode, remove  all decodes
 // for a client  and, to build a  reply to CQ message for  a given row
 // which is emitted as a signal respectively.
 //
 class DecodesModel
-  : public QStandardItemModel
+  : public QAbstractTableModel
 {
   Q_OBJECT;
 
   using ClientKey = MessageServer::ClientKey;
 
 public:
-  explicit DecodesModel (QObject * parent = nullptr);
+  explicit DecodesModel (QObject * parent = nullptr, int retention_minutes = 30);
 
   Q_SLOT void add_decode (bool is_new, ClientKey const&, QTime, qint32 snr, float delta_time
                           , quint32 delta_frequency, QString const& mode, QString const& message
@@ -39,6 +51,44 @@ public:
 
   Q_SIGNAL void reply (ClientKey const&, QTime, qint32 snr, float delta_time, quint32 delta_frequency
                        , QString const& mode, QString const& message, bool low_confidence, quint8 modifiers);
+
+  // Implement the QAbstractTableModel interface
+  int rowCount (QModelIndex const& parent = QModelIndex {}) const override;
+  int columnCount (QModelIndex const& parent = QModelIndex {}) const override;
+  QVariant data (QModelIndex const&, int role = Qt::DisplayRole) const override;
+  QVariant headerData (int section, Qt::Orientation, int role = Qt::DisplayRole) const override;
+
+private:
+  struct Decode
+  {
+    ClientKey key_;
+    QTime time_;
+    qint32 snr_;
+    float delta_time_;
+    quint32 delta_frequency_;
+    QString mode_;
+    QString message_;
+    bool low_confidence_;
+    bool off_air_;
+    bool is_fast_;
+  };
+
+  struct Period
+  {
+    QTime time_;
+    qint64 arrived_;            // mS since epoch
+    int first_row_;
+    std::vector<Decode> decodes_;
+    QHash<ClientKey, int> client_decodes_;
+  };
+
+  void evict_expired ();
+  void renumber (std::size_t first_period);
+  Decode const& decode_at (int row) const;
+
+  qint64 retention_;            // mS
+  std::deque<Period> periods_;  // oldest first
+  int row_count_;
 };
 
 #endif
@@ -41,7 +41,8 @@ MessageAggregatorMainWindow::MessageAggregatorMainWindow ()
   : log_ {new QStandardItemModel {0, sizeof headings / sizeof headings[0], this}}
   , decodes_model_ {new DecodesModel {this}}
   , beacons_model_ {new BeaconsModel {this}}
-  , server_ {new MessageServer {this}}
+  , server_ {new MessageServer}
+  , server_thread_ {new QThread {this}}
   , port_spin_box_ {new QSpinBox {this}}
   , multicast_group_line_edit_ {new QLineEdit {this}}
   , network_interfaces_combo_box_ {new CheckableItemComboBox {this}}
@@ -238,23 +239,34 @@ MessageAggregatorMainWindow::MessageAggregatorMainWindow ()
   view_menu_->addAction (calls_dock->toggleViewAction ());
   view_menu_->addSeparator ();
 
+  // the server receives and parses datagrams on its own thread, all
+  // connections to it below cross the thread boundary
+  server_->moveToThread (server_thread_);
+  connect (server_thread_, &QThread::finished, server_, &QObject::deleteLater);
+  connect (this, &MessageAggregatorMainWindow::start_server, server_, &MessageServer::start);
+  connect (this, &MessageAggregatorMainWindow::replay_client, server_, &MessageServer::replay);
+  connect (this, &MessageAggregatorMainWindow::highlight_client_callsign, server_, &MessageServer::highlight_callsign);
+  server_thread_->start ();
+
   // connect up server
-  connect (server_, &MessageServer::error, [this] (QString const& message) {
+  connect (server_, &MessageServer::error, this, [this] (QString const& message) {
       QMessageBox::warning (this, QApplication::applicationName (), tr ("Network Error"), message);
     });
   connect (server_, &MessageServer::client_opened, this, &MessageAggregatorMainWindow::add_client);
   connect (server_, &MessageServer::client_closed, this, &MessageAggregatorMainWindow::remove_client);
   connect (server_, &MessageServer::client_closed, decodes_model_, &DecodesModel::decodes_cleared);
   connect (server_, &MessageServer::client_closed, beacons_model_, &BeaconsModel::decodes_cleared);
-  connect (server_, &MessageServer::decode, [this] (bool is_new, ClientKey const& key, QTime time
+  connect (server_, &MessageServer::decode, this, [this] (bool is_new, ClientKey const& key, QTime time
                                                     , qint32 snr, float delta_time
                                                     , quint32 delta_frequency, QString const& mode
                                                     , QString const& message, bool low_confidence
                                                     , bool off_air) {
+                                              auto dock = dock_widgets_.value (key);
+                                              if (!dock) return; // queued before the client went away
                                               decodes_model_->add_decode (is_new, key, time, snr, delta_time
                                                                           , delta_frequency, mode, message
                                                                           , low_confidence, off_air
-                                                                          , dock_widgets_[key]->fast_mode ());
+                                                                          , dock->fast_mode ());
                                             });
   connect (server_, &MessageServer::WSPR_decode, beacons_model_, &BeaconsModel::add_beacon_spot);
   connect (server_, &MessageServer::decodes_cleared, decodes_model_, &DecodesModel::decodes_cleared);
@@ -285,9 +297,9 @@ void MessageAggregatorMainWindow::restart_server ()
             }
         }
     }
-    server_->start (port_spin_box_->value ()
-                    , QHostAddress {multicast_group_line_edit_->text ()}
-                    , net_ifs);
+    Q_EMIT start_server (port_spin_box_->value ()
+                         , QHostAddress {multicast_group_line_edit_->text ()}
+                         , net_ifs);
 }
 
 void MessageAggregatorMainWindow::log_qso (ClientKey const& /*key*/, QDateTime time_off
@@ -351,7 +363,7 @@ void MessageAggregatorMainWindow::add_client (ClientKey const& key, QString cons
   connect (dock, &ClientWidget::switch_configuration, server_, &MessageServer::switch_configuration);
   connect (dock, &ClientWidget::configure, server_, &MessageServer::configure);
   dock_widgets_[key] = dock;
-  server_->replay (key);        // request decodes and status
+  Q_EMIT replay_client (key);   // request decodes and status
 }
 
 void MessageAggregatorMainWindow::remove_client (ClientKey const& key)
@@ -359,13 +371,15 @@ void MessageAggregatorMainWindow::remove_client (ClientKey const& key)
   auto iter = dock_widgets_.find (key);
   if (iter != std::end (dock_widgets_))
     {
-      (*iter)->dispose ();
+      if (*iter) (*iter)->dispose ();
       dock_widgets_.erase (iter);
     }
 }
 
 MessageAggregatorMainWindow::~MessageAggregatorMainWindow ()
 {
+  server_thread_->quit ();
+  server_thread_->wait ();
   for (auto client : dock_widgets_)
     {
       delete client;
@@ -377,7 +391,7 @@ void MessageAggregatorMainWindow::change_highlighting (QString const& call, QCol
 {
   for (auto key : dock_widgets_.keys ())
     {
-      server_->highlight_callsign (key, call, bg, fg, last_only);
+      Q_EMIT highlight_client_callsign (key, call, bg, fg, last_only);
     }
 }
 
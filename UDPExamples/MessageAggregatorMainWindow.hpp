@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include <QHash>
+#include <QPointer>
 #include <QString>
 
 #include "MessageServer.hpp"
@@ -19,6 +20,7 @@ class ClientWidget;
 class QListWidget;
 class QLabel;
 class QSpinBox;
+class QThread;
 
 using Frequency = MessageServer::Frequency;
 
@@ -41,6 +43,13 @@ public:
                        , QString const& exchange_sent, QString const& exchange_rcvd, QString const& prop_mode
                        , QString const& satellite, QString const& sat_mode, QString const& freqRx);
 
+  // requests to the server which runs on its own thread
+  Q_SIGNAL void start_server (quint16 port, QHostAddress const& multicast_group_address
+                              , QSet<QString> const& network_interface_names);
+  Q_SIGNAL void replay_client (ClientKey const&);
+  Q_SIGNAL void highlight_client_callsign (ClientKey const&, QString const& callsign
+                                           , QColor const& bg, QColor const& fg, bool last_only);
+
 private:
   void restart_server ();
   void add_client (ClientKey const&, QString const& version, QString const& revision);
@@ -49,8 +58,9 @@ private:
                             bool last_only = false);
   Q_SLOT void validate_network_interfaces (QString const&);
 
-  // maps client id to widgets
-  using ClientsDictionary = QHash<ClientKey, ClientWidget *>;
+  // maps client id to widgets, which may be closed and deleted
+  // before the client goes away
+  using ClientsDictionary = QHash<ClientKey, QPointer<ClientWidget>>;
   ClientsDictionary dock_widgets_;
 
   QStandardItemModel * log_;
@@ -58,6 +68,7 @@ private:
   DecodesModel * decodes_model_;
   BeaconsModel * beacons_model_;
   MessageServer * server_;
+  QThread * server_thread_;
   QSpinBox * port_spin_box_;
   QLineEdit * multicast_group_line_edit_;
   CheckableItemComboBox * network_interfaces_combo_box_;
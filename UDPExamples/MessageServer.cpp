@@ -7,6 +7,8 @@
 #include <QUdpSocket>
 #include <QTimer>
 #include <QHash>
+#include <QVector>
+#include <QStringList>
 
 #include "Radio.hpp"
 #include "Network/NetworkMessage.hpp"
@@ -28,13 +30,20 @@ class MessageServer::impl
 
 public:
   impl (MessageServer * self, QString const& version, QString const& revision)
-    : self_ {self}
+    : QUdpSocket {self}         // so that moveToThread() on the server moves us too
+    , self_ {self}
     , version_ {version}
     , revision_ {revision}
     , clock_ {new QTimer {this}}
   {
-    // register the required types with Qt
+    // register the required types with Qt, the server may be moved
+    // to another thread in which case all signal arguments cross the
+    // thread boundary
     Radio::register_types ();
+    qRegisterMetaType<ClientKey> ("ClientKey");
+    qRegisterMetaType<ClientKey> ("MessageServer::ClientKey");
+    qRegisterMetaType<QHostAddress> ("QHostAddress");
+    qRegisterMetaType<QSet<QString>> ("QSet<QString>");
 
     connect (this, &QIODevice::readyRead, this, &MessageServer::impl::pending_datagrams);
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
@@ -287,6 +296,60 @@ void MessageServer::impl::parse_message (QHostAddress const& sender, port_type s
               }
               break;
 
+            case NetworkMessage::DecodeBatch:
+              {
+                // unpack message
+                bool is_new {true};
+                QTime time;
+                QByteArray mode;
+                bool off_air {false};
+                quint16 string_count {0};
+                in >> is_new >> time >> mode >> off_air >> string_count;
+                QVector<QString> strings;
+                strings.reserve (string_count);
+                for (quint16 i = 0; i < string_count && OK == check_status (in); ++i)
+                  {
+                    QByteArray string;
+                    in >> string;
+                    strings << QString::fromUtf8 (string);
+                  }
+                quint16 decode_count {0};
+                in >> decode_count;
+                for (quint16 i = 0; i < decode_count && OK == check_status (in); ++i)
+                  {
+                    quint16 record_size {0};
+                    in >> record_size;
+                    QByteArray record (record_size, '\0');
+                    if (in.readRawData (record.data (), record_size) != record_size)
+                      {
+                        break;
+                      }
+                    // any record bytes after the fields we know about
+                    // are ignored
+                    QDataStream record_in {record};
+                    qint16 snr;
+                    qint16 delta_time;
+                    quint16 delta_frequency;
+                    quint8 flags {0};
+                    quint8 token_count {0};
+                    record_in >> snr >> delta_time >> delta_frequency >> flags >> token_count;
+                    QStringList tokens;
+                    for (quint8 j = 0; j < token_count; ++j)
+                      {
+                        quint16 index;
+                        record_in >> index;
+                        tokens << strings.value (index);
+                      }
+                    if (check_status (record_in) != Fail)
+                      {
+                        Q_EMIT self_->decode (is_new, client_key, time, snr, delta_time / 1000.f, delta_frequency
+                                              , QString::fromUtf8 (mode), tokens.join (' ')
+                                              , flags & 1, off_air);
+                      }
+                  }
+              }
+              break;
+
             case NetworkMessage::WSPRDecode:
               {
                 // unpack message
@@ -26,6 +26,12 @@ class QString;
 // applications that use the Qt framework. Other applications should
 // use this classes' implementation as a reference implementation.
 //
+// A server may be moved to a worker thread with QObject::moveToThread
+// to keep datagram reception and parsing off a GUI thread. In that case
+// the slots must only be invoked through queued signal connections and
+// receivers of the signals below should be QObject instances (or have a
+// context object) so that they are called in their own thread.
+//
 class UDP_EXPORT MessageServer
   : public QObject
 {
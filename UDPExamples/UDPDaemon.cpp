@@ -29,6 +29,8 @@
 #include <QDateTime>
 #include <QTime>
 #include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <QDebug>
 
 #include "MessageServer.hpp"
@@ -162,8 +164,11 @@ class Server
   using ClientKey = MessageServer::ClientKey;
 
 public:
-  Server (port_type port, QHostAddress const& multicast_group, QStringList const& network_interface_names)
+  Server (port_type port, QHostAddress const& multicast_group, QStringList const& network_interface_names
+          , bool quiet, bool stats)
     : server_ {new MessageServer {this}}
+    , quiet_ {quiet}
+    , message_count_ {0}
   {
     // connect up server
     connect (server_, &MessageServer::error, [] (QString const& message) {
@@ -172,6 +177,22 @@ public:
     connect (server_, &MessageServer::client_opened, this, &Server::add_client);
     connect (server_, &MessageServer::client_closed, this, &Server::remove_client);
 
+    if (stats)
+      {
+        // count every decoded message type, this is the throughput
+        // measure when udp_replay is used to play back captured traffic
+        auto count = [this] () {++message_count_;};
+        connect (server_, &MessageServer::status_update, count);
+        connect (server_, &MessageServer::decode, count);
+        connect (server_, &MessageServer::WSPR_decode, count);
+        connect (server_, &MessageServer::qso_logged, count);
+        connect (server_, &MessageServer::logged_ADIF, count);
+        auto stats_timer = new QTimer {this};
+        connect (stats_timer, &QTimer::timeout, this, &Server::report_stats);
+        stats_timer->start (1000);
+        elapsed_.start ();
+      }
+
 #if QT_VERSION >= QT_VERSION_CHECK (5, 14, 0)
     server_->start (port, multicast_group, QSet<QString> {network_interface_names.begin (), network_interface_names.end ()});
 #else
@@ -180,9 +201,24 @@ public:
   }
 
 private:
+  void report_stats ()
+  {
+    auto seconds = elapsed_.restart () / 1000.;
+    std::cout << QString {"clients: %1 messages: %2 msgs/s: %3"}
+                   .arg (clients_.size ()).arg (message_count_)
+                   .arg (message_count_ / seconds, 0, 'f', 1).toStdString () << std::endl;
+    message_count_ = 0;
+  }
+
   void add_client (ClientKey const& key, QString const& version, QString const& revision)
   {
     auto client = new Client {key};
+    if (quiet_)
+      {
+        clients_[key] = client;
+        server_->replay (key);
+        return;
+      }
     connect (server_, &MessageServer::status_update, client, &Client::update_status);
     connect (server_, &MessageServer::decode, client, &Client::decode_added);
     connect (server_, &MessageServer::WSPR_decode, client, &Client::beacon_spot_added);
@@ -208,14 +244,18 @@ private:
     auto iter = clients_.find (key);
     if (iter != std::end (clients_))
       {
-        clients_.erase (iter);
         (*iter)->deleteLater ();
+        clients_.erase (iter);
       }
+    if (quiet_) return;
     std::cout << "Removed WSJT-X instance: " << key.second.toStdString ()
               << '(' << key.first.toString ().toStdString () << ')' << std::endl;
   }
 
   MessageServer * server_;
+  bool quiet_;
+  quint64 message_count_;
+  QElapsedTimer elapsed_;
 
   // maps client key to clients
   QHash<ClientKey, Client *> clients_;
@@ -304,6 +344,16 @@ int main (int argc, char * argv[])
                                                    app.translate ("UDPDaemon", "INTERFACE"));
       parser.addOption (network_interface_option);
 
+      QCommandLineOption quiet_option (QStringList {"q", "quiet"},
+                                       app.translate ("UDPDaemon",
+                                                      "Do not print client messages."));
+      parser.addOption (quiet_option);
+
+      QCommandLineOption stats_option (QStringList {"s", "stats"},
+                                       app.translate ("UDPDaemon",
+                                                      "Print the number of messages received per second."));
+      parser.addOption (stats_option);
+
       parser.process (app);
 
       if (parser.isSet (list_option))
@@ -314,7 +364,8 @@ int main (int argc, char * argv[])
 
       Server server {static_cast<port_type> (parser.value (port_option).toUInt ())
                      , QHostAddress {parser.value (multicast_addr_option).trimmed ()}
-                     , parser.values (network_interface_option)};
+                     , parser.values (network_interface_option)
+                     , parser.isSet (quiet_option), parser.isSet (stats_option)};
 
       return app.exec ();
     }
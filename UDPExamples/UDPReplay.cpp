@@ -0,0 +1,261 @@
+//
+// UDPReplay - capture and play back WSJT-X UDP message traffic
+//
+// This console application is a  test aid for UDP message servers. In
+// capture mode it listens on a service  port, as a server would, and
+// writes every datagram received to a file along with the time it was
+// received. In replay mode it  sends the datagrams from such a file to
+// a server, either with the original timing, scaled by a speed factor,
+// or as  fast as possible.  Running  udp_daemon with the --stats option
+// as the target server gives a sustained messages per second figure for
+// the server implementation.
+//
+// Capture files are a QDataStream (Qt_5_4) of:
+//
+//      magic          quint32  0x57555250 ("WURP")
+//      version        quint32  1
+//
+//   followed by zero or more records of:
+//
+//      time           qint64   mS since the start of the capture
+//      datagram       QByteArray
+//
+// Since datagrams  are replayed from a  single socket a server  sees all
+// the WSJT-X instances  in a capture at one address,  they are still
+// distinct clients because each message carries the client id.
+//
+
+#include <iostream>
+#include <exception>
+#include <locale>
+#include <cstdlib>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QDataStream>
+#include <QUdpSocket>
+#include <QNetworkInterface>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "qt_helpers.hpp"
+
+namespace
+{
+  quint32 constexpr capture_magic {0x57555250};
+  quint32 constexpr capture_version {1};
+
+  void open_stream (QFile& file, QDataStream& stream, QIODevice::OpenMode mode)
+  {
+    if (!file.open (mode))
+      {
+        throw std::runtime_error {
+          QString {"failed to open \"%1\": %2"}.arg (file.fileName ()).arg (file.errorString ()).toStdString ()};
+      }
+    stream.setDevice (&file);
+    stream.setVersion (QDataStream::Qt_5_4);
+  }
+
+  int capture (QCoreApplication& app, QString const& file_name, quint16 port
+               , QHostAddress const& multicast_group, QStringList const& network_interface_names)
+  {
+    QFile file {file_name};
+    QDataStream out;
+    open_stream (file, out, QIODevice::WriteOnly);
+    out << capture_magic << capture_version;
+
+    QUdpSocket socket;
+    if (!socket.bind (is_multicast_address (multicast_group) && QAbstractSocket::IPv4Protocol == multicast_group.protocol ()
+                      ? QHostAddress {QHostAddress::AnyIPv4} : QHostAddress {QHostAddress::Any}
+                      , port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint))
+      {
+        throw std::runtime_error {socket.errorString ().toStdString ()};
+      }
+    if (is_multicast_address (multicast_group))
+      {
+        for (auto const& if_name : network_interface_names)
+          {
+            socket.joinMulticastGroup (multicast_group, QNetworkInterface::interfaceFromName (if_name));
+          }
+        if (network_interface_names.isEmpty ())
+          {
+            socket.joinMulticastGroup (multicast_group);
+          }
+      }
+
+    QElapsedTimer clock;
+    clock.start ();
+    quint64 count {0};
+    QObject::connect (&socket, &QUdpSocket::readyRead, [&] () {
+        while (socket.hasPendingDatagrams ())
+          {
+            QByteArray datagram;
+            datagram.resize (socket.pendingDatagramSize ());
+            if (0 <= socket.readDatagram (datagram.data (), datagram.size ()))
+              {
+                out << clock.elapsed () << datagram;
+                ++count;
+              }
+          }
+        file.flush ();        // capture is normally ended by a signal
+        std::cout << "\rcaptured: " << count << std::flush;
+      });
+    return app.exec ();
+  }
+
+  int replay (QString const& file_name, QHostAddress const& server, quint16 port, double speed, int repeat)
+  {
+    QFile file {file_name};
+    QDataStream in;
+    open_stream (file, in, QIODevice::ReadOnly);
+    quint32 magic;
+    quint32 version;
+    in >> magic >> version;
+    if (capture_magic != magic || version > capture_version)
+      {
+        throw std::runtime_error {"not a UDP capture file"};
+      }
+    auto start = file.pos ();
+
+    QUdpSocket socket;
+    QElapsedTimer clock;
+    clock.start ();
+    quint64 count {0};
+    quint64 bytes {0};
+    for (int pass = 0; pass < repeat; ++pass)
+      {
+        file.seek (start);
+        in.resetStatus ();
+        auto pass_start = clock.elapsed ();
+        while (!in.atEnd ())
+          {
+            qint64 time;
+            QByteArray datagram;
+            in >> time >> datagram;
+            if (QDataStream::Ok != in.status ()) break;
+            if (speed > 0.)
+              {
+                auto due = pass_start + static_cast<qint64> (time / speed);
+                auto wait = due - clock.elapsed ();
+                if (wait > 0) QThread::msleep (wait);
+              }
+            if (socket.writeDatagram (datagram, server, port) < 0)
+              {
+                std::cerr << "send error: " << socket.errorString ().toStdString () << std::endl;
+              }
+            ++count;
+            bytes += datagram.size ();
+          }
+      }
+    auto seconds = qMax (clock.elapsed (), qint64 {1}) / 1000.;
+    std::cout << QString {"sent %1 datagrams (%2 bytes) in %3 s, %4 msgs/s"}
+                   .arg (count).arg (bytes).arg (seconds, 0, 'f', 3)
+                   .arg (count / seconds, 0, 'f', 1).toStdString () << std::endl;
+    return EXIT_SUCCESS;
+  }
+}
+
+int main (int argc, char * argv[])
+{
+  QCoreApplication app {argc, argv};
+  try
+    {
+      // ensure number forms are in consistent format
+      std::locale::global (std::locale::classic ());
+
+      app.setApplicationName ("WSJT-X UDP Message Capture and Replay");
+      app.setApplicationVersion ("1.0");
+
+      QCommandLineParser parser;
+      parser.setApplicationDescription ("\nCapture and replay WSJT-X UDP message traffic.");
+      parser.addHelpOption ();
+      parser.addVersionOption ();
+
+      QCommandLineOption capture_option (QStringList {"c", "capture"},
+                                         app.translate ("UDPReplay",
+                                                        "Capture datagrams received into <FILE>."),
+                                         app.translate ("UDPReplay", "FILE"));
+      parser.addOption (capture_option);
+
+      QCommandLineOption replay_option (QStringList {"r", "replay"},
+                                        app.translate ("UDPReplay",
+                                                       "Replay datagrams from <FILE>."),
+                                        app.translate ("UDPReplay", "FILE"));
+      parser.addOption (replay_option);
+
+      QCommandLineOption port_option (QStringList {"p", "port"},
+                                      app.translate ("UDPReplay",
+                                                     "Where <PORT> is the UDP service port number to listen on\n"
+                                                     "or send to. The default service port is 2237."),
+                                      app.translate ("UDPReplay", "PORT"),
+                                      "2237");
+      parser.addOption (port_option);
+
+      QCommandLineOption server_option (QStringList {"s", "server"},
+                                        app.translate ("UDPReplay",
+                                                       "Where <ADDRESS> is the server address to replay to.\n"
+                                                       "The default is 127.0.0.1."),
+                                        app.translate ("UDPReplay", "ADDRESS"),
+                                        "127.0.0.1");
+      parser.addOption (server_option);
+
+      QCommandLineOption multicast_addr_option (QStringList {"g", "multicast-group"},
+                                                app.translate ("UDPReplay",
+                                                               "Where <GROUP> is the multicast group to join when capturing."),
+                                                app.translate ("UDPReplay", "GROUP"));
+      parser.addOption (multicast_addr_option);
+
+      QCommandLineOption network_interface_option (QStringList {"i", "network-interface"},
+                                                   app.translate ("UDPReplay",
+                                                                  "Where <INTERFACE> is the network interface name to join on.\n"
+                                                                  "This option can be passed more than once."),
+                                                   app.translate ("UDPReplay", "INTERFACE"));
+      parser.addOption (network_interface_option);
+
+      QCommandLineOption speed_option (QStringList {"x", "speed"},
+                                       app.translate ("UDPReplay",
+                                                      "Where <FACTOR> scales the replay rate, 0 replays as fast\n"
+                                                      "as possible. The default is 1, real time."),
+                                       app.translate ("UDPReplay", "FACTOR"),
+                                       "1");
+      parser.addOption (speed_option);
+
+      QCommandLineOption repeat_option (QStringList {"n", "repeat"},
+                                        app.translate ("UDPReplay",
+                                                       "Where <COUNT> is the number of times to replay the capture."),
+                                        app.translate ("UDPReplay", "COUNT"),
+                                        "1");
+      parser.addOption (repeat_option);
+
+      parser.process (app);
+
+      auto port = static_cast<quint16> (parser.value (port_option).toUInt ());
+      if (parser.isSet (capture_option))
+        {
+          return capture (app, parser.value (capture_option), port
+                          , QHostAddress {parser.value (multicast_addr_option).trimmed ()}
+                          , parser.values (network_interface_option));
+        }
+      if (parser.isSet (replay_option))
+        {
+          return replay (parser.value (replay_option), QHostAddress {parser.value (server_option)}, port
+                         , parser.value (speed_option).toDouble ()
+                         , qMax (1, parser.value (repeat_option).toInt ()));
+        }
+      parser.showHelp (EXIT_FAILURE);
+    }
+  catch (std::exception const & e)
+    {
+      std::cerr << "Error: " << e.what () << '\n';
+    }
+  catch (...)
+    {
+      std::cerr << "Unexpected error\n";
+    }
+  return -1;
+}
@@ -5,9 +5,11 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   parameter (TXLENGTH=27648)           !27*1024
   parameter (NFFT=32768,NH=NFFT/2)
   parameter (NZ=4096)
+  parameter (MAXRING=100)              !Longer averages are exponential
   integer*2 id2(34560)                 !Buffer for Rx data
   real sa(NZ)      !Avg spectrum relative to initial Doppler echo freq
   real sb(NZ)      !Avg spectrum with Dither and changing Doppler removed
+  real*8 sa8(NZ),sb8(NZ)               !Running sums (or averages) of the above
   real, dimension (:,:), allocatable :: sax
   real, dimension (:,:), allocatable :: sbx
   integer nsum       !Number of integrations
@@ -23,13 +25,20 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   common/echocom/nclearave,nsum,blue(NZ),red(NZ)
   common/echocom2/fspread_self,fspread_dx
   data navg0/-1/
-  save dop0,navg0,sax,sbx
+  save dop0,navg0,sax,sbx,sa8,sb8
 
+! Averages over up to MAXRING echoes use a sliding window: the spectra
+! are kept in a ring and running sums are updated as each new spectrum
+! enters and the oldest leaves.  Longer averages are exponential, with
+! time constant navg echoes, and need no ring.  Sums are kept in real*8
+! so that sessions of hundreds of echoes do not drift.
   if(navg.ne.navg0) then
      if(allocated(sax)) deallocate(sax)
      if(allocated(sbx)) deallocate(sbx)
-     allocate(sax(1:navg,1:NZ))
-     allocate(sbx(1:navg,1:NZ))
+     if(navg.le.MAXRING) then
+        allocate(sax(1:NZ,1:navg))
+        allocate(sbx(1:NZ,1:navg))
+     endif
      nsum=0
      navg0=navg
   endif
@@ -56,8 +65,10 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   if(nclearave.ne.0) nsum=0
   if(nsum.eq.0) then
      dop0=dop                             !Remember the initial Doppler
-     sax=0.                               !Clear the average arrays
-     sbx=0.
+     if(allocated(sax)) sax=0.            !Clear the average arrays
+     if(allocated(sbx)) sbx=0.
+     sa8=0.d0
+     sb8=0.d0
   endif
 
   x(TXLENGTH+1:)=0.
@@ -79,14 +90,25 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   endif
 
   nsum=nsum+1
-  j=mod(nsum-1,navg)+1
-  do i=1,NZ
-     sax(j,i)=s(ia+i-2048)    !Center at initial doppler freq
-     sbx(j,i)=s(ib+i-2048)    !Center at expected echo freq
-     sa(i)=sum(sax(1:navg,i))
-     sb(i)=sum(sbx(1:navg,i))
-  enddo
-  
+  if(navg.le.MAXRING) then
+     j=mod(nsum-1,navg)+1
+     do i=1,NZ
+        sa8(i)=sa8(i) + (s(ia+i-2048) - sax(i,j)) !Center at initial doppler freq
+        sb8(i)=sb8(i) + (s(ib+i-2048) - sbx(i,j)) !Center at expected echo freq
+     enddo
+     sax(1:NZ,j)=s(ia-2047:ia+2048)
+     sbx(1:NZ,j)=s(ib-2047:ib+2048)
+  else
+     w=1.0/min(nsum,navg)
+     do i=1,NZ
+        sa8(i)=sa8(i) + w*(s(ia+i-2048) - sa8(i))
+        sb8(i)=sb8(i) + w*(s(ib+i-2048) - sb8(i))
+     enddo
+  endif
+  sa=sa8
+  sb=sb8
+
+
   call echo_snr(sa,sb,fspread,blue,red,snrdb,db_err,dfreq,snr_detect)
   nqual=snr_detect-2
   if(nqual.lt.0) nqual=0
@@ -98,10 +120,8 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   blue=fac*blue
   red=fac*red
   nsmo=max(0.0,0.25*width/df)
-  do i=1,nsmo
-     call smo121(red,NZ)
-     call smo121(blue,NZ)
-  enddo
+  call smo121n(red,NZ,nsmo)
+  call smo121n(blue,NZ,nsmo)
 
   ia=50.0/df
   ib=250.0/df
@@ -115,6 +135,5 @@ subroutine avecho(id2,ndop,nfrit,nauto,navg,nqual,f1,xlevel,snrdb,   &
   red=red-0.5*(bred1+bred2)
   blue=blue-0.5*(bblue1+bblue2)
 
-900 call sleep_msec(10)   !Avoid the "blue Decode button" syndrome
-  return
+900 return
 end subroutine avecho
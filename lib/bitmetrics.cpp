@@ -0,0 +1,248 @@
+//
+// bitmetrics.cpp
+//
+// Non-coherent multi-symbol bit metrics for the FT8, FT4 and FST4
+// decoders.
+//
+// For a group of nsym symbols each hypothesis is a choice of tone per
+// symbol, its score is the magnitude of the sum of the complex tone
+// amplitudes chosen and the metric of a bit is the largest score of
+// the hypotheses with the bit set less the largest of those with it
+// clear (max-log).  Tones are Gray coded so the hypothesis index, first
+// symbol most significant, is read as the bits.
+//
+// The Fortran versions filled a 2**nbits array of scores and took two
+// masked maxval() over the whole of it for every bit, for FST4's eight
+// symbol groups that is 32 passes over 65536 scores.  Here the index
+// is split into a row, the sums of all but the last symbol or
+// sub-group, and a column, the last one.  The scores are made a row at
+// a time in short arrays laid out so that the compiler vectorizes the
+// adds and the magnitudes, the maximum of each row and of each column
+// is kept and the bit maxima are taken from those, a single pass over
+// the scores.
+//
+// The sums are added in the same order as the Fortran and the
+// magnitude is computed the way glibc's cabsf() does, in double
+// precision, so the metrics are bit for bit those of the Fortran code
+// they replace when built against glibc.
+//
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+extern "C"
+{
+  // Fortran callable
+  void nc_bitmetrics_ (float const cs[], int * ntones, int * nsym, int const graymap[],
+                       float bm[], float * smax);
+  void fst4_nc_bitmetrics_ (float const cs[], int * nn, int const graymap[], float bitmetrics[]);
+}
+
+namespace
+{
+  int constexpr max_sums {256};
+  int constexpr max_bits {16};
+
+  // complex sums, split so that loops over them vectorize
+  struct Sums
+  {
+    int n;
+    float re[max_sums];
+    float im[max_sums];
+  };
+
+  int index_bits (int n)
+  {
+    int bits {0};
+    while (n > 1)
+      {
+        n >>= 1;
+        ++bits;
+      }
+    return bits;
+  }
+
+  // the tone amplitudes of one symbol in Gray code order, cs is
+  // complex cs(0:ntones-1)
+  void tones (float const * cs, int ntones, int const * graymap, Sums * s)
+  {
+    s->n = ntones;
+    for (int d = 0; d < ntones; ++d)
+      {
+        s->re[d] = cs[2 * graymap[d]];
+        s->im[d] = cs[2 * graymap[d] + 1];
+      }
+  }
+
+  // out(i * b.n + j) = a(i) + sign * b(j)
+  void combine (Sums const& a, Sums const& b, float sign, Sums * out)
+  {
+    out->n = a.n * b.n;
+    for (int i = 0; i < a.n; ++i)
+      {
+        float * re = out->re + i * b.n;
+        float * im = out->im + i * b.n;
+        for (int j = 0; j < b.n; ++j)
+          {
+            re[j] = a.re[i] + sign * b.re[j];
+            im[j] = a.im[i] + sign * b.im[j];
+          }
+      }
+  }
+
+  // the maximum over v(0:2**nbits-1) of the entries whose index has
+  // bit b set, in one[b], and clear, in zero[b]
+  void index_bit_maxima (float const * v, int nbits, float * one, float * zero)
+  {
+    for (int b = 0; b < nbits; ++b)
+      {
+        one[b] = zero[b] = -std::numeric_limits<float>::max ();
+        for (int i = 0; i < 1 << nbits; ++i)
+          {
+            if (i & (1 << b))
+              {
+                one[b] = std::max (one[b], v[i]);
+              }
+            else
+              {
+                zero[b] = std::max (zero[b], v[i]);
+              }
+          }
+      }
+  }
+
+  // scores |a(i) + sign * b(j)| of the hypotheses i * b.n + j, and the
+  // maxima over those with each bit of the index set, in one[], and
+  // clear, in zero[], bit 0 is the least significant
+  void bit_maxima (Sums const& a, Sums const& b, float sign, float * one, float * zero)
+  {
+    float row_max[max_sums];
+    float column_max[max_sums];
+    std::fill (column_max, column_max + b.n, 0.f);
+    for (int i = 0; i < a.n; ++i)
+      {
+        float score[max_sums];
+        for (int j = 0; j < b.n; ++j)
+          {
+            // as cabsf (), no overflow or loss of precision squaring
+            // a float in double
+            double re = a.re[i] + sign * b.re[j];
+            double im = a.im[i] + sign * b.im[j];
+            score[j] = static_cast<float> (std::sqrt (re * re + im * im));
+          }
+        float m {0.f};
+        for (int j = 0; j < b.n; ++j)
+          {
+            m = std::max (m, score[j]);
+            column_max[j] = std::max (column_max[j], score[j]);
+          }
+        row_max[i] = m;
+      }
+    auto column_bits = index_bits (b.n);
+    index_bit_maxima (column_max, column_bits, one, zero);
+    index_bit_maxima (row_max, index_bits (a.n), one + column_bits, zero + column_bits);
+  }
+
+  // metrics in the order the decoders store them, most significant
+  // bit first
+  void metrics (float const * one, float const * zero, int nbits, float * bm)
+  {
+    for (int ib = 0; ib < nbits; ++ib)
+      {
+        bm[ib] = one[nbits - 1 - ib] - zero[nbits - 1 - ib];
+      }
+  }
+
+  Sums const& no_sum ()
+  {
+    static Sums const zero {1, {0.f}, {0.f}};
+    return zero;
+  }
+}
+
+//
+// Bit metrics of the group of nsym symbols starting at cs, complex
+// cs(0:ntones-1,nsym) with ntones 4 or 8 and a group of at most 256
+// hypotheses, into bm(0:nsym*log2(ntones)-1), most significant bit
+// first. smax is the largest score.
+//
+// The hypothesis sums are (((cs(1) + cs(2)) + cs(3)) + ...) as in the
+// Fortran this replaces.
+//
+void nc_bitmetrics_ (float const cs[], int * ntones, int * nsym, int const graymap[],
+                     float bm[], float * smax)
+{
+  Sums prefix[2];
+  Sums last;
+  int current {0};
+  auto const * sums = &no_sum ();
+  for (int k = 0; k < *nsym - 1; ++k)
+    {
+      tones (cs + 2 * *ntones * k, *ntones, graymap, &last);
+      combine (*sums, last, 1.f, &prefix[current]);
+      sums = &prefix[current];
+      current ^= 1;
+    }
+  tones (cs + 2 * *ntones * (*nsym - 1), *ntones, graymap, &last);
+  float one[max_bits];
+  float zero[max_bits];
+  int nbits = *nsym * index_bits (*ntones);
+  bit_maxima (*sums, last, 1.f, one, zero);
+  metrics (one, zero, nbits, bm);
+  *smax = std::max (one[0], zero[0]);
+}
+
+//
+// FST4 bit metrics of 1, 2, 4 and 8 symbol groups into
+// bitmetrics(2*nn,4), cs is complex cs(0:3,nn) and nn a multiple of 8.
+//
+// As the Fortran this replaces the frame is processed in 8-symbol
+// chunks, the 2-symbol sums are made from the 1-symbol ones, the
+// 4-symbol sums from those and the 8-symbol scores from the 4-symbol
+// sums.  Note the 2-symbol sums are differences, c1(i,2*m-1)-c1(j,2*m).
+//
+void fst4_nc_bitmetrics_ (float const cs[], int * nn, int const graymap[], float bitmetrics[])
+{
+  auto const bits = 2 * *nn;
+  float one[max_bits];
+  float zero[max_bits];
+  for (int k = 0; k < *nn; k += 8)
+    {
+      auto store = [&] (int first, int nbits, int column) {
+        float bm[max_bits];
+        metrics (one, zero, nbits, bm);
+        for (int ib = 0; ib < nbits && first + ib < bits; ++ib)
+          {
+            bitmetrics[column * bits + first + ib] = bm[ib];
+          }
+      };
+
+      Sums c1[8];
+      for (int m = 0; m < 8; ++m)
+        {
+          tones (cs + 2 * 4 * (k + m), 4, graymap, &c1[m]);
+          bit_maxima (no_sum (), c1[m], 1.f, one, zero);
+          store (2 * k + 2 * m, 2, 0);
+        }
+
+      Sums c2[4];
+      for (int m = 0; m < 4; ++m)
+        {
+          combine (c1[2 * m], c1[2 * m + 1], -1.f, &c2[m]);
+          bit_maxima (c1[2 * m], c1[2 * m + 1], -1.f, one, zero);
+          store (2 * k + 4 * m, 4, 1);
+        }
+
+      Sums c4[2];
+      for (int m = 0; m < 2; ++m)
+        {
+          combine (c2[2 * m], c2[2 * m + 1], 1.f, &c4[m]);
+          bit_maxima (c2[2 * m], c2[2 * m + 1], 1.f, one, zero);
+          store (2 * k + 8 * m, 8, 2);
+        }
+
+      bit_maxima (c4[0], c4[1], 1.f, one, zero);
+      store (2 * k, 16, 3);
+    }
+}
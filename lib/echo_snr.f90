@@ -5,6 +5,7 @@ subroutine echo_snr(sa,sb,fspread,blue,red,snrdb,db_err,fpeak,snr_detect)
   real sb(NZ)
   real blue(NZ)
   real red(NZ)
+  real*8 ssum8
   integer ipkv(1)
   equivalence (ipk,ipkv)
 
@@ -30,8 +31,10 @@ subroutine echo_snr(sa,sb,fspread,blue,red,snrdb,db_err,fpeak,snr_detect)
 
   smax=0.
   mh=max(1,nint(0.2*fspread/df))
+  ssum8=sum(red(i2-mh:i2+mh))              !Running sum over i-mh:i+mh
   do i=i2,i3
-     ssum=sum(red(i-mh:i+mh))
+     if(i.gt.i2) ssum8=ssum8 + red(i+mh) - red(i-mh-1)
+     ssum=ssum8
      if(ssum.gt.smax) then
         smax=ssum
         ipk=i
@@ -221,6 +221,9 @@ end subroutine extract
 
 subroutine getpp(workdat,p)
 
+! Called by the RS trials in ftrsd_trials.c, possibly from several
+! threads at once, so s3a is only read here.
+
   use jt65_mod
   integer workdat(63)
   integer a(63)
@@ -232,10 +235,7 @@ subroutine getpp(workdat,p)
   psum=0.
   do j=1,63
      i=a(j)+1
-     x=s3a(i,j)
-     s3a(i,j)=0.
-     psum=psum + x
-     s3a(i,j)=x
+     psum=psum + s3a(i,j)
   enddo
   p=psum/63.0
 
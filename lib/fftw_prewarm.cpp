@@ -0,0 +1,379 @@
+//
+// fftw_prewarm.cpp
+//
+// FFTW wisdom and plan pre-warming for jt9.
+//
+// four2a() plans each FFT the first time it sees it, inside the
+// fftw critical section, so with a patience of 2 or more the first
+// decode of a mode stalls while FFTW measures.  Here the FFTs four2a
+// plans are recorded, per mode and T/R period, in jt9_fft_sizes.txt
+// and at startup a background thread plans all of them, those of the
+// last used mode first, so that the wisdom is in place before the
+// decoder asks for them.  A mode change moves the sizes of that mode
+// not yet planned to the front of the queue.
+//
+// The plans made here are thrown away, it is the wisdom they leave
+// behind that makes four2a's own planning quick.  Each is made inside
+// the same fftw critical section as the decoder's own planning, so it
+// is single threaded as four2a's are, and with a time limit so that
+// neither a decode that needs the planner nor jt9 shutting down waits
+// long for a measurement in progress.  Wisdom is only valid for the
+// CPU, FFTW library and FFT thread count it was measured with so the
+// wisdom file name includes a key made from them.  The unkeyed
+// jt9_wisdom.dat of earlier versions is imported if there is no
+// keyed wisdom yet.
+//
+// The time taken to pre-warm, and for the first decode of each mode
+// along with how long that decode spent planning FFTs, are written to
+// jt9_fftw.log in the data directory.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+#include <cpuid.h>
+#endif
+
+#include <fftw3.h>
+
+extern "C"
+{
+  // Fortran callable, trailing hidden length arguments as passed by
+  // gfortran
+  void fftw_prewarm_start_ (char const data_dir[], int * npatience, int * nthreads, fortran_charlen_t);
+  void fftw_prewarm_mode_ (int * mode, int * trperiod);
+  void fftw_prewarm_note_ (int * nfft, int * isign, int * iform, std::int64_t * address, float * ms);
+  void fftw_prewarm_decoded_ ();
+  void fftw_prewarm_finish_ ();
+
+  // fftw_prewarm_critical calls fftw_prewarm_plan in the fftw
+  // critical section
+  void fftw_prewarm_critical_ (int * nfft, int * isign, int * iform, int * offset, int * flags, int * made);
+  void fftw_prewarm_plan_ (int * nfft, int * isign, int * iform, int * offset, int * flags, int * made);
+}
+
+namespace
+{
+  using clock_type = std::chrono::steady_clock;
+
+  int const alignment {64};     // covers every FFTW SIMD alignment
+  double const plan_time_limit {0.5}; // s, per FFT
+
+  struct FFT
+  {
+    int mode;
+    int trperiod;
+    int nfft;
+    int isign;
+    int iform;
+    int offset;                 // address modulo alignment
+
+    bool same_plan (FFT const& rhs) const
+    {
+      return nfft == rhs.nfft && isign == rhs.isign && iform == rhs.iform && offset == rhs.offset;
+    }
+
+    bool operator == (FFT const& rhs) const
+    {
+      return mode == rhs.mode && trperiod == rhs.trperiod && same_plan (rhs);
+    }
+  };
+
+  std::mutex mutex;             // guards everything below
+  std::string data_dir;
+  int fft_threads {1};
+  std::string wisdom_file;
+  unsigned flags {FFTW_ESTIMATE};
+  std::vector<FFT> recorded;    // most recently used mode first
+  std::deque<FFT> queue;        // still to be planned
+  std::vector<FFT> planned;     // by the pre-warm thread
+  bool recorded_changed {false};
+  int mode {-1};
+  int trperiod {-1};
+  std::vector<std::pair<int, int>> decoded_modes; // first decode timed
+  bool timing_decode {false};
+  clock_type::time_point decode_started;
+  double decode_planning_ms {0.};
+  int decode_plans {0};
+  std::ofstream log;
+
+  std::thread prewarm;
+  std::atomic<bool> stop {false};
+
+  double ms_since (clock_type::time_point start)
+  {
+    return std::chrono::duration<double, std::milli> (clock_type::now () - start).count ();
+  }
+
+  // call with the mutex locked
+  std::ostream& log_line ()
+  {
+    auto now = std::time (nullptr);
+    char stamp[32];
+    std::strftime (stamp, sizeof stamp, "%Y-%m-%d %H:%M:%S ", std::gmtime (&now));
+    return log << stamp << std::fixed << std::setprecision (1);
+  }
+
+  // identifies the CPU model, FFTW build and FFT thread count, FNV-1a
+  // hashed, call with the mutex locked
+  std::string wisdom_key ()
+  {
+    std::string id {fftwf_version};
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+    unsigned regs[12] {};
+    if (__get_cpuid (0x80000000, &regs[0], &regs[1], &regs[2], &regs[3]) && regs[0] >= 0x80000004)
+      {
+        for (unsigned leaf = 0; leaf < 3; ++leaf)
+          {
+            __get_cpuid (0x80000002 + leaf, &regs[4 * leaf], &regs[4 * leaf + 1], &regs[4 * leaf + 2], &regs[4 * leaf + 3]);
+          }
+        id.append (reinterpret_cast<char const *> (regs), sizeof regs);
+      }
+#elif defined (__aarch64__)
+    id += "aarch64";
+#endif
+    id += std::to_string (fft_threads);
+    std::uint32_t hash {2166136261u};
+    for (unsigned char c : id)
+      {
+        hash = (hash ^ c) * 16777619u;
+      }
+    std::ostringstream key;
+    key << std::hex << std::setw (8) << std::setfill ('0') << hash;
+    return key.str ();
+  }
+
+  void read_sizes ()
+  {
+    std::ifstream in {data_dir + "/jt9_fft_sizes.txt"};
+    std::string line;
+    while (std::getline (in, line))
+      {
+        FFT fft;
+        std::istringstream fields {line};
+        if ('#' != line[0]
+            && fields >> fft.mode >> fft.trperiod >> fft.nfft >> fft.isign >> fft.iform >> fft.offset
+            && fft.nfft > 0 && fft.offset >= 0 && fft.offset < alignment
+            && recorded.end () == std::find (recorded.begin (), recorded.end (), fft))
+          {
+            recorded.push_back (fft);
+          }
+      }
+  }
+
+  void write_sizes ()
+  {
+    std::ofstream out {data_dir + "/jt9_fft_sizes.txt", std::ios::trunc};
+    out << "# FFTs planned by four2a: mode T/R-period nfft isign iform alignment-offset\n";
+    for (auto const& fft : recorded)
+      {
+        out << fft.mode << ' ' << fft.trperiod << ' ' << fft.nfft << ' ' << fft.isign
+            << ' ' << fft.iform << ' ' << fft.offset << '\n';
+      }
+  }
+
+  // plan in the fftw critical section, false if no plan could be made
+  // which with FFTW_WISDOM_ONLY means there is no wisdom for it yet
+  bool plan (FFT const& fft, unsigned plan_flags)
+  {
+    int nfft {fft.nfft};
+    int isign {fft.isign};
+    int iform {fft.iform};
+    int offset {fft.offset};
+    int flags = plan_flags;
+    int made {0};
+    fftw_prewarm_critical_ (&nfft, &isign, &iform, &offset, &flags, &made);
+    return made;
+  }
+
+  void run_prewarm ()
+  {
+    auto start = clock_type::now ();
+    int count {0};
+    int measured {0};
+    while (!stop)
+      {
+        FFT fft;
+        {
+          std::lock_guard<std::mutex> lock {mutex};
+          if (!queue.size ()) break;
+          fft = queue.front ();
+          queue.pop_front ();
+          if (planned.end () != std::find_if (planned.begin (), planned.end (), [&fft] (FFT const& p) {
+                return p.same_plan (fft);
+              }))
+            {
+              continue;
+            }
+          planned.push_back (fft);
+        }
+        if (!plan (fft, flags | FFTW_WISDOM_ONLY))
+          {
+            plan (fft, flags);
+            ++measured;
+          }
+        ++count;
+      }
+    std::lock_guard<std::mutex> lock {mutex};
+    log_line () << "pre-warm " << (stop ? "stopped after " : "planned ") << count
+                << " FFTs, " << measured << " not in the wisdom, in " << ms_since (start) << " ms" << std::endl;
+  }
+
+  // call with the mutex locked
+  void prioritize (int mode, int trperiod)
+  {
+    std::stable_partition (queue.begin (), queue.end (), [mode, trperiod] (FFT const& fft) {
+        return fft.mode == mode && fft.trperiod == trperiod;
+      });
+  }
+}
+
+void fftw_prewarm_start_ (char const dir[], int * npatience, int * nthreads, fortran_charlen_t len)
+{
+  std::lock_guard<std::mutex> lock {mutex};
+  data_dir.assign (dir, len);
+  fft_threads = *nthreads;
+  while (data_dir.size () && ' ' == data_dir.back ()) data_dir.pop_back ();
+  log.open (data_dir + "/jt9_fftw.log", std::ios::trunc);
+
+  // Planning: FFTW_ESTIMATE, FFTW_ESTIMATE_PATIENT, FFTW_MEASURE,
+  //            FFTW_PATIENT,  FFTW_EXHAUSTIVE, as four2a
+  switch (*npatience)
+    {
+    case 1: flags = FFTW_ESTIMATE_PATIENT; break;
+    case 2: flags = FFTW_MEASURE; break;
+    case 3: flags = FFTW_PATIENT; break;
+    case 4: flags = FFTW_EXHAUSTIVE; break;
+    default: flags = FFTW_ESTIMATE; break;
+    }
+
+  auto key = wisdom_key ();
+  wisdom_file = data_dir + "/jt9_wisdom_" + key + ".dat";
+  auto imported = fftwf_import_wisdom_from_filename (wisdom_file.c_str ());
+  auto legacy = !imported && fftwf_import_wisdom_from_filename ((data_dir + "/jt9_wisdom.dat").c_str ());
+  log_line () << fftwf_version << " wisdom key " << key
+              << (imported ? ", wisdom imported" : legacy ? ", jt9_wisdom.dat imported" : ", no wisdom yet")
+              << std::endl;
+
+  read_sizes ();
+  if (*npatience > 0 && recorded.size ())
+    {
+      queue.assign (recorded.begin (), recorded.end ());
+      prewarm = std::thread {run_prewarm};
+    }
+}
+
+void fftw_prewarm_mode_ (int * new_mode, int * new_trperiod)
+{
+  std::lock_guard<std::mutex> lock {mutex};
+  mode = *new_mode;
+  trperiod = *new_trperiod;
+  prioritize (mode, trperiod);
+  auto key = std::make_pair (mode, trperiod);
+  timing_decode = decoded_modes.end () == std::find (decoded_modes.begin (), decoded_modes.end (), key);
+  if (timing_decode)
+    {
+      decoded_modes.push_back (key);
+      decode_started = clock_type::now ();
+      decode_planning_ms = 0.;
+      decode_plans = 0;
+    }
+}
+
+void fftw_prewarm_note_ (int * nfft, int * isign, int * iform, std::int64_t * address, float * ms)
+{
+  std::lock_guard<std::mutex> lock {mutex};
+  if (timing_decode)
+    {
+      decode_planning_ms += *ms;
+      ++decode_plans;
+    }
+  if (mode < 0) return;         // not decoding for WSJT-X
+  FFT fft {mode, trperiod, *nfft, *isign, *iform, int (*address % alignment)};
+  auto found = std::find (recorded.begin (), recorded.end (), fft);
+  if (recorded.end () == found)
+    {
+      recorded.push_back (fft);
+      recorded_changed = true;
+    }
+}
+
+void fftw_prewarm_decoded_ ()
+{
+  std::lock_guard<std::mutex> lock {mutex};
+  if (!timing_decode) return;
+  timing_decode = false;
+  log_line () << "first decode of mode " << mode << " T/R " << trperiod << " s took "
+              << ms_since (decode_started) << " ms, " << decode_planning_ms << " ms of it planning "
+              << decode_plans << " FFTs" << std::endl;
+
+  // keep the sizes of the most recently used mode first
+  std::stable_partition (recorded.begin (), recorded.end (), [] (FFT const& fft) {
+      return fft.mode == mode && fft.trperiod == trperiod;
+    });
+  recorded_changed = true;
+}
+
+void fftw_prewarm_finish_ ()
+{
+  stop = true;
+  if (prewarm.joinable ()) prewarm.join ();
+
+  std::lock_guard<std::mutex> lock {mutex};
+  if (wisdom_file.size ()) fftwf_export_wisdom_to_filename (wisdom_file.c_str ());
+  if (recorded_changed) write_sizes ();
+  log.close ();
+}
+
+// plan as four2a would, in place with the same alignment, and keep
+// only the wisdom, called in the fftw critical section
+void fftw_prewarm_plan_ (int * nfft, int * isign, int * iform, int * offset, int * plan_flags, int * made)
+{
+  *made = 0;
+  auto floats = 1 == *iform ? 2 * *nfft : 2 * (*nfft / 2 + 1);
+  auto * buffer = static_cast<char *> (fftwf_malloc (floats * sizeof (float) + 2 * alignment));
+  if (!buffer) return;
+  auto base = reinterpret_cast<std::uintptr_t> (buffer);
+  auto * a = reinterpret_cast<float *> (buffer + (alignment - base % alignment) % alignment + *offset);
+  auto * c = reinterpret_cast<fftwf_complex *> (a);
+  unsigned flags = *plan_flags;
+  fftwf_plan_with_nthreads (1); // four2a's plans are single threaded
+  fftwf_set_timelimit (plan_time_limit);
+  fftwf_plan p {nullptr};
+  if (-1 == *isign && 1 == *iform)
+    {
+      p = fftwf_plan_dft_1d (*nfft, c, c, FFTW_FORWARD, flags);
+    }
+  else if (1 == *isign && 1 == *iform)
+    {
+      p = fftwf_plan_dft_1d (*nfft, c, c, FFTW_BACKWARD, flags);
+    }
+  else if (-1 == *isign && 0 == *iform)
+    {
+      p = fftwf_plan_dft_r2c_1d (*nfft, a, c, flags);
+    }
+  else if (1 == *isign && -1 == *iform)
+    {
+      p = fftwf_plan_dft_c2r_1d (*nfft, c, a, flags);
+    }
+  fftwf_set_timelimit (FFTW_NO_TIMELIMIT);
+  if (p)
+    {
+      fftwf_destroy_plan (p);
+      *made = 1;
+    }
+  fftwf_free (buffer);
+}
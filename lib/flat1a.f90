@@ -6,9 +6,7 @@ subroutine flat1a(psavg,nsmo,s2,nh,nsteps,nhmax,nsmax)
 
   ia=nsmo/2 + 1
   ib=nh - nsmo/2 - 1
-  do i=ia,ib
-     call pctile(psavg(i-nsmo/2),nsmo,50,x(i))
-  enddo
+  call running_pctile(psavg,nh,nsmo,50,x(ia),ib-ia+1)
   do i=1,ia-1
      x(i)=x(ia)
   enddo
@@ -7,9 +7,7 @@ subroutine flat2(s,nz,ref)
   nsmo=10
   ia=nsmo+1
   ib=nz-nsmo-1
-  do i=ia,ib
-     call pctile(s(i-nsmo),2*nsmo+1,5,ref(i))
-  enddo
+  call running_pctile(s,nz,2*nsmo+1,5,ref(ia),ib-ia+1)
 
   ref(:ia-1)=ref(ia)
   ref(ib+1:)=ref(ib)
@@ -12,9 +12,7 @@ subroutine flat65(ss,nhsym,maxhsym,nsz,ref)
   nsmo=33
   ia=nsmo/2 + 1
   ib=nsz - nsmo/2 - 1
-  do i=ia,ib
-     call pctile(stmp(i-nsmo/2),nsmo,npct,ref(i))
-  enddo
+  call running_pctile(stmp,nsz,nsmo,npct,ref(ia),ib-ia+1)
   ref(:ia-1)=ref(ia)
   ref(ib+1:)=ref(ib)
   ref=4.0*ref
@@ -27,6 +27,7 @@ subroutine four2a(a,nfft,ndim,isign,iform)
   integer nn(NPMAX),ns(NPMAX),nf(NPMAX)  !Params of stored plans 
   integer*8 nl(NPMAX),nloc               !More params of plans
   integer*8 plan(NPMAX)                  !Pointers to stored plans
+  integer*8 ic0,ic1,icrate               !To time the planning
   logical found_plan
   data nplan/0/                          !Number of stored plans
   common/patience/npatience,nthreads     !Patience and threads for FFTW plans
@@ -71,6 +72,7 @@ subroutine four2a(a,nfft,ndim,isign,iform)
         aa(1:jz)=a(1:jz)
      endif
 
+     call system_clock(ic0,icrate)
      !$omp critical(fftw) ! serialize non thread-safe FFTW3 calls
      if(isign.eq.-1 .and. iform.eq.1) then
         call sfftw_plan_dft_1d(plan(i),nfft,a,a,FFTW_FORWARD,nflags)
@@ -84,6 +86,10 @@ subroutine four2a(a,nfft,ndim,isign,iform)
         stop 'Unsupported request in four2a'
      endif
      !$omp end critical(fftw)
+     call system_clock(ic1)
+! Record the FFT so that jt9 can plan it ahead next time
+     call fftw_prewarm_note(nfft,isign,iform,nloc,                          &
+          1000.0*real(ic1-ic0)/real(icrate))
 
      if(nfft.le.NSMALL) then
         jz=nfft
@@ -112,3 +118,18 @@ subroutine four2a(a,nfft,ndim,isign,iform)
 
   return
 end subroutine four2a
+
+subroutine fftw_prewarm_critical(nfft,isign,iform,noffset,nflags,nmade)
+
+! Called by jt9's FFTW pre-warm thread to plan one FFT inside the same
+! critical section as four2a, filbig and downsam9, so that the plan is
+! never made while one of them has set fftwf_plan_with_nthreads() for
+! a multi-threaded plan.  It is in this file so that it is linked
+! whenever four2a, which feeds the pre-warm, is.
+
+  !$omp critical(fftw) ! serialize non thread-safe FFTW3 calls
+  call fftw_prewarm_plan(nfft,isign,iform,noffset,nflags,nmade)
+  !$omp end critical(fftw)
+
+  return
+end subroutine fftw_prewarm_critical
@@ -8,11 +8,9 @@ subroutine get_ft4_bitmetrics(cd,bitmetrics,badsync)
    integer icos4a(0:3),icos4b(0:3),icos4c(0:3),icos4d(0:3)
    integer graymap(0:3)
    integer ip(1)
-   logical one(0:255,0:7)    ! 256 4-symbol sequences, 8 bits
-   logical first
    logical badsync
    real bitmetrics(2*NN,3)
-   real s2(0:255)
+   real bmg(0:7)
    real s4(0:3,NN)
 
    data icos4a/0,1,3,2/
@@ -20,18 +18,6 @@ subroutine get_ft4_bitmetrics(cd,bitmetrics,badsync)
    data icos4c/2,3,1,0/
    data icos4d/3,2,0,1/
    data graymap/0,1,3,2/
-   data first/.true./
-   save first,one
-
-   if(first) then
-      one=.false.
-      do i=0,255
-         do j=0,7
-            if(iand(i,2**j).ne.0) one(i,j)=.true.
-         enddo
-      enddo
-      first=.false.
-   endif
 
    do k=1,NN
       i1=(k-1)*NSS
@@ -47,7 +33,6 @@ subroutine get_ft4_bitmetrics(cd,bitmetrics,badsync)
    is3=0
    is4=0
    badsync=.false.
-   ibmax=0
    
    do k=1,4
       ip=maxloc(s4(:,k))
@@ -69,37 +54,14 @@ subroutine get_ft4_bitmetrics(cd,bitmetrics,badsync)
       if(nseq.eq.1) nsym=1
       if(nseq.eq.2) nsym=2
       if(nseq.eq.3) nsym=4
-      nt=2**(2*nsym)
+      nbits=2*nsym
       do ks=1,NN-nsym+1,nsym  !87+16=103 symbols.
-         amax=-1.0
-         do i=0,nt-1
-            i1=i/64
-            i2=iand(i,63)/16
-            i3=iand(i,15)/4
-            i4=iand(i,3)
-            if(nsym.eq.1) then
-               s2(i)=abs(cs(graymap(i4),ks))
-            elseif(nsym.eq.2) then
-               s2(i)=abs(cs(graymap(i3),ks)+cs(graymap(i4),ks+1))
-            elseif(nsym.eq.4) then
-               s2(i)=abs(cs(graymap(i1),ks  ) + &
-                  cs(graymap(i2),ks+1) + &
-                  cs(graymap(i3),ks+2) + &
-                  cs(graymap(i4),ks+3)   &
-                  )
-            else
-               print*,"Error - nsym must be 1, 2, or 4."
-            endif
-         enddo
+! Max-log metrics over the 4**nsym tone hypotheses, in lib/bitmetrics.cpp
+         call nc_bitmetrics(cs(0,ks),4,nsym,graymap,bmg,smax)
          ipt=1+(ks-1)*2
-         if(nsym.eq.1) ibmax=1
-         if(nsym.eq.2) ibmax=3
-         if(nsym.eq.4) ibmax=7
-         do ib=0,ibmax
-            bm=maxval(s2(0:nt-1),one(0:nt-1,ibmax-ib)) - &
-               maxval(s2(0:nt-1),.not.one(0:nt-1,ibmax-ib))
+         do ib=0,nbits-1
             if(ipt+ib.gt.2*NN) cycle
-            bitmetrics(ipt+ib,nseq)=bm
+            bitmetrics(ipt+ib,nseq)=bmg(ib)
          enddo
       enddo
    enddo
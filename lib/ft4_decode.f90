@@ -28,6 +28,7 @@ contains
       use timer_module, only: timer
       use packjt77
       include 'ft4/ft4_params.f90'
+      include 'timer_common.inc'
       parameter (MAXCAND=200)
       class(ft4_decoder), intent(inout) :: this
       procedure(ft4_decode_callback) :: callback
@@ -50,6 +51,7 @@ contains
       real dd(NMAX)
       real llr(2*ND),llra(2*ND),llrb(2*ND),llrc(2*ND),llrd(2*ND)
       real candidate(2,MAXCAND)
+      real f1c(MAXCAND),smaxc(MAXCAND),dminc(MAXCAND)
       real savg(NH1),sbase(NH1)
 
       integer apbits(2*ND)
@@ -63,9 +65,11 @@ contains
       integer naptypes(0:5,4)   ! nQSOProgress, decoding pass
       integer mcq(29),mcqru(29),mcqfd(29),mcqtest(29),mcqww(29)
       integer mrrr(19),m73(19),mrr73(19)
+      integer ibestc(MAXCAND),iaptypec(MAXCAND),nharderrorc(MAXCAND)
+      integer*1 message77c(77,MAXCAND)
 
       logical nohiscall,unpk77_success
-      logical first, dobigfft
+      logical first
       logical dosubtract,doosd
       logical badsync
       logical, intent(in) :: lapcqonly
@@ -220,14 +224,31 @@ contains
          call getcandidates4(dd,fa,fb,syncmin,nfqso,MAXCAND,savg,candidate,   &
             ncand,sbase)
          call timer('getcand4',1)
-         dobigfft=.true.
+         if(ncand.eq.0) cycle
+
+! The big FFT of dd is done once here and shared, read-only, by all
+! candidates, which are then decoded in parallel.  Decodes are
+! reported, and their signals subtracted from dd, afterwards in
+! candidate order, so the results do not depend on the number of
+! threads.
+         call timer('ft4_down',0)
+         call ft4_downsample(dd,.true.,candidate(1,1),cd2)
+         call timer('ft4_down',1)
+         nharderrorc=-1
+
+         !$omp parallel do schedule(dynamic) default(shared) copyin(/timer_private/) &
+         !$omp private(icand,f0,cd2,sum2,iseg,isync,idfmin,idfmax,idfstp,ibmin,  &
+         !$omp    ibmax,ibstp,ibest,idfbest,smax,smax1,idf,istart,sync,f1,cb,cd,  &
+         !$omp    it,np,bitmetrics,badsync,hbits,ns1,ns2,ns3,ns4,nsync_qual,      &
+         !$omp    scalefac,llra,llrb,llrc,llrd,llr,apmag,npasses,ipass,apmask,    &
+         !$omp    iaptype,napwid,message77,dmin,ndeep,maxosd,Keff,message91,cw,   &
+         !$omp    ntype,nharderror)
          do icand=1,ncand
             f0=candidate(1,icand)
-            snr=candidate(2,icand)-1.0
+            napwid=50                     !AP/deep-OSD window around nfqso, Hz
             call timer('ft4_down',0)
-            call ft4_downsample(dd,dobigfft,f0,cd2)  !Downsample to 32 Sam/Sym
+            call ft4_downsample(dd,.false.,f0,cd2)  !Downsample to 32 Sam/Sym
             call timer('ft4_down',1)
-            if(dobigfft) dobigfft=.false.
             sum2=sum(cd2*conjg(cd2))/(real(NMAX)/real(NDOWN))
             if(sum2.gt.0.0) cd2=cd2/sqrt(sum2)
 ! Sample rate is now 12000/18 = 666.67 samples/second
@@ -281,7 +302,7 @@ contains
                f1=f0+real(idfbest)
                if( f1.le.10.0 .or. f1.ge.4990.0 ) cycle
                call timer('ft4down ',0)
-               call ft4_downsample(dd,dobigfft,f1,cb) !Final downsample, corrected f0
+               call ft4_downsample(dd,.false.,f1,cb) !Final downsample, corrected f0
                call timer('ft4down ',1)
                sum2=sum(abs(cb)**2)/(real(NSS)*NN)
                if(sum2.gt.0.0) cb=cb/sqrt(sum2)
@@ -349,7 +370,6 @@ contains
 !          7 : HOUND
 !
 ! Conditions that cause us to bail out of AP decoding
-                     napwid=50
                      if(ncontest.le.5 .and. iaptype.ge.3 .and. (abs(f1-nfqso).gt.napwid) ) cycle
                      if(iaptype.ge.2 .and. apbits(1).gt.1) cycle  ! No, or nonstandard, mycall
                      if(iaptype.ge.3 .and. apbits(30).gt.1) cycle ! No, or nonstandard, dxcall
@@ -427,39 +447,55 @@ contains
 
                   if(sum(message77).eq.0) cycle
                   if( nharderror.ge.0 ) then
-                     message77=mod(message77+rvec,2) ! remove rvec scrambling
-                     write(c77,'(77i1)') message77(1:77)
-                     call unpack77(c77,1,message,unpk77_success)
-                     if(.not.unpk77_success) exit
-                     if(dosubtract) then
-                        call get_ft4_tones_from_77bits(message77,i4tone)
-                        dt=real(ibest)/666.67
-                        call timer('subtract',0)
-                        call subtractft4(dd,i4tone,f1,dt)
-                        call timer('subtract',1)
-                     endif
-                     idupe=0
-                     do i=1,ndecodes
-                        if(decodes(i).eq.message) idupe=1
-                     enddo
-                     if(idupe.eq.1) exit
-                     ndecodes=ndecodes+1
-                     decodes(ndecodes)=message
-                     if(snr.gt.0.0) then
-                        xsnr=10*log10(snr)-14.8
-                     else
-                        xsnr=-21.0
-                     endif
-                     nsnr=nint(max(-21.0,xsnr))
-                     xdt=ibest/666.67 - 0.5
-                     qual=1.0-(nharderror+dmin)/60.0 
-                     call this%callback(smax,nsnr,xdt,f1,message,iaptype,qual)
+                     nharderrorc(icand)=nharderror
+                     message77c(:,icand)=message77
+                     iaptypec(icand)=iaptype
+                     dminc(icand)=dmin
+                     f1c(icand)=f1
+                     ibestc(icand)=ibest
+                     smaxc(icand)=smax
                      exit
                   endif
                enddo                      !Sequence estimation
                if(nharderror.ge.0) exit
             enddo                         !3 DT segments
          enddo                            !Candidate list
+         !$omp end parallel do
+
+         do icand=1,ncand
+            if(nharderrorc(icand).lt.0) cycle
+            message77=mod(message77c(:,icand)+rvec,2) ! remove rvec scrambling
+            write(c77,'(77i1)') message77(1:77)
+            call unpack77(c77,1,message,unpk77_success)
+            if(.not.unpk77_success) cycle
+            f1=f1c(icand)
+            ibest=ibestc(icand)
+            if(dosubtract) then
+               call get_ft4_tones_from_77bits(message77,i4tone)
+               dt=real(ibest)/666.67
+               call timer('subtract',0)
+               call subtractft4(dd,i4tone,f1,dt)
+               call timer('subtract',1)
+            endif
+            idupe=0
+            do i=1,ndecodes
+               if(decodes(i).eq.message) idupe=1
+            enddo
+            if(idupe.eq.1) cycle
+            ndecodes=ndecodes+1
+            decodes(ndecodes)=message
+            snr=candidate(2,icand)-1.0
+            if(snr.gt.0.0) then
+               xsnr=10*log10(snr)-14.8
+            else
+               xsnr=-21.0
+            endif
+            nsnr=nint(max(-21.0,xsnr))
+            xdt=ibest/666.67 - 0.5
+            qual=1.0-(nharderrorc(icand)+dminc(icand))/60.0
+            call this%callback(smaxc(icand),nsnr,xdt,f1,message,         &
+                 iaptypec(icand),qual)
+         enddo                            !Decodes, in candidate order
       enddo                               !Subtraction loop
       return
    end subroutine decode
@@ -17,6 +17,7 @@ subroutine encode174_91(message77,codeword)
    logical first
    data first/.true./
    save first,gen
+!$omp threadprivate(first,gen)
 
    if( first ) then ! fill the generator matrix
       gen=0
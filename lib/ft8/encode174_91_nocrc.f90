@@ -15,6 +15,7 @@ subroutine encode174_91_nocrc(message,codeword)
    logical first
    data first/.true./
    save first,gen
+!$omp threadprivate(first,gen)
 
    if( first ) then ! fill the generator matrix
       gen=0
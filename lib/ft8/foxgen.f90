@@ -1,4 +1,4 @@
-subroutine foxgen(bSuperFox,fname)
+subroutine foxgen(bSuperFox)
 
   ! Called from MainWindow::foxTxSequencer() to generate the Tx waveform in
   ! FT8 Fox mode.  The Tx message can contain up to 5 "slots", each carrying
@@ -18,7 +18,6 @@ subroutine foxgen(bSuperFox,fname)
   parameter (NWAVE=(160+2)*134400*4) !the biggest waveform we generate (FST4-1800 at 48kHz)
   parameter (NFFT=614400,NH=NFFT/2)
   logical*1 bSuperFox,bMoreCQs,bSendMsg
-  character*(*) fname
   character*40 cmsg,cmsg2
   character*26 textMsg
   character*37 msg,msgsent
@@ -34,6 +33,8 @@ subroutine foxgen(bSuperFox,fname)
   common/foxcom3/nslots2,cmsg2(5),itone3(151)
   equivalence (x,cx),(y,cy)
 
+! For SuperFox only the messages are passed on, to sftx_sub() in
+! common/foxcom3/; sfox_wave_gfsk() then generates the waveform.
   if(bSuperFox) then
      n=nslots
      if(bMoreCQs) cmsg(1)(40:40)='1'               !Set flag to include a CQ
@@ -2,7 +2,7 @@ subroutine foxgen_wrap(msg40,msgbits,itone)
 
   parameter (NN=79,ND=58,KK=77,NSPS=4*1920)
   parameter (NWAVE=(160+2)*134400*4) !the biggest waveform we generate (FST4-1800)
-  logical*1 bMoreCQs
+  logical*1 bMoreCQs,bSuperFox
   character*40 msg40,cmsg
   character*12 mycall12
   integer*1 msgbits(KK),msgbits2
@@ -17,7 +17,8 @@ subroutine foxgen_wrap(msg40,msgbits,itone)
   mycall12=msg40(i1+1:i2-1)//'    '
   cmsg(1)=msg40
   i3bit(1)=1
-  call foxgen()
+  bSuperFox=.false.
+  call foxgen(bSuperFox)
   msgbits=msgbits2
   itone=itone2
 
@@ -0,0 +1,95 @@
+module ft8_spectrogram
+
+! Time-frequency grids of the current FT8 slot, shared by sync8 and
+! get_spectrum_baseline.  The samples used are kept so that a later
+! update, e.g. after subtractft8 has removed decoded signals or with
+! more of the slot received, only recomputes the spectra of frames
+! whose input has changed.
+
+  include 'ft8_params.f90'
+  parameter (NBLK=NMAX/NSTEP)              !Change detection blocks (375)
+  parameter (NSSY=NSPS/NSTEP)              !Blocks per symbol spectrum
+  parameter (NST=NFFT1/2,NF=93)            !Baseline spectra step and count
+  parameter (NBSY=NFFT1/NSTEP)             !Blocks per baseline spectrum
+
+  real s8(NH1,NHSYM)                       !Symbol spectra, 1/4-sym steps
+  real sb(NH1,NF)                          !Windowed spectra for baseline
+  real savgb(NH1)                          !Average of sb
+  integer nbf                              !Number of valid sb spectra
+  real dd_last(NMAX)                       !Samples the grids came from
+  logical lvalid
+  data lvalid/.false./
+  save
+
+contains
+
+subroutine spectrogram_update(dd)
+
+  real dd(NMAX)
+  real x(NFFT1+2)
+  real window(NFFT1)
+  complex cx(0:NH1)
+  logical changed(NBLK)
+  logical first
+  equivalence (x,cx)
+  data first/.true./
+  save first,window
+
+  if(first) then
+     first=.false.
+     window=0.
+     call nuttal_window(window,NFFT1)
+     window=window/sum(window)*NSPS*2/300.0
+  endif
+
+! Find the blocks of samples that differ from last time
+  if(lvalid) then
+     do k=1,NBLK
+        ia=(k-1)*NSTEP + 1
+        ib=ia+NSTEP-1
+        changed(k)=any(dd(ia:ib).ne.dd_last(ia:ib))
+     enddo
+     if(.not.any(changed)) return
+  else
+     changed=.true.
+  endif
+
+! Symbol spectra for sync8, stepping by NSTEP
+  fac=1.0/300.0
+  do j=1,NHSYM
+     if(.not.any(changed(j:min(j+NSSY-1,NBLK)))) cycle
+     ia=(j-1)*NSTEP + 1
+     ib=ia+NSPS-1
+     x(1:NSPS)=fac*dd(ia:ib)
+     x(NSPS+1:)=0.
+     call four2a(x,NFFT1,1,-1,0)              !r2c FFT
+     do i=1,NH1
+        s8(i,j)=real(cx(i))**2 + aimag(cx(i))**2
+     enddo
+  enddo
+
+! Windowed spectra for get_spectrum_baseline, stepping by NST
+  nbf=0
+  do j=1,NF
+     ia=(j-1)*NST + 1
+     ib=ia+NFFT1-1
+     if(ib.gt.NMAX) exit
+     nbf=j
+     k=(j-1)*NST/NSTEP + 1
+     if(.not.any(changed(k:min(k+NBSY-1,NBLK)))) cycle
+     x(1:NFFT1)=dd(ia:ib)*window
+     call four2a(x,NFFT1,1,-1,0)              !r2c FFT
+     sb(1:NH1,j)=abs(cx(1:NH1))**2
+  enddo
+  savgb=0.
+  do j=1,nbf
+     savgb=savgb + sb(1:NH1,j)                !Average spectrum
+  enddo
+
+  dd_last=dd
+  lvalid=.true.
+
+  return
+end subroutine spectrogram_update
+
+end module ft8_spectrogram
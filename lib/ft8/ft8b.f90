@@ -13,7 +13,7 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
   character*77 c77
   real a(5)
   real s8(0:7,NN)
-  real s2(0:511)
+  real bmg(0:8)
   real bmeta(174),bmetb(174),bmetc(174),bmetd(174)
   real llra(174),llrb(174),llrc(174),llrd(174),llrz(174)           !Soft symbols
   real dd0(15*12000)
@@ -27,7 +27,6 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
   integer nappasses(0:5)  !Number of decoding passes to use for each QSO state
   integer naptypes(0:5,4) ! (nQSOProgress, decoding pass)  maximum of 4 passes for now
   integer ncontest,ncontest0
-  logical one(0:511,0:8)
   integer graymap(0:7)
   integer iloc(1)
   complex cd0(0:3199)
@@ -46,7 +45,7 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
   data   mrr73/0,1,1,1,1,1,1,0,0,1,1,1,0,1,0,1,0,0,1/
   data first/.true./
   data graymap/0,1,3,2,5,6,4,7/
-  save nappasses,naptypes,ncontest0,one
+  save nappasses,naptypes,ncontest0
 
   if(first.or.(ncontest.ne.ncontest0)) then
      mcq=2*mcq-1
@@ -80,12 +79,6 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
      naptypes(4,1:4)=(/3,4,5,6/) ! Tx4
      naptypes(5,1:4)=(/3,1,2,0/) ! Tx5
 
-     one=.false.
-     do i=0,511
-       do j=0,8
-         if(iand(i,2**j).ne.0) one(i,j)=.true.
-       enddo
-     enddo
      first=.false.
      ncontest0=ncontest
   endif
@@ -179,41 +172,24 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
     return
   endif
 
+! Max-log metrics over the 8**nsym tone hypotheses of each group of
+! nsym symbols, in lib/bitmetrics.cpp
+  call timer('bitmets ',0)
   do nsym=1,3
-    nt=2**(3*nsym)
+    nbits=3*nsym
     do ihalf=1,2
       do k=1,29,nsym
         if(ihalf.eq.1) ks=k+7
         if(ihalf.eq.2) ks=k+43
-        amax=-1.0
-        do i=0,nt-1
-          i1=i/64
-          i2=iand(i,63)/8
-          i3=iand(i,7)
-          if(nsym.eq.1) then
-            s2(i)=abs(cs(graymap(i3),ks))
-          elseif(nsym.eq.2) then
-            s2(i)=abs(cs(graymap(i2),ks)+cs(graymap(i3),ks+1))
-          elseif(nsym.eq.3) then
-            s2(i)=abs(cs(graymap(i1),ks)+cs(graymap(i2),ks+1)+cs(graymap(i3),ks+2))
-          else
-            print*,"Error - nsym must be 1, 2, or 3."
-          endif
-        enddo
+        call nc_bitmetrics(cs(0,ks),8,nsym,graymap,bmg,smax)
         i32=1+(k-1)*3+(ihalf-1)*87
-        if(nsym.eq.1) ibmax=2 
-        if(nsym.eq.2) ibmax=5 
-        if(nsym.eq.3) ibmax=8 
-        do ib=0,ibmax
-          bm=maxval(s2(0:nt-1),one(0:nt-1,ibmax-ib)) - &
-             maxval(s2(0:nt-1),.not.one(0:nt-1,ibmax-ib))
+        do ib=0,nbits-1
+          bm=bmg(ib)
           if(i32+ib .gt.174) cycle
           if(nsym.eq.1) then
             bmeta(i32+ib)=bm
-            den=max(maxval(s2(0:nt-1),one(0:nt-1,ibmax-ib)), &
-                    maxval(s2(0:nt-1),.not.one(0:nt-1,ibmax-ib)))
-            if(den.gt.0.0) then
-              cm=bm/den
+            if(smax.gt.0.0) then
+              cm=bm/smax
             else ! erase it
               cm=0.0
             endif
@@ -227,6 +203,7 @@ subroutine ft8b(dd0,newdat,nQSOProgress,nfqso,nftx,ndepth,nzhsym,lapon,     &
       enddo
     enddo
   enddo
+  call timer('bitmets ',1)
   call normalizebmet(bmeta,174)
   call normalizebmet(bmetb,174)
   call normalizebmet(bmetc,174)
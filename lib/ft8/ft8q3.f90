@@ -16,6 +16,7 @@ subroutine ft8q3(cd,xdt,f0,call_1,call_2,grid4,msgbest,snr)
   real xjunk(NWAVE)
   real ccf(0:NLAGS-1)
   real ccfmsg(206)
+  real xq(2)
   integer itone(NN)
   integer*1 msgbits(77)
   logical std_1,std_2
@@ -95,8 +96,9 @@ subroutine ft8q3(cd,xdt,f0,call_1,call_2,grid4,msgbest,snr)
      endif
   enddo  ! imsg
 
-  call pctile(ccfmsg,207,50,base)
-  call pctile(ccfmsg,207,67,sigma)
+  call pctiles(ccfmsg,207,(/50,67/),2,xq)
+  base=xq(1)
+  sigma=xq(2)
   sigma=sigma-base
   ccfmsg=(ccfmsg-base)/sigma
 !  do imsg=1,207
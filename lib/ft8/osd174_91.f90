@@ -29,6 +29,7 @@ subroutine osd174_91(llr,k,apmask,ndeep,message91,cw,nhardmin,dmin)
    logical first,reset
    data first/.true./
    save first
+!$omp threadprivate(first,gen)
 
    allocate( genmrb(k,N), g2(N,k) )
    allocate( temp(k), m0(k), me(k), mi(k), misub(k), e2sub(N-k), e2(N-k), ui(N-k) )
@@ -338,6 +339,7 @@ subroutine boxit91(reset,e2,ntau,npindex,i1,i2)
    integer   indexes(5000,2),fp(0:525000),np(5000)
    logical reset
    common/boxes/indexes,fp,np
+!$omp threadprivate(/boxes/)
 
    if(reset) then
       patterns=-1
@@ -376,6 +378,7 @@ subroutine fetchit91(reset,e2,ntau,i1,i2)
    logical reset
    common/boxes/indexes,fp,np
    save lastpat,inext
+!$omp threadprivate(/boxes/,lastpat,inext)
 
    if(reset) then
       lastpat=-1
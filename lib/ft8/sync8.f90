@@ -1,15 +1,12 @@
 subroutine sync8(dd,npts,nfa,nfb,syncmin,nfqso,maxcand,candidate,ncand,sbase)
 
+  use ft8_spectrogram, only: s=>s8, spectrogram_update
   include 'ft8_params.f90'
   parameter (MAXPRECAND=1000)
 ! Maximum sync correlation lag +/- 2.5s relative to 0.5s TX start time. 
 ! 2.5s / 0.16s/symbol * 4 samples/symbol = 62.5 lag steps in 2.5s
   parameter (JZ=62)                        
-  complex cx(0:NH1)
-  real s(NH1,NHSYM)
-  real savg(NH1)
   real sbase(NH1)
-  real x(NFFT1+2)
   real sync2d(NH1,-JZ:JZ)
   real red(NH1)
   real red2(NH1)
@@ -23,24 +20,13 @@ subroutine sync8(dd,npts,nfa,nfb,syncmin,nfqso,maxcand,candidate,ncand,sbase)
   integer ii(1)
   integer icos7(0:6)
   data icos7/3,1,4,0,6,5,2/                   !Costas 7x7 tone pattern
-  equivalence (x,cx)
 
-! Compute symbol spectra, stepping by NSTEP steps.  
-  savg=0.
+! Symbol spectra, stepping by NSTEP steps, come from the slot's
+! spectrogram which only recomputes what has changed since the last
+! pass.
   tstep=NSTEP/12000.0                         
   df=12000.0/NFFT1                            !3.125 Hz
-  fac=1.0/300.0
-  do j=1,NHSYM
-     ia=(j-1)*NSTEP + 1
-     ib=ia+NSPS-1
-     x(1:NSPS)=fac*dd(ia:ib)
-     x(NSPS+1:)=0.
-     call four2a(x,NFFT1,1,-1,0)              !r2c FFT
-     do i=1,NH1
-        s(i,j)=real(cx(i))**2 + aimag(cx(i))**2
-     enddo
-     savg=savg + s(1:NH1,j)                   !Average spectrum
-  enddo
+  call spectrogram_update(dd)
   call get_spectrum_baseline(dd,nfa,nfb,sbase)
 
   ia=max(1,nint(nfa/df))
@@ -147,9 +133,6 @@ subroutine sync8(dd,npts,nfa,nfb,syncmin,nfqso,maxcand,candidate,ncand,sbase)
         enddo
      endif
   enddo
-  fac=20.0/maxval(s)
-  s=fac*s
-
 ! Sort by sync
   call indexx(candidate0(3,1:ncand),ncand,indx)
 ! Place candidates within 10 Hz of nfqso at the top of the list
@@ -21,11 +21,15 @@
 #include "char.h"
 #endif
 
-int DECODE_RS(
+/* As DECODE_RS but with the syndrome poly in caller supplied storage
+ * s[NROOTS], so that several threads can run trials against the same
+ * syndromes; with calc_syn=0 s[] is only read.
+ */
+int DECODE_RS_SYN(
 #ifndef FIXED
               void *p,
 #endif
-              DTYPE *data, int *eras_pos, int no_eras, int calc_syn){
+              DTYPE *data, int *eras_pos, int no_eras, DTYPE *s, int calc_syn){
     
 #ifndef FIXED
     struct rs *rs = (struct rs *)p;
@@ -34,7 +38,6 @@ int DECODE_RS(
     int i, j, r,k;
     DTYPE u,q,tmp,num1,num2,den,discr_r;
     DTYPE lambda[NROOTS+1];	// Err+Eras Locator poly
-    static DTYPE s[51];					 // and syndrome poly
     DTYPE b[NROOTS+1], t[NROOTS+1], omega[NROOTS+1];
     DTYPE root[NROOTS], reg[NROOTS+1], loc[NROOTS];
     int syn_error, count;
@@ -266,3 +269,16 @@ finish:
     }
     return count;
 }
+
+int DECODE_RS(
+#ifndef FIXED
+              void *p,
+#endif
+              DTYPE *data, int *eras_pos, int no_eras, int calc_syn){
+    static DTYPE s[51];					 // syndrome poly
+    return DECODE_RS_SYN(
+#ifndef FIXED
+                         p,
+#endif
+                         data, eras_pos, no_eras, s, calc_syn);
+}
@@ -20,9 +20,7 @@
 #include <time.h>
 #include <string.h>
 #include "rs2.h"
-
-static void *rs;
-void getpp_(int workdat[], float *pp);
+#include "ftrsd_trials.h"
 
 void ftrsd2_(int mrsym[], int mrprob[], int mr2sym[], int mr2prob[], 
 	     int* ntrials0, int correct[], int param[], int ntry[])
@@ -31,13 +29,13 @@ void ftrsd2_(int mrsym[], int mrprob[], int mr2sym[], int mr2prob[],
   int workdat[63];
   int indexes[63];
   int era_pos[51];
+  int syn[51];
   int i, j, numera, nerr, nn=63;
   int ntrials = *ntrials0;
-  int nhard=0,nhard_min=32768,nsoft=0,nsoft_min=32768;
-  int ntotal=0,ntotal_min=32768,ncandidates;
-  int nera_best=0;
-  float pp,pp1,pp2;
-  static unsigned int nseed;
+  int nhard=0;
+  void *rs;
+  struct ftrsd_received rx;
+  struct ftrsd_best best;
 
 // Power-percentage symbol metrics - composite gnnf/hf 
   int perr[8][8] = {
@@ -52,8 +50,7 @@ void ftrsd2_(int mrsym[], int mrprob[], int mr2sym[], int mr2prob[],
 
     
 // Initialize the KA9Q Reed-Solomon encoder/decoder
-  unsigned int symsize=6, gfpoly=0x43, fcr=3, prim=1, nroots=51;
-  rs=init_rs_int(symsize, gfpoly, fcr, prim, nroots, 0);
+  rs=ftrsd_rs();
 
 // Reverse the received symbol vectors for BM decoder
   for (i=0; i<63; i++) {
@@ -87,7 +84,7 @@ void ftrsd2_(int mrsym[], int mrprob[], int mr2sym[], int mr2prob[],
   memset(era_pos,0,51*sizeof(int));
   numera=0;
   memcpy(workdat,rxdat,sizeof(rxdat));
-  nerr=decode_rs_int(rs,workdat,era_pos,numera,1);
+  nerr=decode_rs_syn_int(rs,workdat,era_pos,numera,syn,1);
   if( nerr >= 0 ) {
     // Hard-decision decoding succeeded.  Save codeword and some parameters.
     nhard=0;
@@ -117,11 +114,9 @@ symbol spectra, and using these to decide which candidate
 codeword is "best".
 */
 
-  nseed=1;                                 //Seed for random numbers
   float ratio;
-  int thresh, nsum;
+  int nsum;
   int thresh0[63];
-  ncandidates=0;
   nsum=0;
   int ii,jj;
   for (i=0; i<nn; i++) {
@@ -134,80 +129,33 @@ codeword is "best".
   }
   if(nsum<=0) return;
 
-  pp1=0.0;
-  pp2=0.0;
-  for (k=1; k<=ntrials; k++) {
-    memset(era_pos,0,51*sizeof(int));
-    memcpy(workdat,rxdat,sizeof(rxdat));
-
-/* 
-Mark a subset of the symbols as erasures.
-Run through the ranked symbols, starting with the worst, i=0.
-NB: j is the symbol-vector index of the symbol with rank i.
-*/
-    numera=0;
-    for (i=0; i<nn; i++) {
-      j = indexes[62-i];
-      thresh=thresh0[i];
-      long int ir;
-
-// Generate a random number ir, 0 <= ir < 100 (see POSIX.1-2001 example).
-      nseed = nseed * 1103515245 + 12345;
-      ir = (unsigned)(nseed/65536) % 32768;
-      ir = (100*ir)/32768;
-
-      if((ir < thresh ) && numera < 51) {
-        era_pos[numera]=j;
-        numera=numera+1;
-      }
-    }
-
-    nerr=decode_rs_int(rs,workdat,era_pos,numera,0);        
-    if( nerr >= 0 ) {
-      // We have a candidate codeword.  Find its hard and soft distance from
-      // the received word.  Also find pp1 and pp2 from the full array 
-      // s3(64,63) of synchronized symbol spectra.
-      ncandidates=ncandidates+1;
-      nhard=0;
-      nsoft=0;
-      for (i=0; i<63; i++) {
-        if(workdat[i] != rxdat[i]) {
-          nhard=nhard+1;
-          if(workdat[i] != rxdat2[i]) {
-            nsoft=nsoft+rxprob[i];
-          }
-        }
-      }
-      nsoft=63*nsoft/nsum;
-      ntotal=nsoft+nhard;
-
-      getpp_(workdat,&pp);
-      if(pp>pp1) {
-        pp2=pp1;
-        pp1=pp;
-        nsoft_min=nsoft;
-        nhard_min=nhard;
-        ntotal_min=ntotal;
-        memcpy(correct,workdat,63*sizeof(int));
-        nera_best=numera;
-        ntry[0]=k;
-      } else {
-        if(pp>pp2 && pp!=pp1) pp2=pp;
-      }
-      if(nhard_min <= 41 && ntotal_min <= 71) break;
-    }
-    if(k == ntrials) ntry[0]=k;
-  }
+  best.ncandidates=0;
+  best.nhard_min=32768;
+  best.nsoft_min=32768;
+  best.ntotal_min=32768;
+  best.nera_best=0;
+  best.ntry=ntry[0];
+  best.pp1=0.0;
+  best.pp2=0.0;
+  rx.rxdat=rxdat;
+  rx.rxdat2=rxdat2;
+  rx.rxprob=rxprob;
+  rx.indexes=indexes;
+  rx.thresh0=thresh0;
+  rx.syn=syn;
+  rx.nsum=nsum;
+  ftrsd_trials(rs,&rx,ntrials,correct,&best);
+  ntry[0]=best.ntry;
   
-  param[0]=ncandidates;
-  param[1]=nhard_min;
-  param[2]=nsoft_min;
-  param[3]=nera_best;
-  param[4]= pp1 > 0 ? 1000.0*pp2/pp1 : 1000.0;
-  param[5]=ntotal_min;
+  param[0]=best.ncandidates;
+  param[1]=best.nhard_min;
+  param[2]=best.nsoft_min;
+  param[3]=best.nera_best;
+  param[4]= best.pp1 > 0 ? 1000.0*best.pp2/best.pp1 : 1000.0;
+  param[5]=best.ntotal_min;
   param[6]=ntry[0];
-  param[7]=1000.0*pp2;
-  param[8]=1000.0*pp1;
+  param[7]=1000.0*best.pp2;
+  param[8]=1000.0*best.pp1;
   if(param[0]==0) param[2]=-1;
   return;
 }
@@ -0,0 +1,215 @@
+/*
+ ftrsd_trials.c
+
+ The random erasure trials of the FT soft-decision decoder, run in
+ parallel when built with OpenMP.
+
+ Trials are farmed out in batches.  Each trial regenerates its own
+ stretch of the serial random number sequence, so a trial's erasure
+ pattern does not depend on which thread runs it, and the BM decoder
+ reads the syndromes computed by the hard-decision attempt from the
+ caller rather than from its own static copy.  Finished trials are
+ then merged in trial order exactly as the serial loop would have
+ handled them, including the early exit once a good enough best
+ candidate is found.
+
+ While a batch runs, a trial whose candidate beats the best so far
+ and passes the early exit test marks the trials after it as not
+ needed.  If the merge finds that candidate was not the best after
+ all the next batch simply starts from the first trial skipped.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "rs2.h"
+#include "ftrsd_trials.h"
+
+void getpp_(int workdat[], float *pp);
+
+#define TRIALS_PER_THREAD 16
+#define NHARD_DONE 41                      // early exit thresholds
+#define NTOTAL_DONE 71
+
+struct trial {
+  int state;                               // 0=not run, 1=failed, 2=candidate
+  int numera;
+  int nhard;
+  int nsoft;
+  int ntotal;
+  float pp;
+  int workdat[63];
+};
+
+void *ftrsd_rs(void)
+{
+  static void *rs;
+  void *p;
+
+#pragma omp critical(ftrsd_rs)
+  {
+    if(!rs) rs=init_rs_int(6, 0x43, 3, 1, 51, 0);
+    p=rs;
+  }
+  return p;
+}
+
+// The seed trial k (1, 2, ...) starts from: the serial generator is
+// advanced 63 times per trial, so jump ahead 63*(k-1) steps.
+static unsigned int trial_seed(int k)
+{
+  unsigned int a=1103515245, c=12345;      // one step x -> a*x + c
+  unsigned int a63=1, c63=0;               // 63 steps
+  unsigned int aj=1, cj=0;                 // 63*(k-1) steps
+  unsigned int n;
+  int i;
+
+  for (i=0; i<63; i++) {
+    c63=a*c63 + c;
+    a63=a*a63;
+  }
+  for (n=k-1; n; n>>=1) {
+    if(n & 1) {
+      cj=a63*cj + c63;
+      aj=a63*aj;
+    }
+    c63=a63*c63 + c63;
+    a63=a63*a63;
+  }
+  return aj*1 + cj;
+}
+
+static void run_trial(void *rs, struct ftrsd_received const *rx, int k,
+                      struct trial *t)
+{
+  int era_pos[51];
+  int i, j, nerr, numera=0, nhard=0, nsoft=0;
+  unsigned int nseed=trial_seed(k);
+  long int ir;
+
+  memset(era_pos,0,51*sizeof(int));
+  memcpy(t->workdat,rx->rxdat,63*sizeof(int));
+
+/*
+Mark a subset of the symbols as erasures.
+Run through the ranked symbols, starting with the worst, i=0.
+NB: j is the symbol-vector index of the symbol with rank i.
+*/
+  for (i=0; i<63; i++) {
+    j = rx->indexes[62-i];
+
+// Generate a random number ir, 0 <= ir < 100 (see POSIX.1-2001 example).
+    nseed = nseed * 1103515245 + 12345;
+    ir = (unsigned)(nseed/65536) % 32768;
+    ir = (100*ir)/32768;
+
+    if((ir < rx->thresh0[i]) && numera < 51) {
+      era_pos[numera]=j;
+      numera=numera+1;
+    }
+  }
+
+  nerr=decode_rs_syn_int(rs,t->workdat,era_pos,numera,(int *)rx->syn,0);
+  if( nerr < 0 ) {
+    t->state=1;
+    return;
+  }
+
+  // We have a candidate codeword.  Find its hard and soft distance from
+  // the received word.  Also find pp from the full array s3(64,63) of
+  // synchronized symbol spectra.
+  for (i=0; i<63; i++) {
+    if(t->workdat[i] != rx->rxdat[i]) {
+      nhard=nhard+1;
+      if(t->workdat[i] != rx->rxdat2[i]) {
+        nsoft=nsoft+rx->rxprob[i];
+      }
+    }
+  }
+  nsoft=63*nsoft/rx->nsum;
+  t->numera=numera;
+  t->nhard=nhard;
+  t->nsoft=nsoft;
+  t->ntotal=nsoft+nhard;
+  getpp_(t->workdat,&t->pp);
+  t->state=2;
+}
+
+void ftrsd_trials(void *rs, struct ftrsd_received const *rx, int ntrials,
+                  int correct[], struct ftrsd_best *best)
+{
+  struct trial *batch;
+  int nthreads=1, nbatch, n, m, k, k0, stop, done=0;
+  float pp1;
+
+#ifdef _OPENMP
+  if(!omp_in_parallel()) nthreads=omp_get_max_threads();
+#endif
+  nbatch=TRIALS_PER_THREAD*nthreads;
+  if(nbatch > ntrials) nbatch=ntrials;
+  if(nbatch < 1) return;
+  batch=(struct trial *)malloc(nbatch*sizeof(struct trial));
+  if(!batch) return;
+
+  k0=1;
+  while(!done && k0<=ntrials) {
+    n=ntrials-k0+1;
+    if(n > nbatch) n=nbatch;
+    stop=k0+n;                             // first trial not needed
+    pp1=best->pp1;
+
+#pragma omp parallel for schedule(dynamic,1) if(nthreads>1 && n>1)
+    for (m=0; m<n; m++) {
+      struct trial *t=&batch[m];
+      int kk=k0+m, kstop;
+
+      t->state=0;
+#pragma omp atomic read
+      kstop=stop;
+      if(kk >= kstop) continue;
+      run_trial(rs,rx,kk,t);
+      if(t->state==2 && t->pp>pp1 && t->nhard<=NHARD_DONE
+         && t->ntotal<=NTOTAL_DONE) {
+#pragma omp critical(ftrsd_stop)
+        {
+          if(kk+1 < stop) {
+#pragma omp atomic write
+            stop=kk+1;
+          }
+        }
+      }
+    }
+
+// Merge in trial order, as the serial loop would have
+    for (m=0; m<n; m++) {
+      struct trial const *t=&batch[m];
+      k=k0+m;
+      if(t->state==0) break;               // skipped, rerun from here
+      if(t->state==2) {
+        best->ncandidates=best->ncandidates+1;
+        if(t->pp>best->pp1) {
+          best->pp2=best->pp1;
+          best->pp1=t->pp;
+          best->nsoft_min=t->nsoft;
+          best->nhard_min=t->nhard;
+          best->ntotal_min=t->ntotal;
+          memcpy(correct,t->workdat,63*sizeof(int));
+          best->nera_best=t->numera;
+          best->ntry=k;
+        } else {
+          if(t->pp>best->pp2 && t->pp!=best->pp1) best->pp2=t->pp;
+        }
+        if(best->nhard_min <= NHARD_DONE && best->ntotal_min <= NTOTAL_DONE) {
+          done=1;
+          break;
+        }
+      }
+      if(k == ntrials) best->ntry=k;
+    }
+    k0=k0+m;
+  }
+
+  free(batch);
+}
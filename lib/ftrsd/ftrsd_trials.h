@@ -0,0 +1,42 @@
+/*
+ ftrsd_trials.h
+
+ The random erasure trials of the FT soft-decision Reed-Solomon
+ decoder, shared by ftrsd2.c and ftrsdap.c.
+ */
+
+#ifndef FTRSD_TRIALS_H
+#define FTRSD_TRIALS_H
+
+struct ftrsd_received {
+  int const *rxdat;       /* most reliable symbols, BM decoder order */
+  int const *rxdat2;      /* second most reliable symbols */
+  int const *rxprob;      /* reliability of rxdat */
+  int const *indexes;     /* symbol indexes by decreasing reliability */
+  int const *thresh0;     /* erasure probability (%) by rank, worst first */
+  int const *syn;         /* syndromes of rxdat from the HDD attempt */
+  int nsum;               /* sum of rxprob */
+};
+
+struct ftrsd_best {
+  int ncandidates;
+  int nhard_min;
+  int nsoft_min;
+  int ntotal_min;
+  int nera_best;
+  int ntry;
+  float pp1;
+  float pp2;
+};
+
+/* The shared (63,12) RS codec, created on first use */
+void *ftrsd_rs(void);
+
+/* Run up to ntrials erasure trials, the best candidate codeword goes
+   to correct[] and its figures to best.  The result is the same as
+   running the trials one after another with the usual seed, whatever
+   the number of threads. */
+void ftrsd_trials(void *rs, struct ftrsd_received const *rx, int ntrials,
+                  int correct[], struct ftrsd_best *best);
+
+#endif
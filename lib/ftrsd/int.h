@@ -40,11 +40,13 @@ static inline int modnn(struct rs *rs,int x){
 
 #define ENCODE_RS encode_rs_int
 #define DECODE_RS decode_rs_int
+#define DECODE_RS_SYN decode_rs_syn_int
 #define INIT_RS init_rs_int
 #define FREE_RS free_rs_int
 
 void ENCODE_RS(void *p,DTYPE *data,DTYPE *parity);
 int DECODE_RS(void *p,DTYPE *data,int *eras_pos,int no_eras, int calc_syn);
+int DECODE_RS_SYN(void *p,DTYPE *data,int *eras_pos,int no_eras, DTYPE *s, int calc_syn);
 void *INIT_RS(unsigned int symsize,unsigned int gfpoly,unsigned int fcr,
 		   unsigned int prim,unsigned int nroots);
 void FREE_RS(void *p);
@@ -6,6 +6,7 @@
 /* General purpose RS codec, integer symbols */
 void encode_rs_int(void *rs,int *data,int *parity);
 int decode_rs_int(void *rs,int *data,int *eras_pos,int no_eras, int calc_syn);
+int decode_rs_syn_int(void *rs,int *data,int *eras_pos,int no_eras, int *s, int calc_syn);
 void *init_rs_int(int symsize,int gfpoly,int fcr,
 		  int prim,int nroots,int pad);
 void free_rs_int(void *rs);
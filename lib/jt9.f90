@@ -20,7 +20,6 @@ program jt9
   real*8 TRperiod
   character c
   character(len=500) optarg, infile
-  character wisfile*256
 !### ndepth was defined as 60001.  Why???
   integer :: arglen,stat,offset,remain,mode=0,flow=200,fsplit=2700,          &
        fhigh=4000,nrxfreq=1500,ndepth=1,nexp_decode=0,nQSOProg=0
@@ -85,7 +84,7 @@ program jt9
   character(len=6) :: mygrid='', hisgrid='EN37'
   common/patience/npatience,nthreads
   common/decstats/ntry65a,ntry65b,n65a,n65b,num9,numfano
-  data npatience/1/,nthreads/1/,wisfile/' '/
+  data npatience/1/,nthreads/1/
 
   nsubmode = 0
   ntol = 20
@@ -193,9 +192,9 @@ program jt9
 ! Default to 1 thread, but use nthreads for the big ones
   call fftwf_plan_with_nthreads(1)
 
-! Import FFTW wisdom, if available
-  wisfile=trim(data_dir)//'/jt9_wisdom.dat'// C_NULL_CHAR
-  iret=fftwf_import_wisdom_from_filename(wisfile)
+! Import FFTW wisdom, if available, and plan the FFTs used last time
+! on a background thread
+  call fftw_prewarm_start(trim(data_dir),npatience,nthreads)
 
   ntry65a=0
   ntry65b=0
@@ -373,7 +372,7 @@ program jt9
 ! Output decoder statistics
   call fini_timer ()
 ! Save FFTW wisdom and free memory
-  if(len(trim(wisfile)).gt.0) iret=fftwf_export_wisdom_to_filename(wisfile)
+  call fftw_prewarm_finish()
   call four2a(a,-1,1,1,1)
   call filbig(a,-1,1,0.0,0,0,0,0,0)        !used for FFT plans
   call fftwf_cleanup_threads()
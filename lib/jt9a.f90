@@ -54,6 +54,7 @@ subroutine jt9a()
   ok=shmem_unlock()
   if(.not.ok) call abort
   call flush(6)
+  call fftw_prewarm_mode(local_params%nmode,local_params%ntr)
   call timer('decoder ',0)
   if(local_params%nmode.eq.8 .and. local_params%ndiskdat .and.    &
        .not. local_params%nagain) then
@@ -80,6 +81,7 @@ subroutine jt9a()
   endif
 
   call timer('decoder ',1)
+  call fftw_prewarm_decoded()
 
 
 ! Wait here until GUI routine decodeDone() has set ipc(3) to 1
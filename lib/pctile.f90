@@ -1,21 +1,16 @@
 subroutine pctile(x,npts,npct,xpct)
 
+  use percentile
   real x(npts)
-  real,allocatable :: tmp(:)
 
-  if(npts.lt.0 .or. npct.lt.0 .or. npct.gt.100) then
+  if(npts.lt.1 .or. npct.lt.0 .or. npct.gt.100) then
      xpct=1.0
      go to 900
   endif
-  allocate(tmp(npts))
 
-  tmp=x
-  call shell(npts,tmp)
-  j=nint(npts*0.01*npct)
-  if(j.lt.1) j=1
-  if(j.gt.npts) j=npts
-  xpct=tmp(j)
-  deallocate(tmp)
+  call reserve(npts)
+  work(1:npts)=x
+  xpct=select_kth(work,npts,pctile_index(npts,npct))
 
 900 return
 end subroutine pctile
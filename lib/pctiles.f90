@@ -0,0 +1,45 @@
+subroutine pctiles(x,npts,npct,nq,xpct)
+
+! Several percentiles of x(1:npts) in one pass, xpct(i) is what
+! pctile(x,npts,npct(i),xpct(i)) would return.  Each selection leaves
+! the workspace partitioned so the next, higher, rank only has to
+! search above the last one.
+
+  use percentile
+  real x(npts)
+  integer npct(nq)
+  real xpct(nq)
+  integer iord(nq)
+
+  call reserve(npts)
+  if(npts.ge.1) work(1:npts)=x
+
+! Order the requests by rank
+  do i=1,nq
+     iord(i)=i
+  enddo
+  do i=2,nq
+     n=iord(i)
+     j=i-1
+     do while(j.ge.1)
+        if(npct(iord(j)).le.npct(n)) exit
+        iord(j+1)=iord(j)
+        j=j-1
+     enddo
+     iord(j+1)=n
+  enddo
+
+  lo=1
+  do i=1,nq
+     n=iord(i)
+     if(npts.lt.1 .or. npct(n).lt.0 .or. npct(n).gt.100) then
+        xpct(n)=1.0
+        cycle
+     endif
+     k=pctile_index(npts,npct(n))
+     xpct(n)=select_kth(work(lo),npts-lo+1,k-lo+1)
+     lo=k
+  enddo
+
+  return
+end subroutine pctiles
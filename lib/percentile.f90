@@ -0,0 +1,114 @@
+module percentile
+
+! Percentiles by selection rather than sorting.  select_kth() is an
+! introselect: quickselect with median of three pivots, falling back
+! to a Shell sort of what remains if partitioning goes badly, so the
+! expected cost is O(n) and the worst case that of shell().
+!
+! The copy of the input that pctile() and friends partition lives in
+! a per thread workspace that only grows, so there is no allocation
+! per call in the steady state.
+
+  real, allocatable, save :: work(:)
+!$omp threadprivate(work)
+
+contains
+
+subroutine reserve(n)
+
+! Make sure the workspace holds at least n points
+  integer n
+
+  if(allocated(work)) then
+     if(size(work).ge.n) return
+     deallocate(work)
+  endif
+  allocate(work(max(n,4096)))
+
+  return
+end subroutine reserve
+
+integer function pctile_index(npts,npct)
+
+! The 1-based rank pctile() has always used
+  integer npts,npct
+
+  pctile_index=nint(npts*0.01*npct)
+  if(pctile_index.lt.1) pctile_index=1
+  if(pctile_index.gt.npts) pctile_index=npts
+
+  return
+end function pctile_index
+
+real function select_kth(a,n,k)
+
+! Return the k'th smallest of a(1:n).  On return a(1:n) is reordered
+! such that a(1:k-1) <= a(k) <= a(k+1:n).
+  integer n,k
+  real a(n)
+  real pivot,t
+
+  l=1
+  ir=n
+  maxdepth=2*ceiling(log(real(max(n,2)))/log(2.0))
+  ndepth=0
+  do while(ir-l.gt.16)
+     ndepth=ndepth+1
+     if(ndepth.gt.maxdepth) then            !Degenerate partitions, give up
+        call shell(ir-l+1,a(l))
+        select_kth=a(k)
+        return
+     endif
+     m=(l+ir)/2                              !Median of three to a(m)
+     if(a(m).lt.a(l)) then
+        t=a(m); a(m)=a(l); a(l)=t
+     endif
+     if(a(ir).lt.a(l)) then
+        t=a(ir); a(ir)=a(l); a(l)=t
+     endif
+     if(a(ir).lt.a(m)) then
+        t=a(ir); a(ir)=a(m); a(m)=t
+     endif
+     pivot=a(m)
+     i=l
+     j=ir
+     do                                      !Hoare partition
+        do while(a(i).lt.pivot)
+           i=i+1
+        enddo
+        do while(a(j).gt.pivot)
+           j=j-1
+        enddo
+        if(i.le.j) then
+           t=a(i); a(i)=a(j); a(j)=t
+           i=i+1
+           j=j-1
+        endif
+        if(i.gt.j) exit
+     enddo
+     if(k.le.j) then
+        ir=j
+     else if(k.ge.i) then
+        l=i
+     else                                    !a(j+1:i-1) all equal pivot
+        select_kth=a(k)
+        return
+     endif
+  enddo
+
+  do i=l+1,ir                                !Insertion sort the rest
+     t=a(i)
+     j=i-1
+     do while(j.ge.l)
+        if(a(j).le.t) exit
+        a(j+1)=a(j)
+        j=j-1
+     enddo
+     a(j+1)=t
+  enddo
+  select_kth=a(k)
+
+  return
+end function select_kth
+
+end module percentile
@@ -3,6 +3,7 @@ module q65_decode
   integer nsnr0,nfreq0
   real xdt0
   character msg0*37,cq0*3
+!$omp threadprivate(nsnr0,nfreq0,xdt0,msg0,cq0)
 
   type :: q65_decoder
      procedure(q65_decode_callback), pointer :: callback
@@ -110,10 +111,13 @@ contains
     npasses=1
     nhist2=0
     if(lagain) ndepth=ior(ndepth,3)       !Use 'Deep' for manual Q65 decodes
+!$omp critical(pack77)
     dxcall13=hiscall  ! initialize for use in packjt77
     mycall13=mycall
+!$omp end critical(pack77)
     if(ncontest.eq.1) then
 ! NA VHF, WW-Digi, or ARRL Digi Contest
+!$omp critical(q65_hist)
        open(24,file=trim(data_dir)//'/tsil.3q',status='unknown',     &
             form='unformatted')
        read(24,end=2) nhist2
@@ -131,6 +135,7 @@ contains
           nhist2=0
        endif
 2      close(24)
+!$omp end critical(q65_hist)
     endif
 
 ! Determine the T/R sequence: iseq=0 (even), or iseq=1 (odd)
@@ -147,7 +152,9 @@ contains
     allocate (c0(0:nfft1-1))
 
     if(lagain) then
+!$omp critical(q65_hist)
        call q65_hist(nfqso,dxcall=hiscall,dxgrid=hisgrid)
+!$omp end critical(q65_hist)
     endif
 
     nsps=1800
@@ -188,6 +195,7 @@ contains
     if(ichar(hiscall(1:1)).eq.0) hiscall=' '
     if(ichar(hisgrid(1:1)).eq.0) hisgrid=' '
     ncw=0
+!$omp critical(pack77)
     if(nqd.eq.1 .or. lagain .or. ncontest.eq.1) then
        if(ncontest.eq.1) then
           call q65_set_list2(mycall,hiscall,hisgrid,callers,nhist2,   &
@@ -203,6 +211,7 @@ contains
 
 ! W3SZ patch: Initialize AP params here, rather than afer the call to ana64().
     call ft8apset(mycall,hiscall,ncontest,apsym0,aph10) ! Generate ap symbols
+!$omp end critical(pack77)
     where(apsym0.eq.-1) apsym0=0
     npasses=2
     if(nQSOprogress.eq.5) npasses=3
@@ -316,7 +325,9 @@ contains
 ! Unpack decoded message for display to user
        write(c77,1000) dat4(1:12),dat4(13)/2
 1000   format(12b6.6,b5.5)
+!$omp critical(pack77)
        call unpack77(c77,1,decoded,unpk77_success) !Unpack to get decoded
+!$omp end critical(pack77)
        idupe=0
        do i=1,ndecodes
           if(decodes(i).eq.decoded) idupe=1
@@ -330,14 +341,17 @@ contains
           nsnr=nint(snr2)
           call this%callback(nutc,snr1,nsnr,dtdec,f0dec,decoded,    &
                idec,nused,ntrperiod)
+!$omp critical(q65_hist)
           if(ncontest.eq.1) then
              call q65_hist2(nint(f0dec),decoded,callers,nhist2)
           else
              call q65_hist(nint(f0dec),msg0=decoded)
           endif
+!$omp end critical(q65_hist)
           if(iand(ndepth,128).ne.0 .and. .not.lagain .and.      &
                int(abs(f0dec-nfqso)).le.ntol ) call q65_clravg    !AutoClrAvg
           call sec0(1,tdecode)
+!$omp critical(q65_decodes)
           open(22,file=trim(data_dir)//'/q65_decodes.txt',status='unknown',  &
                position='append',iostat=ios)
           if(ios.eq.0) then
@@ -357,6 +371,7 @@ contains
                   f0,snr2,plog,tdecode,mycall(1:6),c6,c4,trim(decoded)
              close(22)
           endif
+!$omp end critical(q65_decodes)
        endif
     endif
     navg0=1000*navg(0) + navg(1)
@@ -391,7 +406,9 @@ contains
        if(ntrperiod.le.30) jpk0=(xdt+0.5)*6000  !For shortest sequences
        if(jpk0.lt.0) jpk0=0
        call ana64(iwave,npts,c00)       !Convert to complex c00() at 6000 Sa/s
+!$omp critical(pack77)
        call ft8apset(mycall,hiscall,ncontest,apsym0,aph10) ! Generate ap symbols
+!$omp end critical(pack77)
        where(apsym0.eq.-1) apsym0=0
 
        npasses=2
@@ -429,7 +446,9 @@ contains
        if(idec.ge.0) then
 ! Unpack decoded message for display to user
           write(c77,1000) dat4(1:12),dat4(13)/2
+!$omp critical(pack77)
           call unpack77(c77,1,decoded,unpk77_success) !Unpack to get decoded
+!$omp end critical(pack77)
           idupe=0
           do i=1,ndecodes
              if(decodes(i).eq.decoded) idupe=1
@@ -442,14 +461,17 @@ contains
              nsnr=nint(snr2)
              call this%callback(nutc,snr1,nsnr,dtdec,f0dec,decoded,    &
                   idec,nused,ntrperiod)
+!$omp critical(q65_hist)
              if(ncontest.eq.1) then
                 call q65_hist2(nint(f0dec),decoded,callers,nhist2)
              else
                 call q65_hist(nint(f0dec),msg0=decoded)
              endif
+!$omp end critical(q65_hist)
              if(iand(ndepth,128).ne.0 .and. .not.lagain .and.      &
                   int(abs(f0dec-nfqso)).le.ntol ) call q65_clravg    !AutoClrAvg
              call sec0(1,tdecode)
+!$omp critical(q65_decodes)
              ios=1
              open(22,file=trim(data_dir)//'/q65_decodes.txt',status='unknown',&
                   position='append',iostat=ios)
@@ -471,6 +493,7 @@ contains
                      trim(decoded)
                 close(22)
              endif
+!$omp end critical(q65_decodes)
           endif
        endif
 800    continue
@@ -24,6 +24,14 @@ module q65
   real, allocatable,save :: ccf2_avg(:)  !Like ccf2, but for avg (red curve)
   real sync(85)                          !sync vector
   real df,dtstep,dtdec,f0dec,ftol,plog,drift
+! Each thread decoding Q65 signals, e.g. QMAP candidates, has its own
+! copy of the decoder state.
+!$omp threadprivate(iz0,jz0,apsym0,aph10,apmask1,apsymbols1,apmask,       &
+!$omp    apsymbols,codewords,ibwa,ibwb,ncw,nsps,mode_q65,nfa,nfb,nqd,      &
+!$omp    idfbest,idtbest,ibw,ndistbest,maxiters,max_drift,istep,nsmo,      &
+!$omp    lag1,lag2,npasses,iseq,ncand,nrc,i0,j0,navg,lnewdat,candidates,   &
+!$omp    s1,s1w,s1a,ccf2,ccf2_avg,sync,df,dtstep,dtdec,f0dec,ftol,plog,    &
+!$omp    drift)
 
 contains
 
@@ -67,6 +75,7 @@ subroutine q65_dec0(iavg,iwave,ntrperiod,nfqso,ntol,lclearave,  &
   real, allocatable :: ccf1(:)           !CCF(freq) at fixed lag (red)
   data first/.true./
   save first,LL0
+!$omp threadprivate(first,LL0)
 
   integer w3t
   integer w3f
@@ -475,6 +484,7 @@ subroutine q65_ccf_22(s1,iz,jz,nfqso,ntol,iavg,ipk,jpk,  &
   real s1(iz,jz)
   real ccf2(iz)                               !Orange sync curve
   real tmp(20,3)
+  real xq(2)
   real, allocatable :: xdt2(:)
   real, allocatable :: s1avg(:)
   integer, allocatable :: indx(:)
@@ -550,8 +560,9 @@ subroutine q65_ccf_22(s1,iz,jz,nfqso,ntol,iavg,ipk,jpk,  &
   jzz=ib-ia+1
   call indexx(ccf2(ia:ib),jzz,indx)
 
-  call pctile(ccf2(ia:ib),jzz,50,ave)
-  call pctile(ccf2(ia:ib),jzz,84,base)
+  call pctiles(ccf2(ia:ib),jzz,(/50,84/),2,xq)
+  ave=xq(1)
+  base=xq(2)
   rms=base-ave
   ncand=0
   maxcand=20
@@ -603,7 +614,9 @@ subroutine q65_dec1(s3,nsubmode,b90ts,esnodb,irc,dat4,decoded)
   if(irc.ge.0 .and. plog.gt.PLOG_MIN) then
      write(c77,1000) dat4(1:12),dat4(13)/2
 1000 format(12b6.6,b5.5)
+!$omp critical(pack77)
      call unpack77(c77,0,decoded,unpk77_success) !Unpack to get msgsent
+!$omp end critical(pack77)
   else
      irc=-1
   endif
@@ -632,7 +645,9 @@ subroutine q65_dec2(s3,nsubmode,b90ts,esnodb,irc,dat4,decoded)
   if(irc.ge.0) then
      write(c77,1000) dat4(1:12),dat4(13)/2
 1000 format(12b6.6,b5.5)
+!$omp critical(pack77)
      call unpack77(c77,0,decoded,unpk77_success) !Unpack to get msgsent
+!$omp end critical(pack77)
   endif
 
   return
@@ -682,6 +697,7 @@ subroutine q65_write_red(iz,xdt,ccf2_avg,ccf2)
   g=0.4
   g_avg=0.
   if(navg(iseq).ge.2) g_avg=g
+!$omp critical(q65_write_red)
   rewind 17
   write(17,1000) xdt,g_avg*minval(ccf2_avg),g_avg*maxval(ccf2_avg)
   do i=i1,i2
@@ -692,6 +708,7 @@ subroutine q65_write_red(iz,xdt,ccf2_avg,ccf2)
 1000 format(f10.3,2f15.6)
   enddo
   flush(17)
+!$omp end critical(q65_write_red)
 
   return
 end subroutine q65_write_red
@@ -40,6 +40,9 @@
 #define Q65_FASTFADING_MAXWEIGTHS 65
 
 extern float q65_llh;
+#ifdef _OPENMP
+#pragma omp threadprivate(q65_llh)
+#endif
 
 typedef struct {
 	const qracode *pQraCode; // qra code to be used by the codec
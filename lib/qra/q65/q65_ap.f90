@@ -18,6 +18,7 @@ subroutine q65_ap(nQSOprogress,ipass,ncontest,lapcqonly,iaptype,   &
   data ncontest0/99/
   data first/.true./
   save naptypes,ncontest0
+!$omp threadprivate(naptypes,ncontest0,first)
 
 ! nQSOprogress
 !   0  CALLING
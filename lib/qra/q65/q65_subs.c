@@ -27,21 +27,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+// The codec holds the decoder's working storage, so each thread that
+// decodes has its own.
 static q65_codec_ds codec;
+static int codec_ready;
+#ifdef _OPENMP
+#pragma omp threadprivate(codec,codec_ready)
+#endif
 
-void q65_enc_(int x[], int y[])
+static void q65_codec_init(void)
 {
-
-  static int first=1;
-  if (first) {
+  if (!codec_ready) {
     // Set the QRA code, allocate memory, and initialize
     int rc = q65_init(&codec,&qra15_65_64_irr_e23);
     if (rc<0) {
       printf("error in q65_init()\n");
       exit(0);
     }
-    first=0;
+    codec_ready=1;
   }
+}
+
+void q65_enc_(int x[], int y[])
+{
+
+  q65_codec_init();
   // Encode message x[13], producing codeword y[63]
   q65_encode(&codec,y,x);
 }
@@ -58,17 +68,8 @@ void q65_intrinsics_ff_(float s3[], int* submode, float* B90Ts,
  */
 
   int rc;
-  static int first=1;
 
-  if (first) {
-    // Set the QRA code, allocate memory, and initialize
-    int rc = q65_init(&codec,&qra15_65_64_irr_e23);
-    if (rc<0) {
-      printf("error in q65_init()\n");
-      exit(0);
-    }
-    first=0;
-  }
+  q65_codec_init();
   rc = q65_intrinsics_fastfading(&codec,s3prob,s3,*submode,*B90Ts,*fadingModel);
   if(rc<0) {
     printf("error in q65_intrinsics()\n");
@@ -95,6 +96,7 @@ void q65_dec_(float s3[], float s3prob[], int APmask[], int APsymbols[],
   float esnodb;
   int maxiters=*maxiters0;
 
+  q65_codec_init();
   rc = q65_decode(&codec,ydec,xdec,s3prob,APmask,APsymbols,maxiters);
   *rc0=rc;
   // rc = -1:  Invalid params
@@ -128,6 +130,7 @@ void q65_dec_fullaplist_(float s3[], float s3prob[], int codewords[],
   int ydec[63];
   float esnodb;
 
+  q65_codec_init();
   rc = q65_decode_fullaplist(&codec,ydec,xdec,s3prob,codewords,*ncw);
   *plog=q65_llh;
   *rc0=rc;
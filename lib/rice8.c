@@ -0,0 +1,123 @@
+/*
+ rice8.c
+
+ Lossless Rice coding of blocks of 8-bit signed samples, used for the
+ quantized I/Q data in QMAP .qm files.
+
+ Samples are zigzag mapped to 0..255 (0,-1,1,-2,... -> 0,1,2,3,...)
+ and each is sent as a unary quotient and k low order bits, where k
+ is chosen per block to minimize the coded size.  A quotient of QMAX
+ or more is sent as QMAX ones followed by the 8-bit mapped sample.
+
+ Block layout: one byte holding k, then the bits, most significant
+ first, padded with zeros to a whole byte.
+ */
+
+#include <string.h>
+
+#define QMAX 16
+
+static int coded_bits(long const hist[256], int k)
+{
+  long bits=0;
+  int z, q;
+
+  for(z=0; z<256; z++) {
+    if(!hist[z]) continue;
+    q=z>>k;
+    bits+=hist[z]*(q<QMAX ? q+1+k : QMAX+8);
+  }
+  return bits>0x7fffffff ? 0x7fffffff : (int)bits;
+}
+
+/* Encode x[0..n-1] into buf[0..nbuf-1].  *nbytes is the length of the
+   coded block, or 0 if it would be no smaller than the raw samples. */
+void rice8_encode_(signed char const x[], int const *n, unsigned char buf[],
+                   int const *nbuf, int *nbytes)
+{
+  long hist[256];
+  int i, k, kbest=0, bits, best=0x7fffffff, nout, q, z, nb=0;
+  unsigned int acc=0;
+
+  *nbytes=0;
+  memset(hist,0,sizeof hist);
+  for(i=0; i<*n; i++) {
+    z=x[i];
+    hist[(unsigned char)((z<<1) ^ (z>>7))]++;
+  }
+  for(k=0; k<8; k++) {
+    bits=coded_bits(hist,k);
+    if(bits<best) {
+      best=bits;
+      kbest=k;
+    }
+  }
+  nout=1 + (best+7)/8;
+  if(nout>=*n || nout>*nbuf) return;
+
+  k=kbest;
+  buf[0]=(unsigned char)k;
+  nout=1;
+#define PUTBITS(v,m) do {                                       \
+    acc=(acc<<(m)) | (unsigned int)(v); nb+=(m);                \
+    while(nb>=8) {nb-=8; buf[nout++]=(unsigned char)(acc>>nb);} \
+  } while(0)
+  for(i=0; i<*n; i++) {
+    z=x[i];
+    z=(unsigned char)((z<<1) ^ (z>>7));
+    q=z>>k;
+    if(q<QMAX) {
+      PUTBITS((1u<<(q+1))-2,q+1);              /* q ones then a zero */
+      if(k) PUTBITS(z & ((1<<k)-1),k);
+    } else {
+      PUTBITS((1u<<QMAX)-1,QMAX);
+      PUTBITS(z,8);
+    }
+  }
+  if(nb) buf[nout++]=(unsigned char)(acc<<(8-nb));
+#undef PUTBITS
+  *nbytes=nout;
+}
+
+/* Decode a block of *nbytes bytes into x[0..n-1], *ierr is nonzero if
+   the block is short or corrupt. */
+void rice8_decode_(unsigned char const buf[], int const *nbytes,
+                   signed char x[], int const *n, int *ierr)
+{
+  int i, k, q, z, ibyte=1, nb=0;
+  unsigned int acc=0;
+
+  *ierr=1;
+  if(*nbytes<1) return;
+  k=buf[0];
+  if(k>7) return;
+#define NEED(m) do {                                      \
+    while(nb<(m)) {                                       \
+      if(ibyte>=*nbytes) return;                          \
+      acc=(acc<<8) | buf[ibyte++]; nb+=8;                 \
+    }                                                     \
+  } while(0)
+#define GETBITS(m) (nb-=(m), (int)((acc>>nb) & ((1u<<(m))-1)))
+  for(i=0; i<*n; i++) {
+    q=0;
+    for(;;) {
+      NEED(1);
+      if(!GETBITS(1)) break;
+      if(++q==QMAX) break;
+    }
+    if(q<QMAX) {
+      z=q<<k;
+      if(k) {
+        NEED(k);
+        z|=GETBITS(k);
+      }
+    } else {
+      NEED(8);
+      z=GETBITS(8);
+    }
+    x[i]=(signed char)((z>>1) ^ -(z&1));
+  }
+#undef GETBITS
+#undef NEED
+  *ierr=0;
+}
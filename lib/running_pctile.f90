@@ -0,0 +1,74 @@
+subroutine running_pctile(x,npts,nw,npct,y,nout)
+
+! Percentile of a sliding window, y(m) is what
+! pctile(x(m),nw,npct,y(m)) would return, for m=1,nout.  The window is
+! kept sorted, each step removes the oldest point and inserts the
+! newest by bisection, rather than sorting every window from scratch.
+
+  real x(npts)
+  real y(nout)
+  real w(nw)
+
+  if(nout.lt.1) return
+  if(nw.lt.1 .or. npct.lt.0 .or. npct.gt.100 .or. nout+nw-1.gt.npts) then
+     y=1.0
+     return
+  endif
+  k=nint(nw*0.01*npct)
+  if(k.lt.1) k=1
+  if(k.gt.nw) k=nw
+
+  w=x(1:nw)
+  call shell(nw,w)
+  y(1)=w(k)
+  do m=2,nout
+     xold=x(m-1)
+     xnew=x(m+nw-1)
+! Find the oldest point
+     i=ibisect(xold)
+     if(i.gt.nw) then
+        i=0
+     else if(w(i).ne.xold) then
+        i=0
+     endif
+     if(i.eq.0) then                          !Not found (NaN), start over
+        w=x(m:m+nw-1)
+        call shell(nw,w)
+     else
+! Remove it and insert the newest point
+        w(i:nw-1)=w(i+1:nw)
+        j=ibisect(xnew,nw-1)
+        w(j+1:nw)=w(j:nw-1)
+        w(j)=xnew
+     endif
+     y(m)=w(k)
+  enddo
+
+  return
+
+contains
+
+  integer function ibisect(v,n)
+! First index of w(1:n) not less than v, n+1 if none
+    real v
+    integer, optional :: n
+    integer lo,hi,mid
+
+    hi=nw
+    if(present(n)) hi=n
+    lo=1
+    hi=hi+1
+    do while(lo.lt.hi)
+       mid=(lo+hi)/2
+       if(w(mid).lt.v) then
+          lo=mid+1
+       else
+          hi=mid
+       endif
+    enddo
+    ibisect=lo
+
+    return
+  end function ibisect
+
+end subroutine running_pctile
@@ -0,0 +1,43 @@
+subroutine smo121n(x,nz,nsmo)
+
+! Equivalent of nsmo passes of smo121, at a cost that does not grow
+! with nsmo.  A few passes are done directly; beyond that the binomial
+! kernel is approximated by NPASS boxcar passes whose variances add up
+! to its variance, nsmo/2, each done with a running sum.  End points
+! are left unchanged.
+
+  parameter (MAXDIRECT=32,NPASS=5)
+  real x(nz)
+  real y(nz)
+  real*8 s
+
+  if(nsmo.le.MAXDIRECT) then
+     do i=1,nsmo
+        call smo121(x,nz)
+     enddo
+     return
+  endif
+
+! Boxes of 2*nh+1 points have variance nh*(nh+1)/3.  Use m passes of
+! half-width nh and NPASS-m of half-width nh+1.
+  nh=int(0.5*(sqrt(1.0+6.0*nsmo/NPASS)-1.0))
+  m=nint(0.5*(NPASS*(nh+2) - 1.5*nsmo/(nh+1)))
+  m=min(max(m,0),NPASS)
+  if(2*nh+4.ge.nz) return
+  x1=x(1)
+  xn=x(nz)
+  do ipass=1,NPASS
+     if(ipass.eq.m+1) nh=nh+1
+     s=sum(x(1:nh+1))
+     do i=1,nz
+        if(i+nh.le.nz .and. i.gt.1) s=s+x(i+nh)
+        if(i-nh-1.ge.1) s=s-x(i-nh-1)
+        y(i)=s/(min(i+nh,nz)-max(i-nh,1)+1)
+     enddo
+     x=y
+  enddo
+  x(1)=x1
+  x(nz)=xn
+
+  return
+end subroutine smo121n
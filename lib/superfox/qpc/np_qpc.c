@@ -41,14 +41,16 @@ static float* pdf_conv(float *dst, float* pdf1, float* pdf2)
     qpc_fwht(fwht_pdf1, pdf1);
     qpc_fwht(fwht_pdf2, pdf2);
 
+    // the transform is linear, so normalize before the inverse
+    // (knorm is a power of two, the result is the same)
+#ifdef _OPENMP
+#pragma omp simd
+#endif
     for (k = 0; k < QPC_Q; k++)
-        fwht_pdf1[k] *= fwht_pdf2[k];
+        fwht_pdf1[k] *= fwht_pdf2[k] * knorm;
 
     qpc_fwht(dst, fwht_pdf1);
 
-    for (k = 0; k < QPC_Q; k++)
-        dst[k] *= knorm;
-
     return dst;
 }
 static void   pdfarray_conv(float* dstarray, float* pdf1array, float* pdf2array, int numrows)
@@ -66,40 +68,14 @@ static void   pdfarray_conv(float* dstarray, float* pdf1array, float* pdf2array,
 
 }
 
-static float _pdfuniform[QPC_Q];
-static const float* _pdf_uniform1();
-static const float* _pdf_uniform0();
-typedef const float*(*ptr_pdfuniform)(void);
-
-static ptr_pdfuniform _ptr_pdf_uniform = _pdf_uniform0;
-
-static const float* _pdf_uniform1() 
-{
-    return _pdfuniform;
-};
-static const float* _pdf_uniform0() 
-{
-    // compute uniform pdf once for all
-    int k;
-    for (k = 0; k < QPC_Q; k++)
-        _pdfuniform[k] = knorm;
-
-    // next call to _qpc_pdfuniform
-    // will be handled directly by _pqc_pdfuniform1
-    _ptr_pdf_uniform = _pdf_uniform1;
-
-    return _pdfuniform;
-};
-static const float*  pdf_uniform()
-{
-    return _ptr_pdf_uniform();
-}
-
 static float * pdf_mul(float *dst, float* pdf1, float* pdf2)
 {
     int k;
     float v;
     float norm = 0;
+#ifdef _OPENMP
+#pragma omp simd private(v) reduction(+:norm)
+#endif
     for (k = 0; k < QPC_Q; k++) {
         v = pdf1[k] * pdf2[k];
         dst[k] = v;
@@ -107,10 +83,15 @@ static float * pdf_mul(float *dst, float* pdf1, float* pdf2)
     }
     // if norm of the result is not positive
     // return in dst a uniform distribution
-    if (norm <= 0)
-        memcpy(dst, pdf_uniform(), QPC_Q * sizeof(float));
+    if (norm <= 0) {
+        for (k = 0; k < QPC_Q; k++)
+            dst[k] = knorm;
+    }
     else {
         norm = 1.0f / norm;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
         for (k = 0; k < QPC_Q; k++)
             dst[k] = dst[k] * norm;
     }
@@ -159,31 +140,22 @@ static unsigned char pdf_max(const float* pdf)
 {
     int k;
 
-    unsigned char imax = 0;
+    // find the largest value with a vectorizable reduction, then the
+    // first index at which it occurs
     float pdfmax = pdf[0];
 
+#ifdef _OPENMP
+#pragma omp simd reduction(max:pdfmax)
+#endif
     for (k=1;k<QPC_Q;k++)
-        if (pdf[k] > pdfmax) {
+        if (pdf[k] > pdfmax)
             pdfmax = pdf[k];
-            imax = k;
-        }
 
-    return imax;
-}
-
-// local stack functions ---------------------------------------
-static float _qpc_stack[QPC_N * QPC_Q * 2];
-static float* _qpc_stack_base = _qpc_stack;
+    for (k=0;k<QPC_Q-1;k++)
+        if (pdf[k] == pdfmax)
+            break;
 
-static float* _qpc_stack_push(int numfloats)
-{
-    float* addr = _qpc_stack_base;
-    _qpc_stack_base += numfloats;
-    return addr;
-}
-static void _qpc_stack_pop(int numfloats)
-{
-    _qpc_stack_base -= numfloats;
+    return (unsigned char)k;
 }
 
 // qpc encoder function (internal use) ----------------------------------------------------------
@@ -224,7 +196,9 @@ unsigned char* _qpc_encode(unsigned char* y, unsigned char* x)
 }
 
 // qpc polar decoder (internal use )--------------------------------------------------
-void _qpc_decode(unsigned char* xdec, unsigned char* ydec, const float* py, const unsigned char* f, const unsigned char* fsize, const int numrows)
+// stack is the caller's scratch space for the recursion, it needs
+// QPC_STACK_SIZE floats for numrows == QPC_N
+void _qpc_decode(unsigned char* xdec, unsigned char* ydec, const float* py, const unsigned char* f, const unsigned char* fsize, const int numrows, float* stack)
 {
 
     if (numrows == 1) {
@@ -257,10 +231,10 @@ void _qpc_decode(unsigned char* xdec, unsigned char* ydec, const float* py, cons
         // Step 1.
         // stack and init variables used in the recursion
 
-        float* pyl = _qpc_stack_push(size);
+        float* pyl = stack;
         memcpy(pyl, py, size * sizeof(float));
 
-        float* pyh = _qpc_stack_push(size);
+        float* pyh = stack + size;
         memcpy(pyh, py + size, size * sizeof(float));
 
         // Step 2. Recursion on upper block
@@ -271,18 +245,15 @@ void _qpc_decode(unsigned char* xdec, unsigned char* ydec, const float* py, cons
 //        pdfarray_conv(py, pyl, pyh, nextrows); // convolution overwriting the lower block of py which is not needed  
 
         pdfarray_conv(pyh, pyl, pyh, nextrows); 
-        _qpc_decode(xdech, ydech, pyh, fh, fsizeh, nextrows);
+        _qpc_decode(xdech, ydech, pyh, fh, fsizeh, nextrows, stack + 2 * size);
  
         // Step 3. compute pdfs in the lower block
         pdfarray_convhard(pyh, py+size, ydech,nextrows); // dst ptr must be different form src ptr
         pdfarray_mul(pyl, pyl, pyh, nextrows);
-        // we don't need pyh anymore
-        _qpc_stack_pop(size);
+        // we don't need pyh anymore, its space is reused by the recursion
 
         // Step 4. Recursion on the lower block
-        _qpc_decode(xdec, ydec, pyl, f, fsize, nextrows);
-        // we don't need pyl anymore
-        _qpc_stack_pop(size);
+        _qpc_decode(xdec, ydec, pyl, f, fsize, nextrows, stack + size);
 
         // Step 5. Update backward results
         // xdec is already ok, we need just to update ydech
@@ -307,7 +278,9 @@ void qpc_encode(unsigned char* y, const unsigned char* x)
     // do polar encoding
     _qpc_encode(y, qpccode.f);
 }
-void qpc_decode(unsigned char* xdec, unsigned char* ydec, float* py)
+// stack is scratch space of QPC_STACK_SIZE floats, the decoder keeps
+// no state of its own so threads may decode at once with a stack each
+void qpc_decode(unsigned char* xdec, unsigned char* ydec, float* py, float* stack)
 {
     int k;
     unsigned char x[QPC_N];
@@ -320,7 +293,7 @@ void qpc_decode(unsigned char* xdec, unsigned char* ydec, float* py)
     }
 
     // decode
-    _qpc_decode(x, ydec, py, qpccode.f, qpccode.fsize, QPC_N);
+    _qpc_decode(x, ydec, py, qpccode.f, qpccode.fsize, QPC_N, stack);
 
     // demap information symbols
     for (k = 0; k < QPC_K; k++)
@@ -28,6 +28,7 @@
 #define QPC_LOG2Q 7             // bits per symbol
 #define QPC_Q (1<<QPC_LOG2Q)    // alphabet size
 #define QPC_K 50               // number of information symbols
+#define QPC_STACK_SIZE (QPC_N * QPC_Q * 2) // decoder scratch floats
 
 
 typedef struct {
@@ -46,12 +47,12 @@ extern "C"
 #endif
 
     void qpc_encode(unsigned char* y, const unsigned char* x);
-    void qpc_decode(unsigned char* xdec, unsigned char* ydec, float* py);
+    void qpc_decode(unsigned char* xdec, unsigned char* ydec, float* py, float* stack);
 
     unsigned char* _qpc_encode(unsigned char* y, unsigned char* x);
     void           _qpc_decode(unsigned char* xdec, unsigned char* ydec,
                         const float* py, const unsigned char* f, const unsigned char* fsize,
-                        const int numrows);
+                        const int numrows, float* stack);
 
     extern qpccode_ds qpccode;
 
@@ -136,6 +136,7 @@ int main()
 
     static float yout[QPC_N * QPC_Q * 2];  // channel complex amplitutes output
     static float py[QPC_N * QPC_Q];        // channel output probabilities
+    static float stack[QPC_STACK_SIZE];    // decoder scratch space
 
     float EsNo = powf(10.0f, EsNodB / 10.0f);
     float No = 1.0f;
@@ -175,7 +176,7 @@ int main()
         float EsNoDec = 3.16; 
         qpc_likelihoods(py, yout, EsNoDec, No);
         
-        qpc_decode(xdec, ydec, py);                 // decode 
+        qpc_decode(xdec, ydec, py, stack);          // decode 
 
         // count words in errors
         for (kk = 0; kk < QPC_K; kk++)
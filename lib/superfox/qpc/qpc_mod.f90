@@ -27,11 +27,12 @@ module qpc_mod
   end interface
 
   interface
-     subroutine qpc_decode(xdec, ydec, py) bind(C,name="qpc_decode")
+     subroutine qpc_decode(xdec, ydec, py, stack) bind(C,name="qpc_decode")
        use iso_c_binding, only: c_float, c_signed_char
        real(c_float), intent(in) :: py(128,128)
        integer(c_signed_char), intent(out) :: ydec(127)
        integer(c_signed_char), intent(out) :: xdec(50)
+       real(c_float), intent(inout) :: stack(2*128*128) ! decoder scratch
      end subroutine qpc_decode
   end interface
 
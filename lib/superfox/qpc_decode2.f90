@@ -1,29 +1,36 @@
 subroutine qpc_decode2(c0,fsync,ftol,xdec,ndepth,dth,damp,crc_ok,   &
      snrsync,fbest,tbest,snr)
 
+! Trials are made in the order (idith, kk, kkk) and the first one
+! with a good CRC is taken.  They run in parallel: batches of dithered
+! likelihoods for the first frequency and time, then the remaining
+! frequency and time offsets, with the trials after one that has
+! decoded abandoned.  The result is the same as running them in order.
+
    use qpc_mod
 
-   parameter(NMAX=15*12000,NFT=365,NZ=100)
+   parameter(NMAX=15*12000,NZ=100,NBATCH=32)
    complex c0(NMAX)                    !Signal as received
-   complex c(NMAX)                     !Signal as received
+   complex, allocatable :: c(:)        !Signal shifted in frequency
    real py(0:127,0:127)                !Probabilities for received synbol values
    real py0(0:127,0:127)               !Probabilities for strong signal
    real pyd(0:127,0:127)               !Dithered values for py
-   real s2(0:127,0:151)                !Symbol spectra, including sync
-   real s3(0:127,0:127)                !Synchronized symbol spectra
+   real, allocatable :: rnd(:,:,:)     !Random dithers for a batch
+   real s3a(0:127,0:127)               !Synchronized symbol spectra
+   real s3(0:127,0:127)                !Smoothed s3a
+   real s3b(0:127,0:127)
    real No
-   integer crc_chk,crc_sent
-   integer*8 n47
    integer idf(NZ),idt(NZ)
    integer nseed(33)
    integer*1 xdec(0:49)                !Decoded message
    integer*1 ydec(0:127)               !Decoded symbols
-   logical crc_ok
+   integer*1 xd(0:49),yd(0:127)
+   logical crc_ok,ok
    integer maxdither(8)
    integer isync(24)                   !Symbol numbers for sync tones
    data isync/1,2,4,7,11,16,22,29,37,39,42,43,45,48,52,57,63,70,78,80,83,  &
       84,86,89/
-   data n47/47/,maxdither/20,50,100,200,500,1000,2000,5000/
+   data maxdither/20,50,100,200,500,1000,2000,5000/
    data nseed/                                                         &
       321278106,  -658879006,  1239150429,  -941466001, -698554454, &
       1136210962,  1633585627,  1261915021, -1134191465, -487888229, &
@@ -50,11 +57,8 @@ subroutine qpc_decode2(c0,fsync,ftol,xdec,ndepth,dth,damp,crc_ok,   &
 
 
    fsample=12000.0
-   baud=12000.0/1024.0
-   nstype=1
-   n47=47
-   mask21=2**21 - 1
    crc_ok=.false.
+   snr=-99.
 
    call qpc_sync(c0,fsample,isync,fsync,ftol,f2,t2,snrsync)
    f00=1500.0 + f2
@@ -65,76 +69,197 @@ subroutine qpc_decode2(c0,fsync,ftol,xdec,ndepth,dth,damp,crc_ok,   &
    if(ndepth.gt.0) maxd=maxdither(ndepth)
    maxft=NZ
    if(snrsync.lt.4.0 .or. ndepth.le.0) maxft=1
-   do idith=1,maxft
-      if(idith.ge.2) maxd=1
-      deltaf=idf(idith)*0.5
-      deltat=idt(idith)*8.0/1024.0
-      f=f00+deltaf
-      t=t00+deltat
-      fshift=1500.0 - (f+baud)        !Shift frequencies down by f + 1 bin
-      call twkfreq2(c0,c,NMAX,fsample,fshift)
-      a=1.0
-      b=0.0
-      do kk=1,4
-         if(kk.eq.2) b=0.4
-         if(kk.eq.3) b=0.5
-         if(kk.eq.4) b=0.6
-         call sfox_demod(c,1500.0,t,isync,s2,s3)       !Compute s2 and s3
-
-         if(b.gt.0.0) then
-            do j=0,127
-               call smo121a(s3(:,j),128,a,b)
-            enddo
-         endif
-         call pctile(s3,128*128,50,base3)
-         s3=s3/base3
-
-         EsNoDec=3.16
-         No=1.
-         py0=s3
-         call qpc_likelihoods2(py,s3,EsNoDec,No)       !For weak signals
-         
-         call random_seed(put=nseed)
-         do kkk=1,maxd
+
+! idith=1: the sync frequency and time, with dithered likelihoods
+   allocate(c(NMAX),rnd(0:127,0:127,NBATCH))
+   call qpc_spectra(c0,c,f00,t00,isync,s3a)
+   do kk=1,4
+      call qpc_smooth(s3a,kk,s3)
+      EsNoDec=3.16
+      No=1.
+      py0=s3
+      call qpc_likelihoods2(py,s3,EsNoDec,No)       !For weak signals
+
+      call random_seed(put=nseed)
+      do k1=1,maxd,NBATCH
+         k2=min(k1+NBATCH-1,maxd)
+         do kkk=max(k1,3),k2         !Same random numbers as one at a time
+            call random_number(rnd(:,:,kkk-k1+1))
+         enddo
+         kbest=k2+1
+!$omp parallel do default(shared) private(kkk,kb,pyd,xd,yd,ok)           &
+!$omp schedule(dynamic)
+         do kkk=k1,k2
+!$omp atomic read
+            kb=kbest
+            if(kkk.gt.kb) cycle                 !An earlier trial has decoded
             if(kkk.eq.1) then
                pyd=py0
             else
                pyd=0.
-               if(kkk.gt.2) then
-                  call random_number(pyd)
-                  pyd=2.0*(pyd-0.5)
-               endif
+               if(kkk.gt.2) pyd=2.0*(rnd(:,:,kkk-k1+1)-0.5)
                where(py.gt.dth) pyd=0.          !Don't perturb large likelihoods
                pyd=py*(1.0 + damp*pyd)          !Compute dithered likelihood
             endif
-            do j=0,127
-               ss=sum(pyd(:,j))
-               if(ss.gt.0.0) then
-                 pyd(:,j)=pyd(:,j)/ss
-               else
-                 pyd(:,j)=0.0
+            call qpc_try(pyd,xd,yd,ok)
+            if(ok) then
+!$omp critical(qpc_best)
+               if(kkk.lt.kbest) then
+!$omp atomic write
+                  kbest=kkk
+                  xdec=xd
+                  ydec=yd
                endif
-            enddo
-
-            call qpc_decode(xdec,ydec,pyd)
-            xdec=xdec(49:0:-1)
-            crc_chk=iand(nhash2(xdec,n47,571),mask21)           !Compute crc_chk
-            crc_sent=128*128*xdec(47) + 128*xdec(48) + xdec(49)
-            crc_ok=crc_chk.eq.crc_sent
-
-            if(crc_ok) then
-               call qpc_snr(s3,ydec,snr)
-               if(snr.lt.-16.5) crc_ok=.false.
-!               write(61,3061) idith,kk,kkk,idf(idith),idt(idith),a,b
-!3061           format(5i5,2f8.3)
-               return
+!$omp end critical(qpc_best)
             endif
-         enddo    !kk: dither of smoothing weights
-      enddo       !kkk: dither of probabilities
-   enddo          !idith: dither of frequency and time
+         enddo
+!$omp end parallel do
+         if(kbest.le.k2) then
+            crc_ok=.true.
+            call qpc_snr(s3,ydec,snr)
+            go to 900
+         endif
+      enddo    !kkk: dither of probabilities
+   enddo       !kk: dither of smoothing weights
+   deallocate(rnd)
+
+! idith>=2: other frequencies and times, without dithered likelihoods
+   nbest=maxft+1
+!$omp parallel do default(shared) private(idith,nb,f,t,xd,yd,s3b,ok)     &
+!$omp schedule(dynamic)
+   do idith=2,maxft
+!$omp atomic read
+      nb=nbest
+      if(idith.gt.nb) cycle
+      f=f00 + idf(idith)*0.5
+      t=t00 + idt(idith)*8.0/1024.0
+      call qpc_ftrial(c0,f,t,isync,xd,yd,s3b,ok)
+      if(ok) then
+!$omp critical(qpc_best)
+         if(idith.lt.nbest) then
+!$omp atomic write
+            nbest=idith
+            xdec=xd
+            ydec=yd
+            s3=s3b
+         endif
+!$omp end critical(qpc_best)
+      endif
+   enddo
+!$omp end parallel do
+   if(nbest.le.maxft) then
+      crc_ok=.true.
+      call qpc_snr(s3,ydec,snr)
+   endif
+
+900 if(crc_ok .and. snr.lt.-16.5) crc_ok=.false.
    return
 end subroutine qpc_decode2
 
+subroutine qpc_spectra(c0,c,f,t,isync,s3)
+
+! Synchronized symbol spectra for frequency f and time t
+
+   parameter(NMAX=15*12000)
+   complex c0(NMAX),c(NMAX)
+   real s2(0:127,0:151)
+   real s3(0:127,0:127)
+   integer isync(24)
+
+   baud=12000.0/1024.0
+   fshift=1500.0 - (f+baud)        !Shift frequencies down by f + 1 bin
+   call twkfreq2(c0,c,NMAX,12000.0,fshift)
+   call sfox_demod(c,1500.0,t,isync,s2,s3)       !Compute s2 and s3
+
+   return
+end subroutine qpc_spectra
+
+subroutine qpc_smooth(s3a,kk,s3)
+
+! Smoothing trial kk of the spectra s3a, normalized to the median
+
+   real s3a(0:127,0:127)
+   real s3(0:127,0:127)
+
+   s3=s3a
+   a=1.0
+   b=0.0
+   if(kk.eq.2) b=0.4
+   if(kk.eq.3) b=0.5
+   if(kk.eq.4) b=0.6
+   if(b.gt.0.0) then
+      do j=0,127
+         call smo121a(s3(:,j),128,a,b)
+      enddo
+   endif
+   call pctile(s3,128*128,50,base3)
+   s3=s3/base3
+
+   return
+end subroutine qpc_smooth
+
+subroutine qpc_ftrial(c0,f,t,isync,xdec,ydec,s3,crc_ok)
+
+! Try the four smoothings at frequency f and time t, undithered.  Safe
+! to call from several threads at once.
+
+   parameter(NMAX=15*12000)
+   complex c0(NMAX)
+   complex, allocatable :: c(:)
+   real s3a(0:127,0:127)
+   real s3(0:127,0:127)
+   real pyd(0:127,0:127)
+   integer isync(24)
+   integer*1 xdec(0:49)
+   integer*1 ydec(0:127)
+   logical crc_ok
+
+   allocate(c(NMAX))
+   call qpc_spectra(c0,c,f,t,isync,s3a)
+   do kk=1,4
+      call qpc_smooth(s3a,kk,s3)
+      pyd=s3
+      call qpc_try(pyd,xdec,ydec,crc_ok)
+      if(crc_ok) exit
+   enddo
+
+   return
+end subroutine qpc_ftrial
+
+subroutine qpc_try(pyd,xdec,ydec,crc_ok)
+
+! Normalize the likelihoods pyd, decode, and check the CRC
+
+   use qpc_mod
+   real pyd(0:127,0:127)
+   integer crc_chk,crc_sent
+   integer*8 n47
+   integer*1 xdec(0:49)
+   integer*1 ydec(0:127)
+   real, allocatable :: stack(:)       !Decoder scratch, one per call
+   logical crc_ok
+   data n47/47/
+
+   mask21=2**21 - 1
+   do j=0,127
+      ss=sum(pyd(:,j))
+      if(ss.gt.0.0) then
+         pyd(:,j)=pyd(:,j)/ss
+      else
+         pyd(:,j)=0.0
+      endif
+   enddo
+
+   allocate(stack(2*128*128))
+   call qpc_decode(xdec,ydec,pyd,stack)
+   xdec=xdec(49:0:-1)
+   crc_chk=iand(nhash2(xdec,n47,571),mask21)           !Compute crc_chk
+   crc_sent=128*128*xdec(47) + 128*xdec(48) + xdec(49)
+   crc_ok=crc_chk.eq.crc_sent
+
+   return
+end subroutine qpc_try
+
 subroutine smo121a(x,nz,a,b)
 
   real x(nz)
@@ -1,24 +1,31 @@
 subroutine sfox_wave_gfsk()
 
-! Called by WSJT-X when it's time for SuperFox to transmit.  Reads array
-! itone(1:151) from disk file 'sfox_2.dat' in the writable data directory.
-! Generates a GFSK waveform with short ramp-up and ramp-down symbols of 
-! duration NSPS/BT at the beginning and end of the waveform.
+! Called by WSJT-X when it's time for SuperFox to transmit.  Takes array
+! itone(1:151) from common/foxcom3/, as set by sftx_sub(), and generates
+! the GFSK waveform straight into wave() in common/foxcom/, with short
+! ramp-up and ramp-down symbols of duration NSPS/BT at the beginning and
+! end of the waveform.
+
+! The frequency pulse is split into its three symbol-long segments and
+! the ramps are tabulated on the first call, so each call only sums
+! three pulse segments per sample.  Only the samples the modulator
+! plays are written.
 
   parameter (NWAVE=(160+2)*134400*4) !Max WSJT-X waveform (FST4-1800 at 48kHz)
   parameter (NSYM=151,NSPS=1024*4)
   parameter (NPTS=(NSYM+2)*NSPS)
   parameter (BT=8)
+  parameter (NRAMP=NSPS/BT)
   character*40 cmsg2
-  integer itone(151)
-  real*8 dt,twopi,f0,phi,dphi_peak
-  real*8 dphi(0:NPTS-1)
-  real*8 pulse(3*NSPS)
+  integer itone(-1:NSYM+2)             !Tones, extended for the ramp symbols
+  real*8 dt,twopi,f0,phi,dphi,dphi_peak,dphi0
+  real*8 pulse(NSPS,3)                 !Frequency pulse, by symbol
+  real*8 rampup(0:NRAMP-1),rampdn(0:NRAMP-1)
   logical first/.true./
 
   common/foxcom/wave(NWAVE)
   common/foxcom3/nslots2,cmsg2(5),itone3(151)
-  save first,twopi,dt,hmod,dphi_peak,pulse
+  save first,twopi,dt,hmod,dphi_peak,pulse,rampup,rampdn
 
   if(first) then
     fsample=48000.0
@@ -26,52 +33,56 @@ subroutine sfox_wave_gfsk()
     dt=1.d0/fsample
     hmod=1.0
     dphi_peak=twopi*hmod/real(NSPS)
-    do i=1,3*NSPS 
+    do i=1,3*NSPS
       tt=(i-1.5*NSPS)/real(NSPS)
-      pulse(i)=gfsk_pulse(BT,tt)
+      pulse(mod(i-1,NSPS)+1,(i-1)/NSPS+1)=dphi_peak*gfsk_pulse(BT,tt)
+    enddo
+    do i=0,NRAMP-1
+      rampup(i)=(1.0-cos(twopi*i/(2.0*NRAMP)))/2.0
+      rampdn(i)=(1.0+cos(twopi*i/(2.0*NRAMP)))/2.0
     enddo
     first=.false.
   endif
-  wave=0.
- 
-  itone=itone3
-  if(itone(1).lt.0 .or. itone(1).gt.128) go to 999
 
-! Generate the SuperFox waveform.
-  
-  dphi=0.d0
-  do j=1,NSYM
-    ib=(j-1)*NSPS
-    ie=ib+3*NSPS-1
-    dphi(ib:ie)=dphi(ib:ie)+dphi_peak*pulse(1:3*NSPS)*itone(j)
-  enddo
-  dphi(0:2*NSPS-1)=dphi(0:2*NSPS-1)+dphi_peak*itone(1)*pulse(NSPS+1:3*NSPS)
-  dphi(NSYM*NSPS:(NSYM+2)*NSPS-1)=dphi(NSYM*NSPS:(NSYM+2)*NSPS-1)+dphi_peak*itone(NSYM)*pulse(1:2*NSPS)
+  if(itone3(1).lt.0 .or. itone3(1).gt.128) then
+     wave(1:NPTS+NSPS)=0.
+     go to 999
+  endif
 
+! The ramp-up symbol carries the tail of a pulse at the first tone,
+! the ramp-down symbol the head of one at the last tone.
+  itone(-1)=0
+  itone(0)=itone3(1)
+  itone(1:NSYM)=itone3
+  itone(NSYM+1)=itone3(NSYM)
+  itone(NSYM+2)=0
+
+! Generate the SuperFox waveform, one symbol-long slot at a time.
   phi=0.d0
   f0=750.0d0
-  dphi=dphi+twopi*f0*dt
+  dphi0=twopi*f0*dt
   k=0
-  do j=1,NSPS*(NSYM+2)-1
-    k=k+1
-    wave(k)=sin(phi)
-    phi=phi+dphi(j)
+  do m=0,NSYM+1
+     do i=1,NSPS
+        k=k+1
+        dphi=itone(m-1)*pulse(i,3) + itone(m)*pulse(i,2) +                 &
+             itone(m+1)*pulse(i,1) + dphi0
+        if(k.gt.1) phi=phi+dphi
+        wave(k)=sin(phi)
+     enddo
   enddo
-  
+
 ! Add raised cosine ramps at the beginning and end of the waveform.
 ! Since the modulator expects an integral number of symbols, dummy
-! symbols are added to the beginning and end of the waveform to 
+! symbols are added to the beginning and end of the waveform to
 ! hold the ramps. All but nramp of the samples in each dummy
 ! symbol will be zero.
- 
-  nramp=NSPS/BT
-  wave(1:NSPS-nramp)=0.0
-  wave(NSPS-nramp+1:NSPS)=wave(NSPS-nramp+1:NSPS) *                   &
-       (1.0-cos(twopi*(/(i,i=0,nramp-1)/)/(2.0*nramp)))/2.0
+
+  wave(1:NSPS-NRAMP)=0.0
+  wave(NSPS-NRAMP+1:NSPS)=wave(NSPS-NRAMP+1:NSPS)*rampup
   k1=(NSYM+1)*NSPS+1
-  wave(k1:k1+nramp-1)=wave(k1:k1+nramp-1) *                           &
-       (1.0+cos(twopi*(/(i,i=0,nramp-1)/)/(2.0*nramp)))/2.0
-  wave(k1+nramp:NPTS)=0.0
+  wave(k1:k1+NRAMP-1)=wave(k1:k1+NRAMP-1)*rampdn
+  wave(k1+NRAMP:NPTS+NSPS)=0.0
 
 999 return
 end subroutine sfox_wave_gfsk
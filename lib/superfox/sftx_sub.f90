@@ -3,13 +3,13 @@ subroutine sftx_sub(ckey0)
 ! This routine is required in order to create a SuperFox transmission.
 
 ! The present version goes through the following steps:
-!   1. Read old-style Fox messages from file 'sfox_1.dat' in the WSJT-X 
-!      writable data directory.
+!   1. Take the old-style Fox messages from common/foxcom3/, where
+!      foxgen() left them.
 !   2. Parse up to NSlots=5 messages to extract MyCall, up to 9 Hound
 !      calls, and the report or RR73 to be sent to each Hound.
 !   3. Assemble and encode a single SuperFox message to produce itone(1:151),
-!      the array of channel symbol values.
-!   4. Write the contents of array itone to file 'sfox_2.dat'.
+!      the array of channel symbol values, in common/foxcom3/ for
+!      sfox_wave_gfsk().
 
   use qpc_mod
   use sfox_mod
@@ -0,0 +1,97 @@
+program test_pctile
+
+! Check pctile, pctiles and running_pctile against sorting with shell,
+! and compare timings, on simulated power spectra: exponentially
+! distributed noise with a sprinkling of strong signals and some runs
+! of identical values.
+
+  parameter (NMAX=100000)
+  real s(NMAX),tmp(NMAX),y(NMAX),yref(NMAX)
+  integer npct(3)
+  real xp(3)
+  character*8 arg
+
+  nargs=iargc()
+  niter=100
+  if(nargs.ge.1) then
+     call getarg(1,arg)
+     read(arg,*) niter
+  endif
+
+  call random_number(s)
+  s=-log(1.0-s)                                 !Noise power
+  do i=1,NMAX,97
+     s(i)=s(i)+100.0                           !Signals
+  enddo
+  s(5000:5100)=1.0                              !Ties
+
+  nbad=0
+  do n=1,NMAX,NMAX/50
+     do ipct=0,100,5
+        tmp(1:n)=s(1:n)
+        call shell(n,tmp)
+        call pctile(s,n,ipct,xpct)
+        if(xpct.ne.tmp(max(1,min(n,nint(n*0.01*ipct))))) nbad=nbad+1
+     enddo
+     npct=(/84,20,50/)
+     call pctiles(s,n,npct,3,xp)
+     do i=1,3
+        if(xp(i).ne.tmp(max(1,min(n,nint(n*0.01*npct(i)))))) nbad=nbad+1
+     enddo
+  enddo
+  write(*,1000) 'pctile/pctiles mismatches:',nbad
+
+  nw=33
+  nout=4000
+  do m=1,nout
+     call pctile_shell(s(m),nw,28,yref(m))
+  enddo
+  call running_pctile(s,NMAX,nw,28,y,nout)
+  write(*,1000) 'running_pctile mismatches:',count(y(1:nout).ne.yref(1:nout))
+1000 format(a,i8)
+
+  call cpu_time(t0)
+  do iter=1,niter
+     call pctile_shell(s,4096,50,xpct)
+  enddo
+  call cpu_time(t1)
+  do iter=1,niter
+     call pctile(s,4096,50,xpct)
+  enddo
+  call cpu_time(t2)
+  write(*,1010) 'n=4096 shell:',1.e6*(t1-t0)/niter,' select:',1.e6*(t2-t1)/niter
+1010 format(a,f10.1,' us',a,f10.1,' us')
+
+  call cpu_time(t0)
+  do iter=1,niter
+     do m=1,nout
+        call pctile_shell(s(m),nw,28,yref(m))
+     enddo
+  enddo
+  call cpu_time(t1)
+  do iter=1,niter
+     call running_pctile(s,NMAX,nw,28,y,nout)
+  enddo
+  call cpu_time(t2)
+  write(*,1010) 'window 33 x 4000 shell:',1.e6*(t1-t0)/niter,' running:',1.e6*(t2-t1)/niter
+
+contains
+
+  subroutine pctile_shell(x,npts,npct,xpct)
+! The previous pctile implementation
+    real x(npts)
+    real,allocatable :: tmp(:)
+
+    allocate(tmp(npts))
+    tmp=x
+    call shell(npts,tmp)
+    j=nint(npts*0.01*npct)
+    if(j.lt.1) j=1
+    if(j.gt.npts) j=npts
+    xpct=tmp(j)
+    deallocate(tmp)
+
+    return
+  end subroutine pctile_shell
+
+end program test_pctile
@@ -290,6 +290,7 @@ subroutine boxit(reset,e2,ntau,npindex,i1,i2)
   integer   indexes(4000,2),fp(0:525000),np(4000)
   logical reset
   common/boxes/indexes,fp,np
+!$omp threadprivate(/boxes/)
 
   if(reset) then
     patterns=-1
@@ -328,6 +329,7 @@ subroutine fetchit(reset,e2,ntau,i1,i2)
   logical reset
   common/boxes/indexes,fp,np
   save lastpat,inext
+!$omp threadprivate(/boxes/,lastpat,inext)
 
   if(reset) then
     lastpat=-1
@@ -3,6 +3,8 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -17,10 +19,14 @@
 #include <QDebug>
 #include <QDebugStateSaver>
 #include <QRegularExpression>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
 #include "Configuration.hpp"
 #include "Radio.hpp"
 #include "pimpl_impl.hpp"
 #include "Logger.hpp"
+#include "StartupTimer.hpp"
 
 #include "moc_AD1CCty.cpp"
 
@@ -171,11 +177,59 @@ public:
 
   explicit impl (Configuration const * configuration)
     : configuration_ {configuration}
+    , loaded_ {true}
   {
   }
 
+  ~impl ()
+  {
+    wait ();
+  }
+
   QString get_cty_path(const Configuration *configuration);
   void load_cty(QFile &file);
+  Record lookup (QString const& call) const;
+
+  // parse cty.dat on a thread of its own
+  void start_load (AD1CCty const * self)
+  {
+    wait ();
+    QMutexLocker lock {&load_mutex_};
+    loaded_ = false;
+    load_ = std::async (std::launch::async, [this, self] {
+        QElapsedTimer timer;
+        timer.start ();
+        QFile file {path_};
+        LOG_INFO(QString{"Loading CTY.DAT from %1"}.arg (path_));
+        if (file.open (QFile::ReadOnly))
+          {
+            load_cty (file);
+            cty_version_ = lookup ("VERSION").entity_name;
+            Q_EMIT self->cty_loaded (cty_version_);
+            LOG_INFO(QString{"Loaded CTY.DAT version %1, %2"}.arg (cty_version_date_).arg (cty_version_));
+          }
+        StartupTimer::mark ("cty.dat", timer.elapsed ());
+      });
+  }
+
+  // wait for any load in progress, may be called from any thread
+  void wait () const
+  {
+    if (loaded_) return;
+    QMutexLocker lock {&load_mutex_};
+    if (load_.valid ())
+      {
+        try
+          {
+            load_.get ();
+          }
+        catch (std::exception const& e)
+          {
+            LOG_ERROR ("Failed to load CTY.DAT: " << e.what ());
+          }
+        loaded_ = true;
+      }
+  }
 
   entity_by_id::iterator lookup_entity (QString call, prefix const& p) const
   {
@@ -247,6 +301,10 @@ public:
 
   entities_type entities_;
   prefixes_type prefixes_;
+
+  std::future<void> mutable load_;
+  std::atomic<bool> mutable loaded_;
+  QMutex mutable load_mutex_;
 };
 
 AD1CCty::Record::Record ()
@@ -409,9 +467,7 @@ AD1CCty::AD1CCty (Configuration const * configuration)
   : m_ {configuration}
 {
   Q_ASSERT (configuration);
-  // TODO: G4WJS - consider doing the following asynchronously to
-  // speed up startup. Not urgent as it takes less than 0.5s on a Core
-  // i7 reading BIG CTY.DAT.
+  // parsed asynchronously, lookups wait until it is done
   AD1CCty::reload (configuration);
 
   //NJ0A
@@ -424,10 +480,6 @@ AD1CCty::AD1CCty (Configuration const * configuration)
   }
 
   QDir dataPath {QStandardPaths::writableLocation (QStandardPaths::DataLocation)};
-  m_->path_ = dataPath.exists (file_name)
-    ? dataPath.absoluteFilePath (file_name) // user override
-    : configuration->data_dir ().absoluteFilePath (file_name); // or original
-
   QString path = dataPath.exists (grid_file_name)
    ? dataPath.absoluteFilePath (grid_file_name) // user override
    : configuration->data_dir ().absoluteFilePath (grid_file_name);   // or original in the resources FS
@@ -486,18 +538,9 @@ AD1CCty::AD1CCty (Configuration const * configuration)
 
 void AD1CCty::reload(Configuration const * configuration)
 {
+  m_->wait ();
   m_->path_ = m_->impl::get_cty_path(configuration);
-  QFile file {m_->path_};
-
-  LOG_INFO(QString{"Loading CTY.DAT from %1"}.arg (m_->path_));
-
-  if (file.open (QFile::ReadOnly))
-  {
-    m_->impl::load_cty(file);
-    m_->cty_version_ = AD1CCty::lookup("VERSION").entity_name;
-    Q_EMIT cty_loaded(m_->cty_version_);
-    LOG_INFO(QString{"Loaded CTY.DAT version %1, %2"}.arg (m_->cty_version_date_).arg (m_->cty_version_));
-  }
+  m_->start_load (this);
 }
 
 AD1CCty::~AD1CCty ()
@@ -505,6 +548,12 @@ AD1CCty::~AD1CCty ()
 }
 
 auto AD1CCty::lookup (QString const& call) const -> Record
+{
+  m_->wait ();
+  return m_->lookup (call);
+}
+
+auto AD1CCty::impl::lookup (QString const& call) const -> Record
 {
   auto const& exact_search = call.toUpper ();
   if (!(exact_search.endsWith ("/MM") || exact_search.endsWith ("/AM")))
@@ -512,22 +561,22 @@ auto AD1CCty::lookup (QString const& call) const -> Record
       auto search_prefix = Radio::effective_prefix (exact_search);
       if (search_prefix != exact_search)
         {
-          auto p = m_->prefixes_.find (exact_search);
-          if (p != m_->prefixes_.end () && p->exact_)
+          auto p = prefixes_.find (exact_search);
+          if (p != prefixes_.end () && p->exact_)
             {
-              return m_->fixup (*p, *m_->lookup_entity (call, *p));
+              return fixup (*p, *lookup_entity (call, *p));
             }
         }
       while (search_prefix.size ())
         {
-          auto p = m_->prefixes_.find (search_prefix);
-          if (p != m_->prefixes_.end ())
+          auto p = prefixes_.find (search_prefix);
+          if (p != prefixes_.end ())
             {
-              impl::entity_by_id::iterator e = m_->lookup_entity (call, *p);
+              entity_by_id::iterator e = lookup_entity (call, *p);
               // always lookup WAE entities, we substitute them later in displaytext.cpp if "Include extra WAE entites" is not selected
               if (!p->exact_ || call.size () == search_prefix.size ())
                 {
-                  return m_->fixup (*p, *e);
+                  return fixup (*p, *e);
                 }
             }
           search_prefix = search_prefix.left (search_prefix.size () - 1);
@@ -538,6 +587,7 @@ auto AD1CCty::lookup (QString const& call) const -> Record
 
 auto AD1CCty::version () const -> QString
 {
+  m_->wait ();
   return m_->cty_version_date_;
 }
 
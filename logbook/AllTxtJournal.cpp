@@ -0,0 +1,323 @@
+#include "AllTxtJournal.hpp"
+
+#include <deque>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#if defined (Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "pimpl_impl.hpp"
+
+#include "moc_AllTxtJournal.cpp"
+
+namespace
+{
+  int const MAX_QUEUED {10000};                // lines
+  int const IDLE_CLOSE_MSEC {10000};
+  int const SYNC_PERIOD_MSEC {30000};
+  int const WAKE_MSEC {1000};                  // for idle housekeeping
+
+#if defined (Q_OS_WIN)
+  char const line_end[] {"\r\n"};
+#else
+  char const line_end[] {"\n"};
+#endif
+
+  bool sync_file (QFile& f)
+  {
+    if (!f.isOpen () || !f.flush ()) return false;
+#if defined (Q_OS_WIN)
+    return !_commit (f.handle ());
+#else
+    return !::fsync (f.handle ());
+#endif
+  }
+}
+
+class AllTxtJournal::impl final
+  : public QThread
+{
+public:
+  struct Entry
+  {
+    QString path;
+    QByteArray line;
+    bool remove;
+  };
+
+  explicit impl (AllTxtJournal * self)
+    : self_ {self}
+    , stop_ {false}
+    , max_size_ {0}
+    , sync_policy_ {SyncPeriodic}
+    , dropped_ {0}
+    , policy_ {SyncPeriodic}
+    , dirty_ {false}
+  {
+    start (QThread::LowPriority);
+  }
+
+  ~impl ()
+  {
+    {
+      QMutexLocker lock {&mutex_};
+      stop_ = true;
+      wake_.wakeOne ();
+    }
+    wait ();
+  }
+
+  void enqueue (Entry&& entry)
+  {
+    QMutexLocker lock {&mutex_};
+    // only lines may be dropped, never a removal
+    if (!entry.remove && queue_.size () >= static_cast<size_t> (MAX_QUEUED))
+      {
+        ++dropped_;
+        return;
+      }
+    queue_.push_back (std::move (entry));
+    wake_.wakeOne ();
+  }
+
+  void run () override;
+  void write (std::deque<Entry> const&, qint64 max_size);
+  void commit (QByteArray&);
+  bool open (QString const& path);
+  void rotate ();
+  void remove_files (QString const& path);
+  void sync ();
+  void close ();
+  void report (QString const& message) const
+  {
+    Q_EMIT self_->error (message);
+  }
+
+  AllTxtJournal * self_;
+
+  // shared, guarded by mutex_
+  QMutex mutex_;
+  QWaitCondition wake_;
+  std::deque<Entry> queue_;
+  bool stop_;
+  qint64 max_size_;
+  SyncPolicy sync_policy_;
+  int dropped_;
+
+  // writer thread only
+  QFile file_;
+  QString reported_;            // file that last failed to open
+  QElapsedTimer last_write_;
+  QElapsedTimer last_sync_;
+  SyncPolicy policy_;           // as of the current batch
+  bool dirty_;                  // written since the last sync
+};
+
+void AllTxtJournal::impl::run ()
+{
+  last_write_.start ();
+  last_sync_.start ();
+  QMutexLocker lock {&mutex_};
+  for (;;)
+    {
+      if (queue_.empty () && !stop_)
+        {
+          wake_.wait (&mutex_, WAKE_MSEC);
+        }
+      std::deque<Entry> batch;
+      batch.swap (queue_);
+      auto stopping = stop_;
+      auto max_size = max_size_;
+      policy_ = sync_policy_;
+      auto dropped = dropped_;
+      dropped_ = 0;
+      lock.unlock ();
+
+      if (dropped)
+        {
+          report (AllTxtJournal::tr ("%n line(s) could not be written to ALL.TXT, the writer fell behind", "", dropped));
+        }
+      write (batch, max_size);
+      if (file_.isOpen ())
+        {
+          if (dirty_ && (SyncEveryBatch == policy_
+                         || (SyncPeriodic == policy_ && last_sync_.elapsed () >= SYNC_PERIOD_MSEC)))
+            {
+              sync ();
+            }
+          if (stopping || last_write_.elapsed () >= IDLE_CLOSE_MSEC)
+            {
+              close ();
+            }
+        }
+
+      lock.relock ();
+      if (stopping && queue_.empty ())
+        {
+          break;
+        }
+    }
+}
+
+void AllTxtJournal::impl::write (std::deque<Entry> const& batch, qint64 max_size)
+{
+  QByteArray buffer;
+  QString failed;
+  for (auto const& entry : batch)
+    {
+      if (entry.remove)
+        {
+          commit (buffer);
+          remove_files (entry.path);
+          continue;
+        }
+      if (entry.path == failed)
+        {
+          continue;
+        }
+      if (!file_.isOpen () || entry.path != file_.fileName ())
+        {
+          commit (buffer);
+          if (!open (entry.path))
+            {
+              failed = entry.path;
+              continue;
+            }
+        }
+      auto size = file_.size () + buffer.size ();
+      if (max_size > 0 && size > 0 && size + entry.line.size () >= max_size)
+        {
+          commit (buffer);
+          rotate ();
+          if (!file_.isOpen ())
+            {
+              failed = entry.path;
+              continue;
+            }
+        }
+      buffer += entry.line;
+      buffer += line_end;
+    }
+  commit (buffer);
+}
+
+// append buffered lines in one write
+void AllTxtJournal::impl::commit (QByteArray& buffer)
+{
+  if (buffer.isEmpty ()) return;
+  if (file_.write (buffer) != buffer.size () || !file_.flush ())
+    {
+      report (AllTxtJournal::tr ("Cannot write to \"%1\": %2")
+              .arg (file_.fileName ()).arg (file_.errorString ()));
+    }
+  buffer.clear ();
+  dirty_ = true;
+  last_write_.restart ();
+}
+
+bool AllTxtJournal::impl::open (QString const& path)
+{
+  close ();
+  file_.setFileName (path);
+  if (!file_.open (QIODevice::WriteOnly | QIODevice::Append))
+    {
+      if (path != reported_)
+        {
+          report (AllTxtJournal::tr ("Cannot open \"%1\" for append: %2")
+                  .arg (path).arg (file_.errorString ()));
+          reported_ = path;
+        }
+      return false;
+    }
+  reported_.clear ();
+  return true;
+}
+
+// FILE.TXT becomes FILE-nnn.TXT, for the lowest unused nnn
+void AllTxtJournal::impl::rotate ()
+{
+  auto path = file_.fileName ();
+  close ();
+  QFileInfo fi {path};
+  auto dir = fi.dir ();
+  auto suffix = fi.suffix ().size () ? "." + fi.suffix () : QString {};
+  QString name;
+  for (int n = 1; name.isEmpty () || dir.exists (name); ++n)
+    {
+      name = fi.completeBaseName () + QString {"-%1"}.arg (n, 3, 10, QChar {'0'}) + suffix;
+    }
+  if (!dir.rename (fi.fileName (), name))
+    {
+      report (AllTxtJournal::tr ("Cannot rename \"%1\" to \"%2\"").arg (path).arg (name));
+    }
+  open (path);
+}
+
+void AllTxtJournal::impl::remove_files (QString const& path)
+{
+  if (file_.fileName () == path)
+    {
+      close ();
+    }
+  QFile::remove (path);
+}
+
+void AllTxtJournal::impl::sync ()
+{
+  sync_file (file_);
+  dirty_ = false;
+  last_sync_.restart ();
+}
+
+void AllTxtJournal::impl::close ()
+{
+  if (dirty_ && SyncNever != policy_)
+    {
+      sync ();
+    }
+  dirty_ = false;
+  file_.close ();
+}
+
+AllTxtJournal::AllTxtJournal (QObject * parent)
+  : QObject {parent}
+  , m_ {this}
+{
+}
+
+AllTxtJournal::~AllTxtJournal ()
+{
+}
+
+void AllTxtJournal::set_max_size (qint64 bytes)
+{
+  QMutexLocker lock {&m_->mutex_};
+  m_->max_size_ = bytes;
+}
+
+void AllTxtJournal::set_sync_policy (SyncPolicy policy)
+{
+  QMutexLocker lock {&m_->mutex_};
+  m_->sync_policy_ = policy;
+}
+
+void AllTxtJournal::append (QString const& path, QString const& line)
+{
+  m_->enqueue ({path, line.toLocal8Bit (), false});
+}
+
+void AllTxtJournal::remove (QString const& path)
+{
+  m_->enqueue ({path, QByteArray {}, true});
+}
@@ -0,0 +1,53 @@
+#ifndef ALL_TXT_JOURNAL_HPP_
+#define ALL_TXT_JOURNAL_HPP_
+
+#include <QObject>
+#include "pimpl_h.hpp"
+
+class QString;
+
+//
+// AllTxtJournal - append lines to ALL.TXT and friends on a thread of
+//                 its own
+//
+// Lines are queued without blocking the caller and written in
+// batches, keeping the file open between batches and closing it when
+// idle. A full queue drops lines rather than stall the GUI. The data
+// are handed to the OS after every batch so that other programs
+// reading the file see new lines straight away; how often they are
+// forced to disk is set by the sync policy.
+//
+// A file can be rotated when it reaches a maximum size, FILE.TXT is
+// renamed FILE-001.TXT, FILE-002.TXT, and so on and a new one is
+// started. Time based splits are done by the caller choosing file
+// names, as for the yearly and monthly ALL.TXT options.
+//
+class AllTxtJournal final
+  : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum SyncPolicy {SyncNever, SyncPeriodic, SyncEveryBatch};
+
+  explicit AllTxtJournal (QObject * parent = nullptr);
+  ~AllTxtJournal ();            // writes out anything queued
+
+  void set_max_size (qint64 bytes); // rotate beyond this, 0 for never
+  void set_sync_policy (SyncPolicy);
+
+  // queue a line for appending to the file at path, may be called
+  // from any thread
+  void append (QString const& path, QString const& line);
+
+  // queue the deletion of the file at path, never dropped
+  void remove (QString const& path);
+
+  Q_SIGNAL void error (QString const& message) const;
+
+private:
+  class impl;
+  pimpl<impl> m_;
+};
+
+#endif
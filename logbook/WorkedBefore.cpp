@@ -1,13 +1,9 @@
 #include "WorkedBefore.hpp"
 
-#include <functional>
+#include <algorithm>
 #include <stdexcept>
-#include <boost/functional/hash.hpp>
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/key_extractors.hpp>
-#include <boost/range/iterator_range.hpp>
+#include <utility>
+#include <vector>
 #include <QCoreApplication>
 #include <QtConcurrent/QtConcurrentRun>
 #include <QFuture>
@@ -15,6 +11,7 @@
 #include <QChar>
 #include <QString>
 #include <QByteArray>
+#include <QHash>
 #include <QStandardPaths>
 #include <QDir>
 #include <QFileInfo>
@@ -29,198 +26,156 @@
 
 #include "moc_WorkedBefore.cpp"
 
-using namespace boost::multi_index;
+// Mode and band ids in queries.  A mode or band not given matches
+// any, one never logged cannot have been worked.
+static int const any_id {-1};
+static int const unknown_id {-2};
 
-// hash function for QString members in hashed indexes
-inline
-std::size_t hash_value (QString const& s)
+//
+// Bands and modes interned to small integers in the order first
+// seen.
+//
+class interned_strings
 {
-  return std::hash<QString> {} (s);
-}
+public:
+  int intern (QString const& s)
+  {
+    auto p = ids_.constFind (s);
+    if (p != ids_.cend ()) return *p;
+    int id = ids_.size ();
+    ids_.insert (s, id);
+    return id;
+  }
+
+  // QString::toUpper () returns a shared copy when there is nothing
+  // to change, so the usual upper case arguments cost no allocation
+  int find (QString const& s) const
+  {
+    if (!s.size ()) return any_id;
+    auto p = ids_.constFind (s.toUpper ());
+    return p != ids_.cend () ? *p : unknown_id;
+  }
+
+private:
+  QHash<QString, int> ids_;
+};
 
 //
-// worked before set element
+// Worked before status of one call, grid, entity, continent or
+// zone: for each mode worked a bitmask of the bands worked on it,
+// and the union of those masks.  Band ids past the width of the
+// mask, which no real log needs, are kept as (mode, band) pairs.
 //
-struct worked_entry
+class worked_status
 {
-  explicit worked_entry (QString const& call, QString const& grid, QString const& band
-                         , QString const& mode, QString const& country, AD1CCty::Continent continent
-                         , int CQ_zone, int ITU_zone)
-    : call_ {call}
-    , grid_ {grid}
-    , band_ {band}
-    , mode_ {mode}
-    , country_ {country}
-    , continent_ {continent}
-    , CQ_zone_ {CQ_zone}
-    , ITU_zone_ {ITU_zone}
+public:
+  // returns true if mode and band had not been worked before
+  bool add (int mode, int band)
   {
+    auto p = std::lower_bound (modes_.begin (), modes_.end (), mode
+                               , [] (mode_bands const& m, int id) {return m.first < id;});
+    if (p == modes_.end () || p->first != mode)
+      {
+        p = modes_.insert (p, {mode, 0});
+      }
+    if (band < band_bits)
+      {
+        auto bit = quint64 {1} << band;
+        bool is_new = !(p->second & bit);
+        p->second |= bit;
+        bands_ |= bit;
+        return is_new;
+      }
+    if (std::find (other_bands_.begin (), other_bands_.end (), std::make_pair (mode, band)) != other_bands_.end ())
+      {
+        return false;
+      }
+    other_bands_.emplace_back (mode, band);
+    return true;
+  }
+
+  bool worked (int mode, int band) const
+  {
+    if (any_id == mode)
+      {
+        if (any_id == band) return true;
+        if (band < band_bits) return bands_ & (quint64 {1} << band);
+        return std::any_of (other_bands_.begin (), other_bands_.end ()
+                            , [band] (std::pair<int, int> const& mb) {return mb.second == band;});
+      }
+    auto p = std::lower_bound (modes_.begin (), modes_.end (), mode
+                               , [] (mode_bands const& m, int id) {return m.first < id;});
+    if (p == modes_.end () || p->first != mode) return false;
+    if (any_id == band) return true;
+    if (band < band_bits) return p->second & (quint64 {1} << band);
+    return std::find (other_bands_.begin (), other_bands_.end (), std::make_pair (mode, band)) != other_bands_.end ();
   }
 
-  QString call_;
-  QString grid_;
-  QString band_;
-  QString mode_;
-  QString country_;
-  AD1CCty::Continent continent_;
-  int CQ_zone_;
-  int ITU_zone_;
+private:
+  static int const band_bits {64};
+  using mode_bands = std::pair<int, quint64>;
+
+  quint64 bands_ {0};
+  std::vector<mode_bands> modes_;               // ordered by mode id
+  std::vector<std::pair<int, int>> other_bands_;
 };
 
-bool operator == (worked_entry const& lhs, worked_entry const& rhs)
+template<typename Key>
+class worked_index
 {
-  return
-    lhs.continent_ == rhs.continent_  // check 1st as it is fast
-    && lhs.CQ_zone_ == rhs.CQ_zone_   // ditto
-    && lhs.ITU_zone_ == rhs.ITU_zone_ // ditto
-    && lhs.call_ == rhs.call_         // check the rest in decreasing
-    && lhs.grid_ == rhs.grid_         // domain size order to shortcut
-    && lhs.country_ == rhs.country_   // differences as quickly as possible
-    && lhs.band_ == rhs.band_
-    && lhs.mode_ == rhs.mode_;
-}
+public:
+  bool add (Key const& key, int mode, int band)
+  {
+    return status_[key].add (mode, band);
+  }
 
-std::size_t hash_value (worked_entry const& we)
-{
-  std::size_t seed {0};
-  boost::hash_combine (seed, we.call_);
-  boost::hash_combine (seed, we.grid_);
-  boost::hash_combine (seed, we.band_);
-  boost::hash_combine (seed, we.mode_);
-  boost::hash_combine (seed, we.country_);
-  boost::hash_combine (seed, we.continent_);
-  boost::hash_combine (seed, we.CQ_zone_);
-  boost::hash_combine (seed, we.ITU_zone_);
-  return seed;
-}
+  bool worked (Key const& key, int mode, int band) const
+  {
+    if (unknown_id == mode || unknown_id == band) return false;
+    auto p = status_.constFind (key);
+    return p != status_.cend () && p->worked (mode, band);
+  }
 
-#if !defined (QT_NO_DEBUG_STREAM)
-QDebug operator << (QDebug dbg, worked_entry const& e)
-{
-  QDebugStateSaver saver {dbg};
-  dbg.nospace () << "worked_entry("
-                 << e.call_ << ", "
-                 << e.grid_ << ", "
-                 << e.band_ << ", "
-                 << e.mode_ << ", "
-                 << e.country_ << ", "
-                 << e.continent_ << ", "
-                 << e.CQ_zone_ << ", "
-                 << e.ITU_zone_ << ')';
-  return dbg;
-}
-#endif
+private:
+  QHash<Key, worked_status> status_;
+};
 
-// less then predidate for the Continent enum class, needed for
-// ordered indexes
-struct Continent_less
+//
+// The worked before database, one index per kind of key.  Calls,
+// grids, fields and entities are upper case as stored; the grid index
+// holds four character squares and the field index their first two
+// characters, for highlight_only_fields.
+//
+struct worked_before_database_type
 {
-  bool operator () (AD1CCty::Continent lhs, AD1CCty::Continent rhs) const
+  void add (QString const& call, QString const& grid, QString const& band, QString const& mode
+            , AD1CCty::Record const& entity)
   {
-    return static_cast<int> (lhs) < static_cast<int> (rhs);
+    auto mode_id = modes_.intern (mode);
+    auto band_id = bands_.intern (band);
+    if (calls_.add (call, mode_id, band_id)) ++size_;
+    grids_.add (grid, mode_id, band_id);
+    fields_.add (grid.left (2), mode_id, band_id);
+    entities_.add (entity.entity_name, mode_id, band_id);
+    continents_.add (static_cast<int> (entity.continent), mode_id, band_id);
+    CQ_zones_.add (entity.CQ_zone, mode_id, band_id);
+    ITU_zones_.add (entity.ITU_zone, mode_id, band_id);
   }
-};
 
-// index tags
-struct call_mode_band {};
-struct call_band {};
-struct grid_mode_band {};
-struct grid_band {};
-struct entity_mode_band {};
-struct entity_band {};
-struct continent_mode_band {};
-struct continent_band {};
-struct CQ_zone_mode_band {};
-struct CQ_zone_band {};
-struct ITU_zone_mode_band {};
-struct ITU_zone_band {};
-
-// set with multiple ordered unique indexes that allow for optimally
-// efficient determination of various categories of worked before
-// status
-typedef multi_index_container<
-  worked_entry,
-  indexed_by<
-    // basic unordered set constraint - we don't need duplicate worked entries
-    hashed_unique<identity<worked_entry>>,
-
-    //
-    // The following indexes are used to discover worked before stuff.
-    //
-    // They are ordered so as to support partial lookups and
-    // non-unique because container inserts must be valid for all
-    // indexes.
-    //
-
-    // call+mode+band
-    ordered_non_unique<tag<call_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::call_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // call+band
-    ordered_non_unique<tag<call_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::call_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // grid+mode+band
-    ordered_non_unique<tag<grid_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::grid_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // grid+band
-    ordered_non_unique<tag<grid_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::grid_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // country+mode+band
-    ordered_non_unique<tag<entity_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::country_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // country+band
-    ordered_non_unique<tag<entity_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, QString, &worked_entry::country_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // continent+mode+band
-    ordered_non_unique<tag<continent_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, AD1CCty::Continent, &worked_entry::continent_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> >,
-                       composite_key_compare<Continent_less, std::less<QString>, std::less<QString> > >,
-    // continent+band
-    ordered_non_unique<tag<continent_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, AD1CCty::Continent, &worked_entry::continent_>,
-                                     member<worked_entry, QString, &worked_entry::band_> >,
-                       composite_key_compare<Continent_less, std::less<QString> > >,
-    // CQ-zone+mode+band
-    ordered_non_unique<tag<CQ_zone_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, int, &worked_entry::CQ_zone_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // CQ-zone+band
-    ordered_non_unique<tag<CQ_zone_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, int, &worked_entry::CQ_zone_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // ITU-zone+mode+band
-    ordered_non_unique<tag<ITU_zone_mode_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, int, &worked_entry::ITU_zone_>,
-                                     member<worked_entry, QString, &worked_entry::mode_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > >,
-    // ITU-zone+band
-    ordered_non_unique<tag<ITU_zone_band>,
-                       composite_key<worked_entry,
-                                     member<worked_entry, int, &worked_entry::ITU_zone_>,
-                                     member<worked_entry, QString, &worked_entry::band_> > > >
-  > worked_before_database_type;
+  // number of distinct call, mode and band combinations
+  std::size_t size () const {return size_;}
+
+  interned_strings modes_;
+  interned_strings bands_;
+  worked_index<QString> calls_;
+  worked_index<QString> grids_;
+  worked_index<QString> fields_;
+  worked_index<QString> entities_;
+  worked_index<int> continents_;
+  worked_index<int> CQ_zones_;
+  worked_index<int> ITU_zones_;
+  std::size_t size_ {0};
+};
 
 namespace
 {
@@ -342,14 +297,11 @@ namespace
                           {
                             mode = extractField (record, "SUBMODE").toUpper ();
                           }
-                        worked.emplace (call.toUpper ()
-                                        , extractField (record, "GRIDSQUARE").left (4).toUpper () // not interested in 6-digit grids
-                                        , extractField (record, "BAND").toUpper ()
-                                        , mode
-                                        , entity.entity_name
-                                        , entity.continent
-                                        , entity.CQ_zone
-                                        , entity.ITU_zone);
+                        worked.add (call.toUpper ()
+                                    , extractField (record, "GRIDSQUARE").left (4).toUpper () // not interested in 6-digit grids
+                                    , extractField (record, "BAND").toUpper ()
+                                    , mode
+                                    , entity);
                       }
                   }
               }
@@ -376,6 +328,12 @@ public:
   void reload ()
   {
     prefixes_.reload (configuration_);
+    load ();
+  }
+
+  // the loader looks up entities so waits for cty.dat to be parsed
+  void load ()
+  {
     async_loader_ = QtConcurrent::run (loader, path_, &prefixes_);
     loader_watcher_.setFuture (async_loader_);
   }
@@ -408,7 +366,7 @@ WorkedBefore::WorkedBefore (Configuration const * configuration)
       LOG_DEBUG(QString{"WorkedBefore::reload: CTY.DAT version %1"}.arg (cty_ver));
       Q_EMIT finished_loading (n, cty_ver, error);
     });
-  reload ();
+  m_->load ();                  // cty.dat is already being loaded
 }
 
 QString WorkedBefore::cty_version () const
@@ -481,230 +439,50 @@ bool WorkedBefore::add (QString const& call
 #endif
                  ;
         }
-      m_->worked_.emplace (call.toUpper (), grid.left (4).toUpper (), band.toUpper (), mode.toUpper ()
-                           , entity.entity_name, entity.continent, entity.CQ_zone, entity.ITU_zone);
+      m_->worked_.add (call.toUpper (), grid.left (4).toUpper (), band.toUpper (), mode.toUpper (), entity);
     }
   return true;
 }
 
 bool WorkedBefore::country_worked (QString const& country, QString const& mode, QString const& band) const
 {
-  if (mode.size ())
-    {
-      if (band.size ())
-        {
-          return
-            country.size ()
-            && m_->worked_.get<entity_mode_band> ().end ()
-            != m_->worked_.get<entity_mode_band> ().find (std::make_tuple (country, mode.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return
-            country.size ()
-            && m_->worked_.get<entity_mode_band> ().end ()
-            != m_->worked_.get<entity_mode_band> ().find (std::make_tuple (country, mode.toUpper ()));
-        }
-    }
-  else
-    {
-      if (band.size ())
-        {
-          return
-            country.size ()
-            && m_->worked_.get<entity_band> ().end ()
-            != m_->worked_.get<entity_band> ().find (std::make_tuple (country, band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return
-            country.size ()
-            && m_->worked_.get<entity_band> ().end ()
-            != m_->worked_.get<entity_band> ().find (country);
-        }
-    }
+  auto const& worked = m_->worked_;
+  return country.size ()
+    && worked.entities_.worked (country, worked.modes_.find (mode), worked.bands_.find (band));
 }
 
 bool WorkedBefore::grid_worked (QString const& grid, QString const& mode, QString const& band) const
 {
-  auto gridsquare = grid.left (4).toUpper ();
+  auto const& worked = m_->worked_;
+  auto mode_id = worked.modes_.find (mode);
+  auto band_id = worked.bands_.find (band);
   if (m_->configuration_->highlight_only_fields ())
     {
-      // can't use a direct set find operation or a set operation with
-      // a (CompatibleKey, CompatibleCompare) concept so we must
-      // partially scan the index
-      auto range = boost::make_iterator_range (
-                                               m_->worked_.get<grid_mode_band> ().lower_bound (gridsquare.left (2))
-                                               , m_->worked_.get<grid_mode_band> ().upper_bound (gridsquare.left (2) + "99"));
-      for (worked_entry const& worked : range)
-        {
-          if ((!mode.size () || mode.toUpper () == worked.mode_)
-              && (!band.size () || worked.band_ == band.toUpper ()))
-            {
-              return true;
-            }
-        }
-    }
-  else
-    {
-      if (mode.size ())
-        {
-          if (band.size ())
-            {
-              return m_->worked_.get<grid_mode_band> ().end ()
-                != m_->worked_.get<grid_mode_band> ().find (std::make_tuple (gridsquare, mode.toUpper (), band.toUpper ()));
-            }
-          else
-            {
-              // partial key lookup
-              return m_->worked_.get<grid_mode_band> ().end ()
-                != m_->worked_.get<grid_mode_band> ().find (std::make_tuple (gridsquare, mode.toUpper ()));
-            }
-        }
-      else
-        {
-          if (band.size ())
-            {
-              return m_->worked_.get<grid_band> ().end ()
-                != m_->worked_.get<grid_band> ().find (std::make_tuple (gridsquare, band.toUpper ()));
-            }
-          else
-            {
-              // partial key lookup
-              return m_->worked_.get<grid_band> ().end ()
-                != m_->worked_.get<grid_band> ().find (gridsquare);
-            }
-        }
+      return worked.fields_.worked (grid.left (2).toUpper (), mode_id, band_id);
     }
-  return false;
+  return worked.grids_.worked (grid.left (4).toUpper (), mode_id, band_id);
 }
 
 bool WorkedBefore::call_worked (QString const& call, QString const& mode, QString const& band) const
 {
-  if (mode.size ())
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<call_mode_band> ().end ()
-            != m_->worked_.get<call_mode_band> ().find (std::make_tuple (call.toUpper (), mode.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<call_mode_band> ().end ()
-            != m_->worked_.get<call_mode_band> ().find (std::make_tuple (call.toUpper (), mode.toUpper ()));
-        }
-    }
-  else
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<call_band> ().end ()
-            != m_->worked_.get<call_band> ().find (std::make_tuple (call.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<call_band> ().end ()
-            != m_->worked_.get<call_band> ().find (std::make_tuple (call.toUpper ()));
-        }
-    }
+  auto const& worked = m_->worked_;
+  return worked.calls_.worked (call.toUpper (), worked.modes_.find (mode), worked.bands_.find (band));
 }
 
 bool WorkedBefore::continent_worked (Continent continent, QString const& mode, QString const& band) const
 {
-  if (mode.size ())
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<continent_mode_band> ().end ()
-            != m_->worked_.get<continent_mode_band> ().find (std::make_tuple (continent, mode.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<continent_mode_band> ().end ()
-            != m_->worked_.get<continent_mode_band> ().find (std::make_tuple (continent, mode.toUpper ()));
-        }
-    }
-  else
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<continent_band> ().end ()
-            != m_->worked_.get<continent_band> ().find (std::make_tuple (continent, band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<continent_band> ().end ()
-            != m_->worked_.get<continent_band> ().find (continent);
-        }
-    }
+  auto const& worked = m_->worked_;
+  return worked.continents_.worked (static_cast<int> (continent), worked.modes_.find (mode), worked.bands_.find (band));
 }
 
 bool WorkedBefore::CQ_zone_worked (int CQ_zone, QString const& mode, QString const& band) const
 {
-  if (mode.size ())
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<CQ_zone_mode_band> ().end ()
-            != m_->worked_.get<CQ_zone_mode_band> ().find (std::make_tuple (CQ_zone, mode.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<CQ_zone_mode_band> ().end ()
-            != m_->worked_.get<CQ_zone_mode_band> ().find (std::make_tuple (CQ_zone, mode.toUpper ()));
-        }
-    }
-  else
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<CQ_zone_band> ().end ()
-            != m_->worked_.get<CQ_zone_band> ().find (std::make_tuple (CQ_zone, band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<CQ_zone_band> ().end ()
-            != m_->worked_.get<CQ_zone_band> ().find (CQ_zone);
-        }
-    }
+  auto const& worked = m_->worked_;
+  return worked.CQ_zones_.worked (CQ_zone, worked.modes_.find (mode), worked.bands_.find (band));
 }
 
 bool WorkedBefore::ITU_zone_worked (int ITU_zone, QString const& mode, QString const& band) const
 {
-  if (mode.size ())
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<ITU_zone_mode_band> ().end ()
-            != m_->worked_.get<ITU_zone_mode_band> ().find (std::make_tuple (ITU_zone, mode.toUpper (), band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<ITU_zone_mode_band> ().end ()
-            != m_->worked_.get<ITU_zone_mode_band> ().find (std::make_tuple (ITU_zone, mode.toUpper ()));
-        }
-    }
-  else
-    {
-      if (band.size ())
-        {
-          return m_->worked_.get<ITU_zone_band> ().end ()
-            != m_->worked_.get<ITU_zone_band> ().find (std::make_tuple (ITU_zone, band.toUpper ()));
-        }
-      else
-        {
-          // partial key lookup
-          return m_->worked_.get<ITU_zone_band> ().end ()
-            != m_->worked_.get<ITU_zone_band> ().find (ITU_zone);
-        }
-    }
+  auto const& worked = m_->worked_;
+  return worked.ITU_zones_.worked (ITU_zone, worked.modes_.find (mode), worked.bands_.find (band));
 }
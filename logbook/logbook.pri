@@ -3,10 +3,12 @@ SOURCES += \
   logbook/logbook.cpp \
   logbook/AD1CCty.cpp \
   logbook/WorkedBefore.cpp \
+  logbook/AllTxtJournal.cpp \
   logbook/Multiplier.cpp
 
 HEADERS  += \
   logbook/WorkedBefore.hpp \
+  logbook/AllTxtJournal.hpp \
   logbook/logbook.h \
   logbook/countriesworked.h \
   logbook/AD1CCty.hpp \
@@ -34,6 +34,7 @@
 #include <QByteArray>
 #include <QBitArray>
 #include <QMetaType>
+#include <QTimer>
 
 #include "ExceptionCatchingApplication.hpp"
 #include "Logger.hpp"
@@ -44,6 +45,7 @@
 #include "SettingsGroup.hpp"
 //#include "TraceFile.hpp"
 #include "WSJTXLogging.hpp"
+#include "StartupTimer.hpp"
 #include "MultiSettings.hpp"
 #include "widgets/mainwindow.h"
 #include "commons.h"
@@ -217,7 +219,9 @@ int main(int argc, char *argv[])
       // now we have the application name we can open the logging and settings
       WSJTXLogging lg;
       LOG_INFO (program_title (revision ()) << " - Program startup");
+      StartupTimer::start ();
       MultiSettings multi_settings {parser.value (cfg_option)};
+      StartupTimer::mark ("settings");
 
       // find the temporary files path
       QDir temp_dir {QStandardPaths::writableLocation (QStandardPaths::TempLocation)};
@@ -255,8 +259,11 @@ int main(int argc, char *argv[])
             }
         }
 
+      StartupTimer::mark ("instance lock");
+
       // load UI translations
       L10nLoader l10n {&a, locale, parser.value (lang_option)};
+      StartupTimer::mark ("translations");
 
       // Create a unique writeable temporary directory in a suitable location
       bool temp_ok {false};
@@ -286,6 +293,7 @@ int main(int argc, char *argv[])
             }
         }
       while (!temp_ok);
+      StartupTimer::mark ("temporary directory");
 
       SplashScreen splash;
       {
@@ -303,6 +311,7 @@ int main(int argc, char *argv[])
             a.processEvents ();
           }
       }
+      StartupTimer::mark ("splash screen");
 
       // create writeable data directory if not already there
       auto writeable_data_dir = QDir {QStandardPaths::writableLocation (QStandardPaths::DataLocation)};
@@ -330,6 +339,7 @@ int main(int argc, char *argv[])
       // db.exec ("PRAGMA synchronous=OFF"); // system crash risk
       // db.exec ("PRAGMA journal_mode=MEMORY"); // application crash risk
       db.exec ("PRAGMA locking_mode=EXCLUSIVE");
+      StartupTimer::mark ("database");
 
       int result;
       auto const& original_style_sheet = a.styleSheet ();
@@ -416,6 +426,7 @@ int main(int argc, char *argv[])
           mem_jt9.lock ();
           memset(mem_jt9.data(),0,sizeof(struct dec_data)); //Zero all decoding params in shared memory
           mem_jt9.unlock ();
+          StartupTimer::mark ("shared memory");
 
           unsigned downSampleFactor;
           {
@@ -440,6 +451,11 @@ int main(int argc, char *argv[])
           MainWindow w(temp_dir, multiple, &multi_settings, &mem_jt9, downSampleFactor, &splash, env);
           w.show();
           splash.raise ();
+          // the first pass of the event loop paints the main window
+          QTimer::singleShot (0, [] {
+              StartupTimer::mark ("first show");
+              StartupTimer::report ();
+            });
           QObject::connect (&a, SIGNAL (lastWindowClosed()), &a, SLOT (quit()));
           result = a.exec();
 
@@ -8,6 +8,7 @@ subroutine map65a(dd,ss,savg,newdat,nutc,fcenter,ntol,idphi,nfa,nfb,        &
 
   use wideband_sync
   use timer_module, only: timer
+  include 'timer_common.inc'
 
   parameter (MAXMSG=1000)            !Size of decoded message list
   parameter (NSMAX=60*96000)
@@ -24,7 +25,13 @@ subroutine map65a(dd,ss,savg,newdat,nutc,fcenter,ntol,idphi,nfa,nfb,        &
   integer indx(MAXMSG),nsiz(MAXMSG)
   logical done(MAXMSG)
   logical xpol,bq65,q65b_called
-  logical candec(MAX_CANDIDATES)
+  logical candec(MAX_CANDIDATES),ltried(MAX_CANDIDATES)
+  integer ipkc(MAX_CANDIDATES),k0c(MAX_CANDIDATES)
+  integer nsnrc(MAX_CANDIDATES),nfreqc(MAX_CANDIDATES)
+  real poldegc(MAX_CANDIDATES),xdtc(MAX_CANDIDATES)
+  character*37 msgc(MAX_CANDIDATES)
+  character*3 cqc(MAX_CANDIDATES)
+  character*12 mycall1
   logical ldecoded
   character decoded*22,blank*22,cmode*2
   real short(3,NFFT)                 !SNR dt ipol for potential shorthands
@@ -409,20 +416,37 @@ subroutine map65a(dd,ss,savg,newdat,nutc,fcenter,ntol,idphi,nfa,nfb,        &
      if(nqd.eq.1 .and. nagain.eq.1) go to 900
 
      if(nqd.eq.0 .and. bq65) then
-! Do the wideband Q65 decode        
+! Do the wideband Q65 decode.  Candidates are decoded in parallel, each
+! thread having its own copy of the Q65 decoder state, and the results
+! are then reported in candidate order.
+        if(mycall(1:1).ne.' ') mycall1=mycall
+        ltried=.false.
+        !$omp parallel do schedule(dynamic) default(shared)                 &
+        !$omp copyin(/timer_private/) private(icand,f0)
         do icand=1,ncand
            if(cand(icand)%iflip.ne.0) cycle    !Do only Q65 candidates here
            if(candec(icand)) cycle             !Skip if already decoded
+           f0=cand(icand)%f
+           call timer('q65b    ',0)
+           call q65b_decode(nutc,nqd,nfsample,mousedf,ntol,xpol,mycall1,    &
+                hiscall,hisgrid,mode_q65,f0,fqso,newdat,nagain,max_drift,  &
+                ipkc(icand),k0c(icand),poldegc(icand),nsnrc(icand),        &
+                xdtc(icand),nfreqc(icand),msgc(icand),cqc(icand))
+           call timer('q65b    ',1)
+           ltried(icand)=.true.
+        enddo  ! icand
+        !$omp end parallel do
+
+        do icand=1,ncand
+           if(.not.ltried(icand)) cycle
            freq=cand(icand)%f+nkhz_center-48.0-1.27046
 !###! If here at nqd=1, do only candidates at mousefqso +/- ntol
 !###           if(nqd.eq.1 .and. abs(freq-mousefqso).gt.0.001*ntol) cycle
            ikhz=nint(freq)
-           f0=cand(icand)%f
-           call timer('q65b    ',0)
-           call q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol, &
-                xpol,mycall,mygrid,hiscall,hisgrid,mode_q65,f0,fqso,newdat,   &
-                nagain,max_drift,nhsym,ndop00,idec)
-           call timer('q65b    ',1)
+           call q65b_report(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,     &
+                mousedf,ntol,xpol,mygrid,mode_q65,newdat,ndop00,           &
+                ipkc(icand),k0c(icand),poldegc(icand),nsnrc(icand),        &
+                xdtc(icand),nfreqc(icand),msgc(icand),cqc(icand),idec)
            if(idec.ge.0) candec(icand)=.true.
         enddo  ! icand
      endif
@@ -9,44 +9,78 @@ subroutine q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,xpol, &
 ! orthogonal polarization.  Decoded messages are sent back to the GUI
 ! on stdout.
 
-!  use wavhdr
+! The work is done by q65b_decode(), which may run for several
+! candidates at once, and q65b_report(), which must be called for
+! candidates one at a time, in order.
+
+  logical xpol
+  real*8 fcenter
+  character*12 mycall0,hiscall0
+  character*12 mycall,hiscall
+  character*6 mygrid,hisgrid
+  character*4 grid4
+  character*37 msg
+  character*3 cq
+  save mycall,hiscall,grid4
+
+  if(mycall0(1:1).ne.' ') mycall=mycall0
+  if(hiscall0(1:1).ne.' ') hiscall=hiscall0
+  if(hisgrid(1:4).ne.'    ') grid4=hisgrid(1:4)
+
+  call q65b_decode(nutc,nqd,nfsample,mousedf,ntol,xpol,mycall,hiscall0,     &
+       hisgrid,mode_q65,f0,fqso,newdat,nagain,max_drift,ipk,k0,poldeg,     &
+       nsnr,xdt,nfreq,msg,cq)
+  call q65b_report(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol, &
+       xpol,mygrid,mode_q65,newdat,ndop00,ipk,k0,poldeg,nsnr,xdt,nfreq,msg, &
+       cq,idec)
+
+  return
+end subroutine q65b
+
+subroutine q65b_decode(nutc,nqd,nfsample,mousedf,ntol,xpol,mycall,hiscall, &
+     hisgrid,mode_q65,f0,fqso,newdat,nagain,max_drift,ipk,k0,poldeg,nsnr,  &
+     xdt,nfreq,msg,cq)
+
+! Find the best frequency and polarization for candidate f0, extract
+! the 12 kHz audio around it and run the Q65 decoder.  Safe to call
+! from several threads at once: the results are returned rather than
+! reported.
+
+! Output: ipk    index into sync() of the candidate
+!         k0     index in ca() of the audio passband
+!         poldeg polarization angle used, degrees
+!         nsnr   SNR of the decode, -99 if none
+!         xdt    DT of the decode
+!         nfreq  audio frequency of the decode, Hz
+!         msg    decoded message
+!         cq     decode type flags, blank if none
+
   use q65_decode
   use wideband_sync
-  use timer_module, only: timer
 
   parameter (MAXFFT1=5376000)              !56*96000
   parameter (MAXFFT2=336000)               !56*6000 (downsampled by 1/16)
-  parameter (NMAX=60*12000)
   parameter (RAD=57.2957795)
-!  type(hdr) h                            !Header for the .wav file
-  integer*2 iwave(60*12000)
+  integer*2, allocatable :: iwave(:)
   complex ca(MAXFFT1),cb(MAXFFT1)          !FFTs of raw x,y data
-  complex cx(0:MAXFFT2-1),cy(0:MAXFFT2-1),cz(0:MAXFFT2)
+  complex, allocatable :: cx(:),cy(:),cz(:)
   logical xpol,ldecoded
   integer ipk1(1)
-  real*8 fcenter,freq0,freq1
-  character*12 mycall0,hiscall0
   character*12 mycall,hiscall
-  character*6 mygrid,hisgrid
-  character*4 grid4
-  character*28 msg00
-  character*80 line
-  character*80 wsjtx_dir
-  character*1 cp,cmode*2
+  character*6 hisgrid
+  character*37 msg
+  character*3 cq
   common/cacb/ca,cb
   common/early/nhsym1,nhsym2,ldecoded(32768)
-  common/decodes/ndecodes
-  data nutc00/-1/,msg00/'                            '/
-  save
-
-  if(newdat.eq.1) nutc00=-1
-  open(9,file='wsjtx_dir.txt',status='old')
-  read(9,'(a)') wsjtx_dir                      !Establish the working directory
-  close(9)
 
-  if(mycall0(1:1).ne.' ') mycall=mycall0
-  if(hiscall0(1:1).ne.' ') hiscall=hiscall0
-  if(hisgrid(1:4).ne.'    ') grid4=hisgrid(1:4)
+  ipk=1
+  k0=0
+  poldeg=0.
+  nsnr=-99                              !Default snr for no decode
+  xdt=0.
+  nfreq=0
+  msg=' '
+  cq='   '
 
 ! Find best frequency and ipol from sync_dat, the "orange sync curve".
   df3=96000.0/32768.0
@@ -55,7 +89,7 @@ subroutine q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,xpol, &
   ib=nint(ifreq+ntol/df3)
   ipk1=maxloc(sync(ia:ib)%ccfmax)
   ipk=ia+ipk1(1)-1
-  if(ldecoded(ipk)) go to 900
+  if(ldecoded(ipk)) return
   snr1=sync(ipk)%ccfmax
   ipol=1
   if(xpol) ipol=sync(ipk)%ipol
@@ -74,9 +108,11 @@ subroutine q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,xpol, &
   k0=nint((ipk*df3-1000.0)/df)
   if(nagain.eq.1) k0=nint((f_mouse-1000.0)/df)
 
-  if(k0.lt.nh .or. k0.gt.MAXFFT1-nfft2+1) go to 900
-  if(snr1.lt.1.5) go to 900                      !### Threshold needs work? ###
+  if(k0.lt.nh .or. k0.gt.MAXFFT1-nfft2+1) return
+  if(snr1.lt.1.5) return                         !### Threshold needs work? ###
 
+  allocate(cx(0:MAXFFT2-1),cy(0:MAXFFT2-1),cz(0:MAXFFT2))
+  allocate(iwave(60*12000))
   fac=1.0/nfft2
   cx(0:nfft2-1)=ca(k0:k0+nfft2-1)
   cx=fac*cx
@@ -138,10 +174,57 @@ subroutine q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,xpol, &
   endif
   nsnr0=-99             !Default snr for no decode
   ndpth=3
+  ndepth=0              !ndepth used to be an unset saved variable
 
 ! NB: Frequency of ipk is now shifted to 1000 Hz.
   call map65_mmdec(nutc,iwave,nqd,60,nsubmode,nfa,nfb,1000,ntol,     &
-       newdat,nagain,max_drift,ndepth,mycall,hiscall0,hisgrid)
+       newdat,nagain,max_drift,ndepth,mycall,hiscall,hisgrid)
+  nsnr=nsnr0
+  xdt=xdt0
+  nfreq=nfreq0
+  msg=msg0
+  cq=cq0
+
+  return
+end subroutine q65b_decode
+
+subroutine q65b_report(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf, &
+     ntol,xpol,mygrid,mode_q65,newdat,ndop00,ipk,k0,poldeg,nsnr0,xdt0,     &
+     nfreq0,msg0,cq0,idec)
+
+! Send a decode from q65b_decode() back to the GUI and write it to the
+! log files.  Sets idec to the decode type, or -1 if there was none.
+
+  parameter (MAXFFT1=5376000)              !56*96000
+  logical xpol,ldecoded
+  real*8 fcenter,freq0,freq1
+  character*6 mygrid
+  character*37 msg0
+  character*3 cq0
+  character*28 msg00
+  character*80 line
+  character*80 wsjtx_dir
+  character*1 cp,cmode*2
+  common/early/nhsym1,nhsym2,ldecoded(32768)
+  common/decodes/ndecodes
+  data nutc00/-1/,msg00/'                            '/
+  save
+
+  if(newdat.eq.1) nutc00=-1
+  open(9,file='wsjtx_dir.txt',status='old')
+  read(9,'(a)') wsjtx_dir                      !Establish the working directory
+  close(9)
+  idec=-1
+  if(nsnr0.le.-99) go to 900
+! An earlier candidate in the same batch may have decoded this one
+  if(ldecoded(ipk)) go to 900
+
+  nfft1=MAXFFT1
+  df=96000.0/NFFT1
+  if(nfsample.eq.95238) then
+     nfft1=5120000
+     df=96000.0/nfft1
+  endif
 
   MHz=fcenter
   freq0=MHz + 0.001d0*ikhz
@@ -198,8 +281,7 @@ subroutine q65b(nutc,nqd,nxant,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,xpol, &
 900 close(13)
   close(17)
   call flush(6)
-  idec=-1
-  read(cq0(2:2),*) idec
+  if(nsnr0.gt.-99) read(cq0(2:2),*) idec
 
   return
-end subroutine q65b
+end subroutine q65b_report
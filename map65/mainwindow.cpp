@@ -1711,6 +1711,10 @@ void MainWindow::guiUpdate()
         if(m_nrx==1) t="I1";
         if(m_nrx==-2) t="F2";
         if(m_nrx==+2) t="I2";
+        auto stats=soundInThread.udpStatistics();
+        lab1->setToolTip(tr("%1 packets/s\nLost: %2\nLate: %3\nOverruns: %4")
+                         .arg(stats.packets_per_second,0,'f',1)
+                         .arg(stats.lost).arg(stats.late).arg(stats.overruns));
       } else {
         if(m_nrx==1) t="S1";
         if(m_nrx==2) t="S2";
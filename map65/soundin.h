@@ -2,9 +2,9 @@
 #define SOUNDIN_H
 
 #include <QtCore>
-#include <QtNetwork/QUdpSocket>
 #include <QDebug>
 #include <valarray>
+#include "Network/LinradReceiver.hpp"
 
 // Thread gets audio data from soundcard and signals when a buffer of
 // specified size is available.
@@ -44,6 +44,7 @@ public:
   void setPeriod(int n);
   int  nrx();
   int  mhsym();
+  LinradReceiver::Statistics udpStatistics() const;
 
 signals:
   void bufferAvailable(std::valarray<qint16> samples, double rate);
@@ -71,7 +72,7 @@ private:
   qint32 m_TRperiod0;
   qint32 m_dB;
 
-  QUdpSocket *udpSocket;
+  LinradReceiver m_receiver;
 };
 
 extern "C" {
@@ -0,0 +1,258 @@
+#include "StationActivity.hpp"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+#include <QHash>
+#include <QVector>
+#include <QVariant>
+
+#include "pimpl_impl.hpp"
+
+#include "moc_StationActivity.cpp"
+
+namespace
+{
+  char const * const contest_bands[] {"160m", "80m", "40m", "20m", "15m", "10m", "6m"};
+}
+
+class StationActivity::impl final
+{
+public:
+  struct Station
+  {
+    QString grid4;
+    qint32 azimuth {0};
+    qint32 points {0};
+    quint8 worked_bands {0};
+    bool recent {false};
+    Decode last;
+    std::list<QString>::iterator order; // in recent_ while recent
+  };
+
+  struct Row
+  {
+    QString call;
+    QString text;               // without the row number
+
+    bool operator != (Row const& rhs) const
+    {
+      return call != rhs.call || text != rhs.text;
+    }
+  };
+
+  // age in periods, allowing for the UTC day wrapping
+  static int age (int latest_time, int time, double period)
+  {
+    int result = int ((latest_time - time) / period + 0.5);
+    if (result < 0) result += int (86400 / period);
+    return result;
+  }
+
+  void forget (QHash<QString, Station>::iterator station)
+  {
+    if (station->recent)
+      {
+        recent_.erase (station->order);
+        station->recent = false;
+      }
+  }
+
+  QHash<QString, Station> stations_;
+  std::list<QString> recent_;   // least recently heard first
+  QVector<Row> rows_;
+};
+
+StationActivity::StationActivity (QObject * parent)
+  : QAbstractListModel {parent}
+{
+}
+
+StationActivity::~StationActivity ()
+{
+}
+
+int StationActivity::band_bit (QString const& band)
+{
+  for (int i = 0; i < int (sizeof contest_bands / sizeof contest_bands[0]); ++i)
+    {
+      if (band == contest_bands[i]) return i;
+    }
+  return -1;
+}
+
+bool StationActivity::contains (QString const& call) const
+{
+  return m_->stations_.contains (call);
+}
+
+bool StationActivity::has_grid (QString const& call, QString const& grid4) const
+{
+  auto station = m_->stations_.constFind (call);
+  return station != m_->stations_.constEnd () && station->grid4 == grid4;
+}
+
+void StationActivity::set_location (QString const& call, QString const& grid4, int azimuth, int points)
+{
+  auto& station = m_->stations_[call];
+  station.grid4 = grid4;
+  station.azimuth = azimuth;
+  station.points = points;
+}
+
+int StationActivity::points (QString const& call) const
+{
+  auto station = m_->stations_.constFind (call);
+  return station != m_->stations_.constEnd () ? station->points : -1;
+}
+
+void StationActivity::set_worked (QString const& call, QString const& band)
+{
+  auto& station = m_->stations_[call];
+  auto bit = band_bit (band);
+  if (bit >= 0) station.worked_bands |= 1u << bit;
+}
+
+bool StationActivity::worked (QString const& call, QString const& band) const
+{
+  auto station = m_->stations_.constFind (call);
+  auto bit = band_bit (band);
+  return station != m_->stations_.constEnd () && bit >= 0 && (station->worked_bands & (1u << bit));
+}
+
+void StationActivity::heard (QString const& call, Decode const& decode)
+{
+  auto station = m_->stations_.find (call);
+  if (station == m_->stations_.end ()) return;
+  station->last = decode;
+  if (station->recent)
+    {
+      m_->recent_.splice (m_->recent_.end (), m_->recent_, station->order);
+    }
+  else
+    {
+      station->order = m_->recent_.insert (m_->recent_.end (), call);
+      station->recent = true;
+    }
+}
+
+void StationActivity::forget (QString const& call)
+{
+  auto station = m_->stations_.find (call);
+  if (station != m_->stations_.end ()) m_->forget (station);
+}
+
+void StationActivity::forget_all ()
+{
+  beginResetModel ();
+  for (auto& station : m_->stations_) station.recent = false;
+  m_->recent_.clear ();
+  m_->rows_.clear ();
+  endResetModel ();
+}
+
+void StationActivity::clear ()
+{
+  beginResetModel ();
+  m_->stations_.clear ();
+  m_->recent_.clear ();
+  m_->rows_.clear ();
+  endResetModel ();
+}
+
+void StationActivity::refresh (int latest_time, double period, int max_age, int max_rows, bool ready_only,
+                               QString const& band)
+{
+  // drop the stations not heard for too long
+  while (m_->recent_.size ())
+    {
+      auto station = m_->stations_.find (m_->recent_.front ());
+      if (impl::age (latest_time, station->last.time, period) <= max_age) break;
+      m_->forget (station);
+    }
+
+  struct Candidate
+  {
+    float rank;
+    impl::Row row;
+  };
+  std::vector<Candidate> candidates;
+  auto bit = band_bit (band);
+  for (auto call = m_->recent_.begin (); call != m_->recent_.end (); )
+    {
+      auto station = m_->stations_.find (*call++);
+      auto const& last = station->last;
+      auto age = impl::age (latest_time, last.time, period);
+      if (age > max_age)        // heard out of time order
+        {
+          m_->forget (station);
+          continue;
+        }
+      bool ready {0 == age && last.ready_to_call};
+      if ((!ready && ready_only) || (bit >= 0 && (station->worked_bands & (1u << bit))))
+        {
+          continue;
+        }
+      float x = float (age) / (max_age + 1);
+      if (x > 1.f) x = 0.f;
+      QString text;
+      text = text.asprintf ("  %3d  %+2.2d  %4d  %1d %2d%c%4d", station->azimuth, last.snr
+                            , last.audio_frequency, last.tx_even ? 0 : 1, age, ready ? '*' : ' '
+                            , station->points);
+      candidates.push_back ({station->points - x
+            , {station.key (), (station.key () + "   ").left (6) + "  " + station->grid4 + text}});
+    }
+  std::stable_sort (candidates.begin (), candidates.end (), [] (Candidate const& lhs, Candidate const& rhs) {
+      return lhs.rank > rhs.rank;
+    });
+  if (int (candidates.size ()) > max_rows) candidates.resize (std::max (max_rows, 0));
+
+  // update the rows, telling views about just those that change
+  int rows = candidates.size ();
+  int old_rows = m_->rows_.size ();
+  if (rows < old_rows)
+    {
+      beginRemoveRows (QModelIndex {}, rows, old_rows - 1);
+      m_->rows_.resize (rows);
+      endRemoveRows ();
+    }
+  for (int i = 0; i < std::min (rows, old_rows); ++i)
+    {
+      if (m_->rows_[i] != candidates[i].row)
+        {
+          m_->rows_[i] = candidates[i].row;
+          Q_EMIT dataChanged (index (i), index (i));
+        }
+    }
+  if (rows > old_rows)
+    {
+      beginInsertRows (QModelIndex {}, old_rows, rows - 1);
+      for (int i = old_rows; i < rows; ++i) m_->rows_ << candidates[i].row;
+      endInsertRows ();
+    }
+}
+
+QString StationActivity::station_text (int row) const
+{
+  return row >= 0 && row < m_->rows_.size () ? m_->rows_[row].text : QString {};
+}
+
+int StationActivity::rowCount (QModelIndex const& parent) const
+{
+  return parent.isValid () ? 0 : m_->rows_.size ();
+}
+
+QVariant StationActivity::data (QModelIndex const& index, int role) const
+{
+  if (!index.isValid () || index.row () >= m_->rows_.size ()) return QVariant {};
+  auto const& row = m_->rows_[index.row ()];
+  switch (role)
+    {
+    case Qt::DisplayRole:
+      return QString {"%1.  "}.arg (index.row () + 1, 2) + row.text;
+    case CallRole:
+      return row.call;
+    default:
+      return QVariant {};
+    }
+}
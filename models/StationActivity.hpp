@@ -0,0 +1,98 @@
+#ifndef STATION_ACTIVITY_HPP__
+#define STATION_ACTIVITY_HPP__
+
+#include <QAbstractListModel>
+#include <QString>
+
+#include "pimpl_h.hpp"
+
+class QVariant;
+
+//
+// Class StationActivity
+//
+//  Tracks the stations heard for the ARRL Digi contest and the Active
+//  Stations window.
+//
+// Responsibilities
+//
+//  Keeps a record for every call heard with a grid, holding the four
+//  character grid, the azimuth and contest points worked out when the
+//  grid was first seen or changed, and a bit mask of the contest bands
+//  the call has been worked on.
+//
+//  Keeps the details of the latest decode of each recently heard call
+//  in order of when they were heard, so stations older than the
+//  maximum age are dropped from the front without visiting the rest.
+//
+//  refresh() ranks the recent stations by points and age and updates
+//  the rows of the model, notifying views of just the rows that have
+//  changed.
+//
+// Collaborations
+//
+//  Implements the QAbstractListModel interface with one row per
+//  station listed, the display role being the text of the line as
+//  shown in the Active Stations window.
+//
+class StationActivity final
+  : public QAbstractListModel
+{
+  Q_OBJECT
+
+public:
+  //
+  // Struct Decode
+  //
+  //  The variable data from a decode of a station.
+  //
+  struct Decode
+  {
+    qint64 dial_frequency;
+    qint32 audio_frequency;
+    qint32 snr;
+    qint32 time;                // seconds into the UTC day
+    bool tx_even;
+    bool ready_to_call;         // CQ, RR73 or 73
+  };
+
+  enum Role {CallRole = Qt::UserRole + 1};
+
+  explicit StationActivity (QObject * parent = nullptr);
+  ~StationActivity ();
+
+  // the bit for a contest band e.g. "40m", -1 for other bands
+  static int band_bit (QString const& band);
+
+  bool contains (QString const& call) const;
+  bool has_grid (QString const& call, QString const& grid4) const;
+  void set_location (QString const& call, QString const& grid4, int azimuth, int points);
+  int points (QString const& call) const; // -1 for an unknown call
+  void set_worked (QString const& call, QString const& band);
+  bool worked (QString const& call, QString const& band) const;
+
+  void heard (QString const& call, Decode const&);
+  void forget (QString const& call); // no longer recently heard
+  void forget_all ();           // e.g. on a frequency change, clears the rows
+  void clear ();                // everything
+
+  // rank the stations heard within max_age periods of latest_time
+  // and update the rows, at most max_rows of them
+  void refresh (int latest_time, double period, int max_age, int max_rows, bool ready_only,
+                QString const& band);
+
+  // the line for a row without the row number
+  QString station_text (int row) const;
+
+  //
+  // Model API
+  //
+  int rowCount (QModelIndex const& parent = QModelIndex {}) const override;
+  QVariant data (QModelIndex const&, int role = Qt::DisplayRole) const override;
+
+private:
+  class impl;
+  pimpl<impl> m_;
+};
+
+#endif
@@ -2,6 +2,7 @@ SOURCES += \
   models/Bands.cpp \
   models/FrequencyList.cpp \
   models/StationList.cpp \
+  models/StationActivity.cpp \
   models/Modes.cpp \
   models/IARURegions.cpp \
   models/FoxLog.cpp \
@@ -12,6 +13,7 @@ HEADERS  += \
   models/Bands.hpp \
   models/FrequencyList.hpp \
   models/StationList.hpp \
+  models/StationActivity.hpp \
   models/Modes.hpp \
   models/IARURegions.hpp \
   models/FoxLog.hpp \
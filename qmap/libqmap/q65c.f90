@@ -83,11 +83,8 @@ subroutine q65c
 !  flush(6)
 
   if(ndiskdat.eq.0) then
-     if(nhsym.eq.390 .and.                                                   &
-          (nsave.eq.2 .or. (nsave.eq.1 .and. ndecodes.ge.1))) then
-        call save_qm(fname,revision,mycall,mygrid,dd,ntx30a,ntx30b,fcenter,  &
-             nutc,ndop00,ndop58)
-     endif
+     call save_qm(fname,revision,mycall,mygrid,dd,ntx30a,ntx30b,fcenter,     &
+          nutc,ndop00,ndop58,nhsym,nsave,ndecodes)
   endif
 
   return
@@ -0,0 +1,131 @@
+module qm_stream
+
+! Streaming writer for QMAP .qm files, format version 2 (nxtra(1)=2).
+! Rx data are written at each decoder pass as they arrive, in blocks
+! of NBLK complex samples.  Each block is quantized to 8 bits with a
+! gain of its own, from a running estimate of the rms level, and is
+! Rice coded (rice8.c) when that makes it smaller.  Block layout:
+!
+!   ja, n, fac, nbytes     first sample, samples, gain, coded length
+!   nbytes coded bytes, or 2*n raw bytes if nbytes=0
+!
+! An index of (ja, file position) for every block follows the last
+! one; the header gets its position in nxtra(2) and the number of
+! blocks in nxtra(3).  A file cut short has nxtra(2)=0 and can still
+! be read block by block.  See read_qm.f90.
+
+  parameter (NMAX=60*96000)
+  parameter (NBLK=96000)                   !Samples per block, 1 s
+  parameter (MAXBLK=NMAX/NBLK)
+  parameter (NQMVER=2)                     !Format version, nxtra(1)
+  parameter (LUQM=29)
+
+  character*120 :: qmname=' '
+  logical :: qmopen=.false.
+  integer nwritten                         !Samples already dealt with
+  integer nblocks
+  integer jblk(MAXBLK),iposblk(MAXBLK)     !Block index
+  real rmsrun                              !Running rms level
+  character*22 qrevision                   !Header, as of the last pass
+  character*12 qmycall
+  character*6 qmygrid
+  real*8 qfcenter
+  integer qnutc,qntx30a,qntx30b,qndop00,qndop58,qia,qib
+  integer*1 id1(2,NBLK)
+  integer*1 icode(2*NBLK)
+
+contains
+
+  subroutine qm_open(fname)
+
+    character*(*) fname
+    character*24 prog_id
+    integer nxtra(15)
+
+    open(LUQM,file=trim(fname),status='unknown',access='stream',err=900)
+    qmname=fname
+    qmopen=.true.
+    nwritten=0
+    nblocks=0
+    rmsrun=0.
+    prog_id=' '
+    nxtra=0
+    nxtra(1)=NQMVER
+    write(LUQM) prog_id,'            ','      ',0.d0,0,0,0,0,0,0,0,0.0,  &
+         nxtra                         !Placeholder header, see qm_close
+900 return
+  end subroutine qm_open
+
+  subroutine qm_write(dd,ia,ib,n)
+
+! Write the complete blocks of dd(1:2,ia:ib) available up to sample n
+! that have not yet been written.
+
+    real*4 dd(2,NMAX)
+
+    do while(qmopen .and. nwritten+NBLK.le.min(n,ib))
+       ja=nwritten+1
+       nwritten=nwritten+NBLK
+       if(ja.lt.ia) cycle
+       sq=dot_product(dd(1,ja:nwritten),dd(1,ja:nwritten)) +             &
+            dot_product(dd(2,ja:nwritten),dd(2,ja:nwritten))
+       rms=sqrt(sq/(2*NBLK))
+! Follow a rising level at once, so as not to clip, and a falling one
+! slowly, so that the gain does not pump.
+       if(rms.gt.rmsrun) then
+          rmsrun=rms
+       else if(rms.gt.0.0) then
+          rmsrun=0.8*rmsrun + 0.2*rms
+       endif
+       fac=1.0
+       if(rmsrun.gt.0.0) fac=10.0/rmsrun
+       do i=1,NBLK
+          x=fac*dd(1,ja+i-1)
+          y=fac*dd(2,ja+i-1)
+          if(abs(x).gt.127.0) x=0.
+          if(abs(y).gt.127.0) y=0.
+          id1(1,i)=nint(x)
+          id1(2,i)=nint(y)
+       enddo
+       call rice8_encode(id1,2*NBLK,icode,2*NBLK,nbytes)
+       nblocks=nblocks+1
+       jblk(nblocks)=ja
+       inquire(LUQM,pos=iposblk(nblocks))
+       if(nbytes.gt.0) then
+          write(LUQM) ja,NBLK,fac,nbytes,icode(1:nbytes)
+       else
+          write(LUQM) ja,NBLK,fac,0,id1
+       endif
+    enddo
+
+    return
+  end subroutine qm_write
+
+  subroutine qm_close(keep)
+
+! Write the index and the final header, or delete the file.
+
+    logical keep
+    integer nxtra(15)
+
+    if(.not.qmopen) return
+    qmopen=.false.
+    if(.not.keep) then
+       close(LUQM,status='delete')
+       return
+    endif
+    nxtra=0
+    nxtra(1)=NQMVER
+    inquire(LUQM,pos=nxtra(2))
+    nxtra(3)=nblocks
+    if(nblocks.gt.0) write(LUQM) (jblk(i),iposblk(i),i=1,nblocks)
+    fac0=0.
+    if(rmsrun.gt.0.0) fac0=10.0/rmsrun
+    write(LUQM,pos=1) qrevision//'  ',qmycall,qmygrid,qfcenter,qnutc,     &
+         qntx30a,qntx30b,qndop00,qndop58,qia,qib,fac0,nxtra
+    close(LUQM)
+
+    return
+  end subroutine qm_close
+
+end module qm_stream
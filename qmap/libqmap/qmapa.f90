@@ -6,6 +6,7 @@ subroutine qmapa(dd,ss,savg,newdat,nutc,fcenter,ntol,nfa,nfb,         &
 !  Processes timf2 data received from Linrad to find and decode Q65 signals.
 
   use timer_module, only: timer
+  include 'timer_common.inc'
 
   type candidate
      real :: snr          !Relative S/N of sync detection
@@ -35,6 +36,12 @@ subroutine qmapa(dd,ss,savg,newdat,nutc,fcenter,ntol,nfa,nfb,         &
   type(good_decode) found(MAX_CANDIDATES)
   character*64 result
   character*20 datetime
+  character*12 mycall1,hiscall1
+  character*37 msg(MAX_CANDIDATES)
+  integer nmode(MAX_CANDIDATES),nkhz(MAX_CANDIDATES),k0(MAX_CANDIDATES)
+  integer nsnr(MAX_CANDIDATES),nfreq(MAX_CANDIDATES)
+  real xdt(MAX_CANDIDATES)
+  logical ltried(MAX_CANDIDATES),ldone
   common/decodes/ndecodes,ncand2,nQDecoderDone,nWDecoderBusy,              &
        nWTransmitting,kHzRequested,result(50)
   save
@@ -73,14 +80,51 @@ subroutine qmapa(dd,ss,savg,newdat,nutc,fcenter,ntol,nfa,nfb,         &
      fqso=fselected
   endif
 
-  do icand=1,ncand2                        !Attempt to decode each candidate
+  if(bClickDecode) then
+     do icand=1,ncand2                     !Attempt to decode each candidate
+        tsec=sec_midn() - tsec0
+        if(ndiskdat.eq.0) then
+           ! No more realtime decode attempts if it's nearly too late
+           if(nhsym.eq.130 .and. tsec.gt.6.0) exit
+           if(nhsym.eq.200 .and. tsec.gt.10.0) exit
+           if(nhsym.eq.330 .and. tsec.gt.6.0) exit
+           if(nhsym.eq.390 .and. tsec.gt.16.0) exit
+        endif
+        f0=cand(icand)%f
+        ntrperiod=cand(icand)%ntrperiod
+        iseq=cand(icand)%iseq
+        mode_q65_tmp=mode_q65
+        if(ntrperiod.eq.30) mode_q65_tmp=max(1,mode_q65-1)
+        freq=f0+nkhz_center-48.0-1.27046
+        ikhz=nint(freq)
+        idec=-1
+        call timer('q65b    ',0)
+        call q65b(nutc,nqd,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,        &
+             ntrperiod,iseq,mycall,hiscall,hisgrid,mode_q65_tmp,f0,fqso,    &
+             nkhz_center,newdat,nagain,bClickDecode,max_drift,offset,      &
+             ndepth,datetime,nCFOM,ndop00,nhsym,idec)
+        call timer('q65b    ',1)
+        if(idec.ge.0) exit
+     enddo
+     return
+  endif
+
+! Wideband decode.  Candidates are decoded in parallel, each thread
+! having its own copy of the Q65 decoder state, and the results are
+! then reported in candidate order.
+  if(mycall(1:1).ne.' ') mycall1=mycall
+  if(hiscall(1:1).ne.' ') hiscall1=hiscall
+  ltried=.false.
+  !$omp parallel do schedule(dynamic) default(shared) copyin(/timer_private/) &
+  !$omp private(icand,j,tsec,f0,ntrperiod,iseq,freq,ldone)
+  do icand=1,ncand2
      tsec=sec_midn() - tsec0
      if(ndiskdat.eq.0) then
         ! No more realtime decode attempts if it's nearly too late, already
-        if(nhsym.eq.130 .and. tsec.gt.6.0) exit
-        if(nhsym.eq.200 .and. tsec.gt.10.0) exit
-        if(nhsym.eq.330 .and. tsec.gt.6.0) exit
-        if(nhsym.eq.390 .and. tsec.gt.16.0) exit
+        if(nhsym.eq.130 .and. tsec.gt.6.0) cycle
+        if(nhsym.eq.200 .and. tsec.gt.10.0) cycle
+        if(nhsym.eq.330 .and. tsec.gt.6.0) cycle
+        if(nhsym.eq.390 .and. tsec.gt.16.0) cycle
      endif
      f0=cand(icand)%f
      ntrperiod=cand(icand)%ntrperiod
@@ -88,32 +132,42 @@ subroutine qmapa(dd,ss,savg,newdat,nutc,fcenter,ntol,nfa,nfb,         &
 
      if(nagain.eq.0) then
         ! Skip this candidate if we already decoded it.
+        ldone=.false.
         do j=1,ndecodes
            if(abs(f0-found(j)%f).lt.0.005 .and.                             &
-           ntrperiod.eq.found(j)%ntrperiod .and.                            &
-           iseq.eq.found(j)%iseq) go to 10
+                ntrperiod.eq.found(j)%ntrperiod .and.                       &
+                iseq.eq.found(j)%iseq) ldone=.true.
         enddo
+        if(ldone) cycle
      endif
 
-     mode_q65_tmp=mode_q65
-     if(ntrperiod.eq.30) mode_q65_tmp=max(1,mode_q65-1)
+     nmode(icand)=mode_q65
+     if(ntrperiod.eq.30) nmode(icand)=max(1,mode_q65-1)
      freq=f0+nkhz_center-48.0-1.27046
-     ikhz=nint(freq)
-     idec=-1
+     nkhz(icand)=nint(freq)
      call timer('q65b    ',0)
-     call q65b(nutc,nqd,fcenter,nfcal,nfsample,ikhz,mousedf,ntol,           &
-          ntrperiod,iseq,mycall,hiscall,hisgrid,mode_q65_tmp,f0,fqso,       &
-          nkhz_center,newdat,nagain,bClickDecode,max_drift,offset,         &
-          ndepth,datetime,nCFOM,ndop00,nhsym,idec)
+     call q65b_decode(nutc,nqd,ntol,ntrperiod,iseq,mycall1,hiscall1,        &
+          hisgrid,nmode(icand),f0,fqso,nkhz_center,newdat,nagain,          &
+          max_drift,ndepth,k0(icand),nsnr(icand),xdt(icand),nfreq(icand),  &
+          msg(icand))
      call timer('q65b    ',1)
-     if(bClickDecode .and. idec.ge.0) exit
+     ltried(icand)=.true.
+  enddo
+  !$omp end parallel do
+
+  do icand=1,ncand2
+     if(.not.ltried(icand)) cycle
+     idec=-1
+     call q65b_report(nutc,nfcal,nkhz(icand),cand(icand)%ntrperiod,         &
+          cand(icand)%iseq,nmode(icand),nkhz_center,bClickDecode,offset,   &
+          datetime,ndop00,nhsym,k0(icand),nsnr(icand),xdt(icand),          &
+          nfreq(icand),msg(icand),idec)
      if(idec.ge.0) then
         ! Save some details on good decodes, to avoid duplicated effort
-        found(ndecodes)%f=f0
-        found(ndecodes)%ntrperiod=ntrperiod
-        found(ndecodes)%iseq=iseq
+        found(ndecodes)%f=cand(icand)%f
+        found(ndecodes)%ntrperiod=cand(icand)%ntrperiod
+        found(ndecodes)%iseq=cand(icand)%iseq
      end if
-10   continue
   enddo  ! icand
 
   return
@@ -1,12 +1,18 @@
 subroutine read_qm(fname,iret)
 
+! Read a .qm file into dd.  Files of format version 2 (see
+! qm_stream.f90) are read one block at a time, using the index to
+! skip blocks outside ia:ib when there is one.
+
+  use qm_stream, only: NBLK,NQMVER
   include 'njunk.f90'
   parameter(NMAX=60*96000,NFFT=32768)
   character*(*) fname
   character prog_id*24,mycall*12,mygrid*6
   real*8 fcenter
   integer nxtra(15)                        !For possible future additions
-  integer*1 id1(2,NMAX)
+  integer*1 id1(2,NBLK)
+  integer*1 icode(2*NBLK)
   common/datcom/dd(2,5760000),ss(400,NFFT),savg(NFFT),                  &
        fcenter,nutc,fselected,mousedf,mousefqso,nagain,                 &
        ndepth,ndiskdat,ntx60,newdat,nn1,nn2,nfcal,nfshift,              &
@@ -18,12 +24,40 @@ subroutine read_qm(fname,iret)
   iret=3
   if(ib.eq.NMAX/2) iret=1
   if(ia.eq.NMAX/2+1) iret=2
+  dd=0.
+  if(nxtra(1).ge.NQMVER) go to 100
+
   fac=1.0
   if(fac0.gt.0.0) fac=1.0/fac0
-  id1=0
-  read(28,end=910) id1(1:2,ia:ib)
-  dd=0.
-  dd(1:2,ia:ib)=fac*id1(1:2,ia:ib)   !Boost back to previous level
+  do ja=ia,ib,NBLK                         !Original format: no blocks
+     n=min(NBLK,ib-ja+1)
+     read(28,end=910) id1(1:2,1:n)
+     dd(1:2,ja:ja+n-1)=fac*id1(1:2,1:n)    !Boost back to previous level
+  enddo
+  go to 999
+
+100 nblocks=nxtra(3)
+  if(nxtra(2).eq.0) nblocks=NMAX/NBLK      !No index: read until the end
+  do iblk=1,nblocks
+     if(nxtra(2).gt.0) then
+        read(28,pos=nxtra(2)+8*(iblk-1),end=910) ja,ipos
+        if(ja.gt.ib .or. ja+NBLK-1.lt.ia) cycle
+        read(28,pos=ipos,end=910) ja,n,fac,nbytes
+     else
+        read(28,end=999) ja,n,fac,nbytes
+     endif
+     if(ja.lt.1 .or. n.lt.1 .or. n.gt.NBLK .or. ja+n-1.gt.NMAX .or.      &
+          nbytes.lt.0 .or. nbytes.gt.2*n .or. fac.le.0.0) go to 910
+     if(nbytes.gt.0) then
+        read(28,end=910) icode(1:nbytes)
+        call rice8_decode(icode,nbytes,id1,2*n,ierr)
+        if(ierr.ne.0) go to 910
+     else
+        read(28,end=910) id1(1:2,1:n)
+     endif
+     if(ja.gt.ib .or. ja+n-1.lt.ia) cycle
+     dd(1:2,ja:ja+n-1)=id1(1:2,1:n)/fac
+  enddo
   go to 999
 
 900 iret=-1; go to 999
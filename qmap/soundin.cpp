@@ -148,30 +148,25 @@ void SoundInThread::setPeriod(int n)
   m_TRperiod=n;
 }
 
+LinradReceiver::Statistics SoundInThread::udpStatistics() const
+{
+  return m_receiver.statistics();
+}
+
 //--------------------------------------------------------------- inputUDP()
 void SoundInThread::inputUDP()
 {
-  udpSocket = new QUdpSocket();
-  if(!udpSocket->bind(m_udpPort,QUdpSocket::ShareAddress) )
-  {
-    emit error(tr("UDP Socket bind failed."));
+  // Packets are received on a thread of their own, see LinradReceiver
+  QString reason;
+  if(!m_receiver.start(m_udpPort,&reason)) {
+    emit error(tr("UDP Socket bind failed: ") + reason);
     return;
   }
 
-  // Set this socket's total buffer space for received UDP packets
-  udpSocket->setSocketOption (QUdpSocket::ReceiveBufferSizeSocketOption, 141600);
-
   bool qe = quitExecution;
-  struct linradBuffer {
-    double cfreq;
-    int msec;
-    float userfreq;
-    int iptr;
-    quint16 iblk;
-    qint8 nrx;
-    char iusb;
-    double d8[174];
-  } b;
+  LinradReceiver::Packet zero {};        // For filling gaps in the data
+  LinradReceiver::Packet* pb;
+  unsigned gap;
 
   int ntr0=99;
   int k=0;
@@ -184,12 +179,12 @@ void SoundInThread::inputUDP()
   while (!qe) {
     qe = quitExecution;
     if (qe) break;
-    if (!udpSocket->hasPendingDatagrams()) {
+    pb=m_receiver.front(&gap);
+    if (!pb) {
 //      msleep(2);                  // Sleep if no packet available
       QObject().thread()->usleep(2000);
     } else {
-      int nBytesRead = udpSocket->readDatagram((char *)&b,1416);
-      if (nBytesRead != 1416) qDebug() << "UDP Read Error:" << nBytesRead;
+      LinradReceiver::Packet& b=*pb;
 
       qint64 ms = QDateTime::currentMSecsSinceEpoch() % 86400000;
       nsec = ms/1000;             // Time according to this computer
@@ -211,6 +206,12 @@ void SoundInThread::inputUDP()
                                                 // or 2 RF channels, i*2 data
         if(m_nrx == -2) iz=87;                  // Two RF channels, r*4 data
 
+        // Zero fill for packets lost on the way, to keep in step with time
+        for(unsigned i=0; i<gap and (k+iz) <= 60*96000; i++) {
+          int nsam=-1;
+          recvpkt_(&nsam, &b.iblk, &b.nrx, &k, zero.d8, zero.d8, &m_dB);
+        }
+
         // If buffer will not overflow, move data into datcom_
         if ((k+iz) <= 60*96000) {
           int nsam=-1;
@@ -226,7 +227,8 @@ void SoundInThread::inputUDP()
           nhsym0=m_hsym;
         }
       }
+      m_receiver.pop();
     }
   }
-  delete udpSocket;
+  m_receiver.stop();
 }
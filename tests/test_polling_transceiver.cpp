@@ -0,0 +1,143 @@
+#include <QtTest>
+#include <QTimer>
+#include <QThread>
+
+#include "Transceiver/PollingTransceiver.hpp"
+
+namespace
+{
+  // a rig whose poll cycle takes three slow steps
+  class TestRig final
+    : public PollingTransceiver
+  {
+  public:
+    explicit TestRig (logger_type * logger)
+      : PollingTransceiver {logger, 0, nullptr}
+      , frequency_ {14074000}
+      , mode_ {USB}
+      , ptt_ {false}
+      , cycles_ {0}
+    {
+    }
+
+    Frequency frequency_;
+    MODE mode_;
+    bool ptt_;
+    unsigned cycles_;           // poll cycles completed
+
+  private:
+    int do_start () override
+    {
+      update_rx_frequency (frequency_);
+      update_mode (mode_);
+      return 0;
+    }
+
+    void do_stop () override {}
+
+    void do_frequency (Frequency f, MODE m, bool) override
+    {
+      frequency_ = f;
+      update_rx_frequency (f);
+      if (m != UNK)
+        {
+          mode_ = m;
+          update_mode (m);
+        }
+    }
+
+    void do_tx_frequency (Frequency f, MODE, bool) override
+    {
+      update_split (f != 0);
+      update_other_frequency (f);
+    }
+
+    void do_mode (MODE m) override
+    {
+      mode_ = m;
+      update_mode (m);
+    }
+
+    void do_ptt (bool on) override
+    {
+      ptt_ = on;
+      update_PTT (on);
+    }
+
+    void do_poll () override
+    {
+      for (unsigned step = 0; do_poll_step (step); ++step)
+        {
+        }
+    }
+
+    bool do_poll_step (unsigned step) override
+    {
+      QThread::msleep (10);     // a slow serial rig
+      switch (step)
+        {
+        case 0: update_rx_frequency (frequency_); break;
+        case 1: update_mode (mode_); break;
+        default:
+          update_PTT (ptt_);
+          ++cycles_;
+          return false;
+        }
+      return true;
+    }
+  };
+}
+
+class TestPollingTransceiver
+  : public QObject
+{
+  Q_OBJECT
+
+public:
+  TestPollingTransceiver ()
+    : logger_ {boost::log::keywords::channel = "RIGCTRL"}
+  {
+  }
+
+private:
+  // requests much more often than a poll cycle takes, e.g. Doppler
+  // tracking, must not stop polls completing and signalling state
+  Q_SLOT void rapid_requests_do_not_stop_polls ()
+  {
+    TestRig rig {&logger_};
+    unsigned updates {0};
+    unsigned last_sequence {0};
+    connect (&rig, &Transceiver::update, [&] (Transceiver::TransceiverState const&, unsigned sequence_number) {
+        ++updates;
+        last_sequence = sequence_number;
+      });
+    rig.start (1);
+    auto const starting_updates = updates;
+
+    Transceiver::TransceiverState state;
+    state.online (true);
+    state.frequency (rig.frequency_);
+    state.mode (Transceiver::USB);
+    unsigned sequence {1};
+    QTimer requests;
+    connect (&requests, &QTimer::timeout, [&] {
+        state.frequency (state.frequency () + 10);
+        rig.set (state, ++sequence);
+      });
+    requests.start (5);
+    QTest::qWait (2000);
+    requests.stop ();
+
+    QVERIFY (rig.cycles_ >= 2);
+    QVERIFY (updates > starting_updates);
+    QVERIFY (last_sequence > 1);
+    QCOMPARE (rig.frequency_, state.frequency ());
+    rig.stop ();
+  }
+
+  Transceiver::logger_type logger_;
+};
+
+QTEST_MAIN (TestPollingTransceiver);
+
+#include "test_polling_transceiver.moc"
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <QtTest>
+#include <QVector>
+#include <QByteArray>
+#include <QDateTime>
+#include <QTemporaryDir>
+#include <QFile>
+
+#include "Audio/RxArchive.hpp"
+
+// the archive holds the only copy of the received audio when it
+// replaces WAV files, so the codec must give back exactly what it was
+// given
+class TestRxArchive
+  : public QObject
+{
+  Q_OBJECT
+
+public:
+
+private:
+  static int constexpr block {4096}; // the codec's block size
+
+  static QVector<short> round_trip (QVector<short> const& data, QByteArray * encoded = nullptr)
+  {
+    auto bytes = RxArchive::encode (data.constData (), data.size ());
+    if (encoded) *encoded = bytes;
+    QVector<short> decoded (data.size ());
+    if (!RxArchive::decode (bytes, decoded.data (), decoded.size ())) return {};
+    return decoded;
+  }
+
+  Q_SLOT void silence ()
+  {
+    QVector<short> data (2 * block, 0);
+    QByteArray encoded;
+    QCOMPARE (round_trip (data, &encoded), data);
+    QVERIFY (encoded.size () < data.size () / 4);
+  }
+
+  Q_SLOT void full_scale_alternation ()
+  {
+    QVector<short> data (2 * block);
+    for (int i = 0; i < data.size (); ++i) data[i] = i & 1 ? -32767 : 32767;
+    QCOMPARE (round_trip (data), data);
+  }
+
+  Q_SLOT void extremes ()
+  {
+    QVector<short> data (block);
+    for (int i = 0; i < data.size (); ++i) data[i] = i % 3 ? (i & 1 ? -32768 : 32767) : 0;
+    QCOMPARE (round_trip (data), data);
+  }
+
+  Q_SLOT void random_data_stored_verbatim ()
+  {
+    QVector<short> data (3 * block);
+    quint32 seed {12345};
+    for (auto& x : data)
+      {
+        seed = seed * 1664525u + 1013904223u;
+        x = static_cast<short> (seed >> 16);
+      }
+    QByteArray encoded;
+    QCOMPARE (round_trip (data, &encoded), data);
+    // incompressible, so every block must have been stored as is
+    QVERIFY (encoded.size () >= 2 * data.size ());
+  }
+
+  Q_SLOT void partial_final_block ()
+  {
+    QVector<short> data (2 * block + 1234);
+    for (int i = 0; i < data.size (); ++i)
+      {
+        data[i] = static_cast<short> (8000. * std::sin (i * 0.05) + (i % 7) - 3);
+      }
+    QCOMPARE (round_trip (data), data);
+
+    QVector<short> tiny {5, -7};
+    QCOMPARE (round_trip (tiny), tiny);
+  }
+
+  Q_SLOT void truncated_stream_rejected ()
+  {
+    QVector<short> data (block);
+    for (int i = 0; i < data.size (); ++i) data[i] = static_cast<short> (i * 13);
+    auto encoded = RxArchive::encode (data.constData (), data.size ());
+    encoded.chop (encoded.size () / 2);
+    QVector<short> decoded (data.size ());
+    QVERIFY (!RxArchive::decode (encoded, decoded.data (), decoded.size ()));
+  }
+
+  Q_SLOT void stale_index_replaced ()
+  {
+    QTemporaryDir dir;
+    QVERIFY (dir.isValid ());
+    RxArchive archive {QDir {dir.path ()}};
+    auto start = QDateTime {QDate {2024, 6, 1}, QTime {12, 0}, Qt::UTC};
+    auto path = archive.segment_path (start);
+
+    // an index left behind by a segment that has since been deleted,
+    // its periods are short so their offsets lie inside the new segment
+    QVector<short> old_data (100, 100);
+    for (int i = 0; i < 3; ++i)
+      {
+        QCOMPARE (archive.append (start.addSecs (15 * i), "test", QString {}, old_data.constData (), old_data.size ()), QString {});
+      }
+    QVERIFY (QFile::remove (path));
+
+    QVector<short> data (3 * block);
+    for (int i = 0; i < data.size (); ++i) data[i] = static_cast<short> (10000. * std::sin (i * 0.3));
+    QCOMPARE (archive.append (start, "test", QString {}, data.constData (), data.size ()), QString {});
+    auto periods = RxArchive::periods (path);
+    QCOMPARE (periods.size (), 1);
+    QVector<short> read_back;
+    QVERIFY (RxArchive::read (path, periods[0], &read_back));
+    QCOMPARE (read_back, data);
+  }
+};
+
+QTEST_MAIN (TestRxArchive);
+
+#include "test_rx_archive.moc"
@@ -4,6 +4,8 @@
 #include <QApplication>
 #include <QTextCharFormat>
 #include <QDateTime>
+#include <QListView>
+#include <QAbstractItemModel>
 #include <QDebug>
 
 #include "SettingsGroup.hpp"
@@ -26,6 +28,8 @@ ActiveStations::ActiveStations(QSettings * settings, QFont const& font, QWidget
   connect(ui->cbReadyOnly, SIGNAL(toggled(bool)), this, SLOT(on_cbReadyOnly_toggled(bool)));
   connect(ui->cbWantedOnly, SIGNAL(toggled(bool)), this, SLOT(on_cbWantedOnly_toggled(bool)));
   connect(ui->RecentStationsPlainTextEdit, SIGNAL(cursorPositionChanged()), this, SLOT(on_textEdit_clicked()));
+  connect(ui->RecentStationsView, &QListView::clicked, this, &ActiveStations::on_view_clicked);
+  ui->RecentStationsView->setVisible(false);
 }
 
 ActiveStations::~ActiveStations()
@@ -37,6 +41,7 @@ void ActiveStations::changeFont (QFont const& font)
 {
   ui->header_label2->setStyleSheet (font_as_stylesheet (font));
   ui->RecentStationsPlainTextEdit->setStyleSheet (font_as_stylesheet (font));
+  ui->RecentStationsView->setStyleSheet (font_as_stylesheet (font));
   updateGeometry ();
 }
 
@@ -114,9 +119,22 @@ void ActiveStations::setupUi(QString mode) {
     ui->sbMaxAge->setVisible(b);
     ui->label->setVisible(b);
     ui->rate->setVisible(b);
+
+    // FT4 and FT8 stations come from the model
+    b=ui->RecentStationsView->model() && (m_mode=="FT4" || m_mode=="FT8");
+    ui->RecentStationsView->setVisible(b);
+    ui->RecentStationsPlainTextEdit->setVisible(!b);
   }
 }
 
+void ActiveStations::setModel(QAbstractItemModel * model)
+{
+  ui->RecentStationsView->setModel(model);
+  QString mode=m_mode;
+  m_mode="";
+  setupUi(mode);
+}
+
 void ActiveStations::displayRecentStations(QString mode, QString const& t)
 {
   setupUi(mode);
@@ -183,6 +201,15 @@ void ActiveStations::on_textEdit_clicked()
   }
 }
 
+void ActiveStations::on_view_clicked(QModelIndex const& index)
+{
+  if(m_clickOK and index.isValid()) {
+    int nline=index.row()+1;
+    if(QGuiApplication::keyboardModifiers().testFlag(Qt::ControlModifier)) nline=-nline;
+    emit callSandP(nline);
+  }
+}
+
 void ActiveStations::setClickOK(bool b)
 {
   m_clickOK=b;
@@ -7,6 +7,8 @@
 
 class QSettings;
 class QFont;
+class QAbstractItemModel;
+class QModelIndex;
 
 namespace Ui {
   class ActiveStations;
@@ -21,6 +23,7 @@ public:
   explicit ActiveStations(QSettings *, QFont const&, QWidget * parent = 0);
   ~ActiveStations();
   void displayRecentStations(QString mode, QString const&);
+  void setModel(QAbstractItemModel *);    // rows for the FT4 and FT8 display
   void setupUi(QString display_mode);
   void changeFont (QFont const&);
   int  maxRecent();
@@ -50,6 +53,7 @@ private:
   Q_SLOT void on_cbReadyOnly_toggled(bool b);
   Q_SLOT void on_cbWantedOnly_toggled(bool b);
   Q_SLOT void on_textEdit_clicked();
+  Q_SLOT void on_view_clicked(QModelIndex const&);
 
   QString m_mode="";
   QSettings * settings_;
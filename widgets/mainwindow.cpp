@@ -45,6 +45,7 @@
 #include <QUdpSocket>
 #include <QAbstractItemView>
 #include <QInputDialog>
+#include <QElapsedTimer>
 #if QT_VERSION >= QT_VERSION_CHECK (5, 15, 0)
 #include <QRandomGenerator>
 #endif
@@ -98,6 +99,7 @@
 #include "ui_mainwindow.h"
 #include "moc_mainwindow.cpp"
 #include "Logger.hpp"
+#include "StartupTimer.hpp"
 
 #define FCL fortran_charlen_t
 
@@ -183,7 +185,7 @@ extern "C" {
   void calibrate_(char const * data_dir, int* iz, double* a, double* b, double* rms,
                   double* sigmaa, double* sigmab, int* irc, fortran_charlen_t);
 
-  void foxgen_(bool* bSuperFox, char const * fname, FCL len);
+  void foxgen_(bool* bSuperFox);
 
   void sfox_wave_gfsk_();
 
@@ -291,6 +293,23 @@ namespace
           || (type == 6 && !msg_parts.filter ("73").isEmpty ()));
   }
 
+  // metadata for saved and archived received audio
+  QString wave_file_comment (QString const& mode, qint32 sub_mode, int samples
+                             , Radio::Frequency frequency, QString const& his_call
+                             , QString const& his_grid)
+  {
+    return QString {"Mode=%1%2; Freq=%3%4"}
+      .arg (mode)
+      .arg (QString {(mode.contains ('J') && !mode.contains ('+'))
+            || mode.startsWith ("FST4") || mode.startsWith ('Q')
+            ? QString {"; Sub Mode="} + QString::number (int (samples / 12000)) + QChar {'A' + sub_mode}
+          : QString {}})
+      .arg (Radio::frequency_MHz_string (frequency))
+      .arg (QString {mode!="WSPR" ? QString {"; DXCall=%1; DXGrid=%2"}
+                     .arg (his_call)
+                     .arg (his_grid).toLocal8Bit () : ""});
+  }
+
   int ms_minute_error ()
   {
     auto const& now = QDateTime::currentDateTimeUtc ();
@@ -324,8 +343,6 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   m_rigErrorMessageBox {MessageBox::Critical, tr ("Rig Control Error")
       , MessageBox::Cancel | MessageBox::Ok | MessageBox::Retry},
   m_wideGraph (new WideGraph(m_settings)),
-  m_echoGraph (new EchoGraph(m_settings)),
-  m_fastGraph (new FastGraph(m_settings)),
   // no parent so that it has a taskbar icon
   m_logDlg (new LogQSO (program_title (), m_settings, &m_config, &m_logBook, nullptr)),
   m_lastDialFreq {0},
@@ -379,6 +396,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   m_startAnother {false},
   m_saveDecoded {false},
   m_saveAll {false},
+  m_archiveAll {false},
   m_widebandDecode {false},
   m_dataAvailable {false},
   m_decodedText2 {false},
@@ -500,7 +518,9 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   m_block_udp_status_updates {false},
   m_useDarkStyle {false}
 {
+  StartupTimer::mark ("main window members");
   ui->setupUi(this);
+  StartupTimer::mark ("main window UI");
   setUnifiedTitleAndToolBarOnMac (true);
   createStatusBar();
   add_child_to_event_filter (this);
@@ -553,6 +573,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
 
   // hook up Modulator slots and disposal
   connect (this, &MainWindow::transmitFrequency, m_modulator, &Modulator::setFrequency);
+  connect (this, &MainWindow::transmitTonesChanged, m_modulator, &Modulator::refreshWaveform);
   connect (this, &MainWindow::endTransmitMessage, m_modulator, &Modulator::stop);
   connect (this, &MainWindow::tune, m_modulator, &Modulator::tune);
   connect (this, &MainWindow::sendMessage, m_modulator, &Modulator::start);
@@ -571,6 +592,10 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
 
   connect (this, &MainWindow::finished, this, &MainWindow::close);
 
+  connect (&m_allTxt, &AllTxtJournal::error, this, [this] (QString const& message) {
+      MessageBox::warning_message (this, tr ("Log File Error"), message);
+    });
+
   // hook up the detector signals, slots and disposal
   connect (this, &MainWindow::FFTSize, m_detector, &Detector::setBlockSize);
   connect(m_detector, &Detector::framesWritten, this, &MainWindow::dataSink);
@@ -581,11 +606,8 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   connect(m_wideGraph.data (), SIGNAL(f11f12(int)),this,SLOT(bumpFqso(int)));
   connect(m_wideGraph.data (), SIGNAL(setXIT2(int)),this,SLOT(setXIT(int)));
 
-  connect (m_fastGraph.data (), &FastGraph::fastPick, this, &MainWindow::fastPick);
 
   connect (this, &MainWindow::finished, m_wideGraph.data (), &WideGraph::close);
-  connect (this, &MainWindow::finished, m_echoGraph.data (), &EchoGraph::close);
-  connect (this, &MainWindow::finished, m_fastGraph.data (), &FastGraph::close);
 
   // setup the log QSO dialog
   connect (m_logDlg.data (), &LogQSO::acceptQSO, this, &MainWindow::acceptQSO);
@@ -681,6 +703,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   ui->actionNone->setActionGroup(saveGroup);
   ui->actionSave_decoded->setActionGroup(saveGroup);
   ui->actionSave_all->setActionGroup(saveGroup);
+  ui->actionArchive_all->setActionGroup(saveGroup);
 
   QActionGroup* alltxtGroup = new QActionGroup(this);
   ui->actionDon_t_split_ALL_TXT->setActionGroup(alltxtGroup);
@@ -843,6 +866,13 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
           MessageBox::critical_message (this, tr("Error Writing WAV File"), result);
         }
     });
+  connect (&m_archiveWatcher, &QFutureWatcher<QString>::finished, [this] {
+      auto const& result = m_archiveWatcher.future ().result ();
+      if (!result.isEmpty ())   // error
+        {
+          MessageBox::critical_message (this, tr("Error Writing RX Audio Archive"), result);
+        }
+    });
 
   // Hook up working frequencies.
   ui->bandComboBox->setModel (m_config.frequencies ());
@@ -966,6 +996,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   ui->lh_decodes_headings_label->setText(t);
   ui->rh_decodes_headings_label->setText(t);
   readSettings();            //Restore user's setup parameters
+  StartupTimer::mark ("restore settings");
   if(m_mode=="Q65") {
     m_score=0;
     read_log();
@@ -1029,9 +1060,11 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   proc_jt9.setProcessEnvironment (new_env);
   proc_jt9.start(QDir::toNativeSeparators (m_appDir) + QDir::separator () +
           "jt9", jt9_args, QIODevice::ReadWrite | QIODevice::Unbuffered);
+  StartupTimer::mark ("start jt9");
 
   auto fname {QDir::toNativeSeparators(m_config.writeable_data_dir ().absoluteFilePath ("wsjtx_wisdom.dat"))};
   fftwf_import_wisdom_from_filename (fname.toLocal8Bit ());
+  StartupTimer::mark ("FFTW wisdom");
 
   m_ntx = 6;
   ui->txrb6->setChecked(true);
@@ -1058,6 +1091,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   // this must be done before initializing the mode as some modes need
   // to turn off split on the rig e.g. WSPR
   m_config.transceiver_online ();
+  StartupTimer::mark ("audio streams and rig");
   bool vhf {m_config.enable_VHF_features ()};
 
   ui->txFirstCheckBox->setChecked(m_txFirst);
@@ -1079,6 +1113,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
   }
   m_saveDecoded=ui->actionSave_decoded->isChecked();
   m_saveAll=ui->actionSave_all->isChecked();
+  m_archiveAll=ui->actionArchive_all->isChecked();
   ui->TxPowerComboBox->setCurrentIndex(int(.3 * m_dBm + .2));
   ui->cbUploadWSPR_Spots->setChecked(m_uploadWSPRSpots);
   if((m_ndepth&7)==1) ui->actionQuickDecode->setChecked(true);
@@ -1111,7 +1146,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
 
   statusChanged();
 
-  m_fastGraph->setMode(m_mode);
+  if (m_fastGraph) m_fastGraph->setMode(m_mode);
   m_wideGraph->setMode(m_mode);
 
   connect (&minuteTimer, &QTimer::timeout, this, &MainWindow::bandHoppingTimer);
@@ -1168,6 +1203,7 @@ MainWindow::MainWindow(QDir const& temp_directory, bool multiple,
       });
   }
 #endif
+  StartupTimer::mark ("main window");
 
 // this must be the last statement of constructor
   if (!m_valid) throw std::runtime_error {"Fatal initialization exception"};
@@ -1310,6 +1346,7 @@ void MainWindow::writeSettings()
   m_settings->setValue("SaveNone",ui->actionNone->isChecked());
   m_settings->setValue("SaveDecoded",ui->actionSave_decoded->isChecked());
   m_settings->setValue("SaveAll",ui->actionSave_all->isChecked());
+  m_settings->setValue("ArchiveAll",ui->actionArchive_all->isChecked());
   m_settings->setValue("RemoveAudioFiles",ui->actionRemove_after_30days->isChecked());
   m_settings->setValue("NDepth",m_ndepth);
   m_settings->setValue("RxFreq",ui->RxFreqSpinBox->value());
@@ -1570,6 +1607,10 @@ void MainWindow::readSettings()
   ui->actionSplit_ALL_TXT_yearly->setChecked(m_settings->value("splitAllTxtYearly", false).toBool());
   ui->actionSplit_ALL_TXT_monthly->setChecked(m_settings->value("splitAllTxtMonthly", false).toBool());
   ui->actionDisable_writing_of_ALL_TXT->setChecked(m_settings->value("disableWritingOfAllTxt", false).toBool());
+  // ALL.TXT rotation and sync, no GUI for these yet
+  m_allTxt.set_max_size (m_settings->value ("AllTxtMaxMB", 0).toLongLong () << 20);
+  m_allTxt.set_sync_policy (static_cast<AllTxtJournal::SyncPolicy> (
+      qBound (0, m_settings->value ("AllTxtSync", AllTxtJournal::SyncPeriodic).toInt (), 2)));
   ui->actionDisable_event_logging->setChecked(m_settings->value("DisableEventLogging", false).toBool());
   ui->actionUse_Dark_Style->setChecked(m_settings->value("DarkStyle", false).toBool());
   ui->actionBand_Buttons->setChecked(m_settings->value("BandButtons", true).toBool());
@@ -1596,6 +1637,7 @@ void MainWindow::readSettings()
   ui->actionNone->setChecked(m_settings->value("SaveNone",true).toBool());
   ui->actionSave_decoded->setChecked(m_settings->value("SaveDecoded",false).toBool());
   ui->actionSave_all->setChecked(m_settings->value("SaveAll",false).toBool());
+  ui->actionArchive_all->setChecked(m_settings->value("ArchiveAll",false).toBool());
   ui->actionRemove_after_30days->setChecked(m_settings->value("RemoveAudioFiles",false).toBool());
   ui->RxFreqSpinBox->setValue(0); // ensure a change is signaled
   ui->RxFreqSpinBox->setValue(m_settings->value("RxFreq",1500).toInt());
@@ -1939,6 +1981,24 @@ void MainWindow::dataSink(qint64 frames)
   if(m_mode=="WSPR" or m_mode=="FST4W") wspr_downsample_(dec_data.d2,&k);
   if(m_ihsym <=0) return;
   if(ui) ui->signal_meter_widget->setValue(m_px,m_pxmax); // Update thermometer
+  // publish live spectra for other programs
+  if(m_config.publish_spectrum ()) {
+    auto const& key = QApplication::applicationName () + " - spectrum";
+    if(m_monitoring && !m_diskData && key != m_spectrumFeedFailedKey) {
+      if(m_spectrumFeed.open (key)) {
+        int bins=qMin(NSMAX,qRound(5000.0/m_df3)); // as symspec
+        m_spectrumFeed.write (QDateTime::currentMSecsSinceEpoch (), m_freqNominal, m_df3, m_px,
+                              m_TRperiod, m_ihsym, m_mode, s, bins, dec_data.savg, spectra_.syellow);
+      } else {
+        // report once, not every half-symbol, until the option or key changes
+        LOG_WARN(QString {"Cannot publish spectra as \"%1\": %2"}.arg (key).arg (m_spectrumFeed.error_string ()));
+        m_spectrumFeedFailedKey = key;
+      }
+    }
+  } else {
+    m_spectrumFeed.close ();
+    m_spectrumFeedFailedKey.clear ();
+  }
   if(m_monitoring || m_diskData) {
     m_wideGraph->dataSink2(s,m_df3,m_ihsym,m_diskData,m_px);
   }
@@ -2057,7 +2117,7 @@ void MainWindow::dataSink(qint64 frames)
         write_all("Rx",t);
       }
 
-      if(m_echoGraph->isVisible()) m_echoGraph->plotSpec();
+      if(m_echoGraph && m_echoGraph->isVisible()) m_echoGraph->plotSpec();
       if(m_saveAll and !m_diskData) {
         int idir=1;
         save_echo_params_(&m_fDop,&nDop,&nfrit,&f1,&width,dec_data.d2,&idir);
@@ -2084,25 +2144,30 @@ void MainWindow::dataSink(qint64 frames)
       {
         Q_EMIT reset_audio_input_stream (true); // reports dropped samples
       }
-    if(!m_diskData and (m_saveAll or m_saveDecoded or m_mode=="WSPR")) {
+    if(!m_diskData and (m_saveAll or m_saveDecoded or m_archiveAll or m_mode=="WSPR")) {
       //Always save unless "Save None"; may delete later
+      QDateTime period_start;
       if(m_TRperiod < 60) {
         int n=fmod(double(now.time().second()),m_TRperiod);
         if(n<(m_TRperiod/2)) n=n+m_TRperiod;
-        auto const& period_start=now.addSecs(-n);
+        period_start=now.addSecs(-n);
         m_fnameWE=m_config.save_directory().absoluteFilePath (period_start.toString("yyMMdd_hhmmss"));
       } else {
-        auto const& period_start = now.addSecs (-(now.time ().minute () % (int(m_TRperiod) / 60)) * 60);
+        period_start = now.addSecs (-(now.time ().minute () % (int(m_TRperiod) / 60)) * 60);
         m_fnameWE=m_config.save_directory ().absoluteFilePath (period_start.toString ("yyMMdd_hhmm"));
       }
       int samples=m_TRperiod*12000;
       if(m_mode=="FT4") samples=21*3456;
 
-      // the following is potential a threading hazard - not a good
-      // idea to pass pointer to be processed in another thread
-      m_saveWAVWatcher.setFuture (QtConcurrent::run (std::bind (&MainWindow::save_wave_file,
-            this, m_fnameWE, &dec_data.d2[0], samples, m_config.my_callsign(),
-            m_config.my_grid(), m_mode, m_nSubMode, m_freqNominalPeriod, m_hisCall, m_hisGrid)));
+      if(m_archiveAll) archive_rx_period (period_start, samples, m_freqNominalPeriod);
+      // wsprd still needs its WAV file when archiving
+      if(!m_archiveAll or m_mode=="WSPR") {
+        // the following is potential a threading hazard - not a good
+        // idea to pass pointer to be processed in another thread
+        m_saveWAVWatcher.setFuture (QtConcurrent::run (std::bind (&MainWindow::save_wave_file,
+              this, m_fnameWE, &dec_data.d2[0], samples, m_config.my_callsign(),
+              m_config.my_grid(), m_mode, m_nSubMode, m_freqNominalPeriod, m_hisCall, m_hisGrid)));
+      }
       if (m_mode=="WSPR") {
         auto c2name {(m_fnameWE + ".c2").toLocal8Bit ()};
         int nsec=120;
@@ -2160,16 +2225,7 @@ QString MainWindow::save_wave_file (QString const& name, short const * data, int
   format.setSampleSize (16);
   format.setSampleType (QAudioFormat::SignedInt);
   auto source = QString {"%1; %2"}.arg (my_callsign).arg (my_grid);
-  auto comment = QString {"Mode=%1%2; Freq=%3%4"}
-                   .arg (mode)
-                   .arg (QString {(mode.contains ('J') && !mode.contains ('+'))
-                         || mode.startsWith ("FST4") || mode.startsWith ('Q')
-                         ? QString {"; Sub Mode="} + QString::number (int (samples / 12000)) + QChar {'A' + sub_mode}
-                       : QString {}})
-                   .arg (Radio::frequency_MHz_string (frequency))
-                   .arg (QString {mode!="WSPR" ? QString {"; DXCall=%1; DXGrid=%2"}
-         .arg (his_call)
-         .arg (his_grid).toLocal8Bit () : ""});
+  auto comment = wave_file_comment (mode, sub_mode, samples, frequency, his_call, his_grid);
   BWFFile::InfoDictionary list_info {
       {{{'I','S','R','C'}}, source.toLocal8Bit ()},
       {{{'I','S','F','T'}}, program_title (revision ()).simplified ().toLocal8Bit ()},
@@ -2188,6 +2244,19 @@ QString MainWindow::save_wave_file (QString const& name, short const * data, int
   return QString {};
 }
 
+void MainWindow::archive_rx_period (QDateTime const& period_start, int samples, Frequency frequency)
+{
+  m_rxArchive.set_directory (m_config.save_directory ());
+  auto source = QString {"%1; %2"}.arg (m_config.my_callsign ()).arg (m_config.my_grid ());
+  auto comment = wave_file_comment (m_mode, m_nSubMode, samples, frequency, m_hisCall, m_hisGrid);
+  // a copy, dec_data is refilled while the archive is written
+  QVector<short> data (samples);
+  std::copy (&dec_data.d2[0], &dec_data.d2[0] + samples, data.begin ());
+  m_archiveWatcher.setFuture (QtConcurrent::run ([this, period_start, source, comment, data] {
+        return m_rxArchive.append (period_start, source, comment, data.constData (), data.size ());
+      }));
+}
+
 //-------------------------------------------------------------- fastSink()
 void MainWindow::fastSink(qint64 frames)
 {
@@ -2239,7 +2308,7 @@ void MainWindow::fastSink(qint64 frames)
   QString t;
   t = t.asprintf(" Rx noise: %5.1f ",px);
   ui->signal_meter_widget->setValue(rmsNoGain,pxmax); // Update thermometer
-  m_fastGraph->plotSpec(m_diskData,m_UTCdisk);
+  fastGraph()->plotSpec(m_diskData,m_UTCdisk);
 
   if(bmsk144 and (line[0]!=0)) {
     QString message {QString::fromLatin1 (line)};
@@ -2893,13 +2962,15 @@ void MainWindow::fastSink(qint64 frames)
   }
 
   if(decodeNow or m_bFastDone) {
-    if(!m_diskData and (m_saveAll or m_saveDecoded)) {
+    if(!m_diskData and (m_saveAll or m_saveDecoded or m_archiveAll)) {
       QDateTime now {QDateTime::currentDateTimeUtc()};
       int n=fmod(double(now.time().second()),m_TRperiod);
       if(n<(m_TRperiod/2)) n=n+m_TRperiod;
       auto const& period_start = now.addSecs (-n);
       m_fnameWE = m_config.save_directory ().absoluteFilePath (period_start.toString ("yyMMdd_hhmmss"));
-      if(m_saveAll or m_bAltV or (m_bDecoded and m_saveDecoded) or (m_mode!="MSK144")) {
+      if(m_archiveAll) {
+        archive_rx_period (period_start, int(m_TRperiod*12000.0), m_freqNominal);
+      } else if(m_saveAll or m_bAltV or (m_bDecoded and m_saveDecoded) or (m_mode!="MSK144")) {
         m_bAltV=false;
         // the following is potential a threading hazard - not a good
         // idea to pass pointer to be processed in another thread
@@ -3921,14 +3992,39 @@ void MainWindow::on_actionWide_Waterfall_triggered()      //Display Waterfalls
   m_wideGraph->showNormal();
 }
 
+// the echo and fast graphs are only used in a few modes so they are
+// not made until they are first needed
+EchoGraph * MainWindow::echoGraph ()
+{
+  if (!m_echoGraph)
+    {
+      m_echoGraph.reset (new EchoGraph (m_settings));
+      connect (this, &MainWindow::finished, m_echoGraph.data (), &EchoGraph::close);
+    }
+  return m_echoGraph.data ();
+}
+
+FastGraph * MainWindow::fastGraph ()
+{
+  if (!m_fastGraph)
+    {
+      m_fastGraph.reset (new FastGraph (m_settings));
+      connect (m_fastGraph.data (), &FastGraph::fastPick, this, &MainWindow::fastPick);
+      connect (this, &MainWindow::finished, m_fastGraph.data (), &FastGraph::close);
+      m_fastGraph->setMode (m_mode);
+      m_fastGraph->setTRPeriod (m_TRperiod);
+    }
+  return m_fastGraph.data ();
+}
+
 void MainWindow::on_actionEcho_Graph_triggered()
 {
-  m_echoGraph->showNormal();
+  echoGraph()->showNormal();
 }
 
 void MainWindow::on_actionFast_Graph_triggered()
 {
-  m_fastGraph->showNormal();
+  fastGraph()->showNormal();
 }
 
 void MainWindow::on_actionSolve_FreqCal_triggered()
@@ -4144,6 +4240,7 @@ void MainWindow::on_actionActiveStations_triggered()
 {
   if(m_ActiveStationsWidget == NULL) {
     m_ActiveStationsWidget.reset (new ActiveStations {m_settings, m_config.decoded_text_font ()});
+    m_ActiveStationsWidget->setModel (&m_stationActivity);
     // Connect signals from Message Averaging window
     connect (this, &MainWindow::finished, m_ActiveStationsWidget.data (), &ActiveStations::close);
   }
@@ -4313,6 +4410,7 @@ void MainWindow::on_actionNone_triggered()                    //Save None
 {
   m_saveDecoded=false;
   m_saveAll=false;
+  m_archiveAll=false;
   ui->actionNone->setChecked(true);
 }
 
@@ -4320,6 +4418,7 @@ void MainWindow::on_actionSave_decoded_triggered()
 {
   m_saveDecoded=true;
   m_saveAll=false;
+  m_archiveAll=false;
   ui->actionSave_decoded->setChecked(true);
 }
 
@@ -4327,9 +4426,18 @@ void MainWindow::on_actionSave_all_triggered()                //Save All
 {
   m_saveDecoded=false;
   m_saveAll=true;
+  m_archiveAll=false;
   ui->actionSave_all->setChecked(true);
 }
 
+void MainWindow::on_actionArchive_all_triggered()             //Archive All
+{
+  m_saveDecoded=false;
+  m_saveAll=false;
+  m_archiveAll=true;
+  ui->actionArchive_all->setChecked(true);
+}
+
 void MainWindow::on_actionKeyboard_shortcuts_triggered()
 {
   if (!m_shortcuts)
@@ -4534,7 +4642,7 @@ void MainWindow::on_ClrAvgButton_clicked()
   m_nclearave=1;
   if(m_mode=="Echo") {
     echocom_.nsum=0;
-    m_echoGraph->clearAvg();
+    if (m_echoGraph) m_echoGraph->clearAvg();
     m_wideGraph->restartTotalPower();
   } else {
     if(m_msgAvgWidget != NULL) {
@@ -4800,6 +4908,7 @@ void MainWindow::to_jt9(qint32 n, qint32 istart, qint32 idone)
 
 void MainWindow::decodeDone ()
 {
+  m_messageClient->flush_decodes ();
   if(m_mode=="Q65") m_wideGraph->drawRed(0,0);
   if ("FST4W" == m_mode)
     {
@@ -4923,13 +5032,11 @@ void MainWindow::ARRL_Digi_Update(DecodedText dt)
   QString deCall;
   QString deGrid;
   dt.deCallAndGrid(/*out*/deCall,deGrid);
-  ActiveCall ac;
-  RecentCall rc;
 
   if(deGrid.contains(grid_regexp)) {
-     if(!m_activeCall.contains(deCall) or deGrid!=m_activeCall.value(deCall).grid4) {
-       // Transmitting station's call is not already in QMap "m_activeCall", or grid has changed.
-       // Insert the call, grid, and associated fixed data into the list.
+     if(!m_stationActivity.has_grid(deCall,deGrid)) {
+       // Transmitting station's call is not already tracked, or grid has changed.
+       // Record the call, grid, and associated fixed data.
 
        double utch=0.0;
        int nAz,nEl,nDmiles,nDkm,nHotAz,nHotABetter;
@@ -4942,39 +5049,29 @@ void MainWindow::ARRL_Digi_Update(DecodedText dt)
        int points=nDkm/500;
        if(nDkm > 500*points) points += 1;
        points += 1;
-       ac.grid4=deGrid;
-       ac.bands=".......";
-       ac.az=nAz;
-       ac.points=points;
-       m_activeCall[deCall]=ac;
+       m_stationActivity.set_location(deCall,deGrid,nAz,points);
      }
   }
 
   m_points=-1;
-  if(m_activeCall.contains(deCall)) {
+  if(m_stationActivity.contains(deCall)) {
 
 // Don't display stations we already worked on this band.
     QString band=m_config.bands()->find(m_freqNominal);
-    if(band=="160m" and m_activeCall[deCall].bands.indexOf("a")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="80m"  and m_activeCall[deCall].bands.indexOf("b")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="40m"  and m_activeCall[deCall].bands.indexOf("c")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="20m"  and m_activeCall[deCall].bands.indexOf("d")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="15m"  and m_activeCall[deCall].bands.indexOf("e")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="10m"  and m_activeCall[deCall].bands.indexOf("f")>=0) {m_recentCall.remove(deCall); return;}
-    if(band=="6m"   and m_activeCall[deCall].bands.indexOf("g")>=0) {m_recentCall.remove(deCall); return;}
+    if(m_stationActivity.worked(deCall,band)) {m_stationActivity.forget(deCall); return;}
 
     // Update the variable data for this deCall
-    rc.dialFreq=m_freqNominal;
-    rc.audioFreq=dt.frequencyOffset();
+    StationActivity::Decode rc;
+    rc.dial_frequency=m_freqNominal;
+    rc.audio_frequency=dt.frequencyOffset();
     rc.snr=dt.snr();
     m_latestDecodeTime=dt.timeInSeconds();
-    rc.txEven = (m_latestDecodeTime % int(2*m_TRperiod)) > 0;
-    rc.ready2call=false;
+    rc.tx_even = (m_latestDecodeTime % int(2*m_TRperiod)) > 0;
     bool bCQ=dt.messageWords()[0].left(3)=="CQ ";
-    if(bCQ or deGrid=="RR73" or deGrid=="73") rc.ready2call=true;
-    rc.decodeTime=m_latestDecodeTime;
-    m_recentCall[deCall]=rc;
-    m_points=m_activeCall.value(deCall).points;
+    rc.ready_to_call = bCQ or deGrid=="RR73" or deGrid=="73";
+    rc.time=m_latestDecodeTime;
+    m_stationActivity.heard(deCall,rc);
+    m_points=m_stationActivity.points(deCall);
   }
   updateRate();
 }
@@ -4992,78 +5089,13 @@ void MainWindow::ARRL_Digi_Display()
     }
     return;
   }
-  QMutableMapIterator<QString,RecentCall> icall(m_recentCall);
-  QString deCall,deGrid;
-  int age=0;
-  int i=0;
-  int maxAge=m_ActiveStationsWidget->maxAge();
-  int points=0;
-  int maxPoints=0;
-  int indx[1000];
-  float pts[1000];
-  QStringList list;
-
-  while (icall.hasNext()) {
-    icall.next();
-    deCall=icall.key();
-    age=int((m_latestDecodeTime - icall.value().decodeTime)/m_TRperiod + 0.5);
-    if(age<0) age=age + int(86400/m_TRperiod);
-    int itx=1;
-    if(icall.value().txEven) itx=0;
-    int snr=icall.value().snr;
-    int freq=icall.value().audioFreq;
-    if(age>maxAge) {
-      icall.remove();
-    } else {
-      bool bReady=false;
-      if(age==0 and m_recentCall.value(deCall).ready2call) bReady=true;
-
-      QString bands=m_activeCall[deCall].bands;
-      bool bWorkedOnBand=false;
-      if(m_currentBand=="160m" and bands.mid(0,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="80m"  and bands.mid(1,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="40m"  and bands.mid(2,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="20m"  and bands.mid(3,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="15m"  and bands.mid(4,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="10m"  and bands.mid(5,1)!=".") bWorkedOnBand=true;
-      if(m_currentBand=="6m"   and bands.mid(6,1)!=".") bWorkedOnBand=true;
-
-      if((bReady or !m_ActiveStationsWidget->readyOnly()) and !bWorkedOnBand) {
-        i++;
-        int az=m_activeCall[deCall].az;
-        deGrid=m_activeCall[deCall].grid4;
-        points=m_activeCall[deCall].points;
-        if(points>maxPoints) maxPoints=points;
-        float x=float(age)/(maxAge+1);
-        if(x>1.0) x=0;
-        pts[i-1]=points - x;
-        QString t1;
-        if(!bReady) t1 = t1.asprintf("  %3d  %+2.2d  %4d  %1d %2d %4d",az,snr,freq,itx,age,points);
-        if(bReady)  t1 = t1.asprintf("  %3d  %+2.2d  %4d  %1d %2d*%4d",az,snr,freq,itx,age,points);
-//        t1 = (deCall + "   ").left(6) + "  " + m_activeCall[deCall].grid4 + t1 + "  " + bands;
-        t1 = (deCall + "   ").left(6) + "  " + m_activeCall[deCall].grid4 + t1;
-        list.append(t1);
-      }
-    }
-  }
-  if(i==0) return;
-  int jz=i;
-  m_ActiveStationsWidget->setClickOK(false);
-  int maxRecent=qMin(i,m_ActiveStationsWidget->maxRecent());
-  indexx_(pts,&jz,indx);
-  QString t;
-  i=0;
-  for(int j=jz-1; j>=0; j--) {
-    int k=indx[j]-1;
-    m_ready2call[i]=list[k];
-    i++;
-    QString t1=QString::number(i) + ".  ";
-    if(i<10) t1=" " + t1;
-    t += (t1 + list[k] + "\n");
-    if(i>=maxRecent) break;
-  }
+  m_stationActivity.refresh(m_latestDecodeTime,m_TRperiod,m_ActiveStationsWidget->maxAge(),
+                            m_ActiveStationsWidget->maxRecent(),m_ActiveStationsWidget->readyOnly(),
+                            m_currentBand);
+  int nrows=qMin(m_stationActivity.rowCount(),50);
+  for(int i=0; i<nrows; i++) m_ready2call[i]=m_stationActivity.station_text(i);
   bool is_fox_mode = (m_mode=="FT8" && m_specOp == SpecOp::FOX);
-  if(m_ActiveStationsWidget!=NULL && !is_fox_mode) m_ActiveStationsWidget->displayRecentStations(m_mode,t);
+  if(!is_fox_mode) m_ActiveStationsWidget->setupUi(m_mode);
   m_ActiveStationsWidget->setClickOK(true);
 }
 
@@ -5197,16 +5229,7 @@ void MainWindow::callSandP2(int n)
 
 void MainWindow::activeWorked(QString call, QString band)
 {
-  QString bands=m_activeCall[call].bands;
-  QByteArray ba=bands.toLatin1();
-  if(band=="160m") ba[0]='a';
-  if(band=="80m")  ba[1]='b';
-  if(band=="40m")  ba[2]='c';
-  if(band=="20m")  ba[3]='d';
-  if(band=="15m")  ba[4]='e';
-  if(band=="10m")  ba[5]='f';
-  if(band=="6m")   ba[6]='g';
-  m_activeCall[call].bands=QString::fromLatin1(ba);
+  m_stationActivity.set_worked(call,band);
 }
 
 void MainWindow::readFromStdout()                             //readFromStdout
@@ -6837,11 +6860,10 @@ void MainWindow::guiUpdate()
               QString foxCall=m_config.my_callsign() + "         ";
               ::memcpy(foxcom_.mycall, foxCall.toLatin1(), sizeof foxcom_.mycall); //Copy Fox callsign into foxcom_
               bool bSuperFox=m_config.superFox();
-              auto fname {QDir::toNativeSeparators(m_config.writeable_data_dir().absoluteFilePath("sfox_1.dat")).toLocal8Bit()};
               foxcom_.bMoreCQs=ui->cbMoreCQs->isChecked();
               foxcom_.bSendMsg=ui->cbSendMsg->isChecked();
               memcpy(foxcom_.textMsg, m_freeTextMsg.leftJustified(26,' ').toLatin1(),26);
-              foxgen_(&bSuperFox, fname.constData(), (FCL)fname.size());
+              foxgen_(&bSuperFox);
               if(bSuperFox) {
                 writeFoxTxMsgs();
                 sfox_tx();
@@ -7043,6 +7065,7 @@ void MainWindow::guiUpdate()
         }
       }
     }
+    Q_EMIT transmitTonesChanged (); // foxcom_.wave may have been rewritten
     m_restart=false;
 //----------------------------------------------------------------------
   } else {
@@ -9405,7 +9428,7 @@ void MainWindow::acceptQSO (QDateTime const& QSO_date_off, QString const& call,
     } else if (m_specOp==SpecOp::ARRL_DIGI) {
       QString band=m_config.bands()->find(dial_freq);
       activeWorked(call,band);
-      int points=m_activeCall[call].points;
+      int points=m_stationActivity.points(call);
       m_score += points;
       ARRL_logged al;
       al.time=QDateTime::currentDateTimeUtc();
@@ -9486,7 +9509,7 @@ void MainWindow::displayWidgets(qint64 n)
     if(i==20) ui->actionInclude_averaging->setVisible (b);
     if(i==21) ui->actionInclude_correlation->setVisible (b);
     if(i==22) {
-      if(!b && m_echoGraph->isVisible())  m_echoGraph->hide();
+      if(!b && m_echoGraph && m_echoGraph->isVisible())  m_echoGraph->hide();
     }
     if(i==23) ui->cbSWL->setVisible(b);
     if(i==24) ui->actionEnable_AP_FT8->setVisible (b);
@@ -9541,7 +9564,7 @@ void MainWindow::on_actionFST4_triggered()
   ui->actionFST4->setChecked(true);
   m_bFast9=false;
   m_bFastMode=false;
-  m_fastGraph->hide();
+  if (m_fastGraph) m_fastGraph->hide();
   m_wideGraph->show();
   m_nsps=6912;                   //For symspec only
   m_FFTSize = m_nsps / 2;
@@ -9587,7 +9610,7 @@ void MainWindow::on_actionFST4W_triggered()
   ui->actionFST4W->setChecked(true);
   m_bFast9=false;
   m_bFastMode=false;
-  m_fastGraph->hide();
+  if (m_fastGraph) m_fastGraph->hide();
   m_wideGraph->show();
   m_nsps=6912;                   //For symspec only
   m_FFTSize = m_nsps / 2;
@@ -9641,7 +9664,7 @@ void MainWindow::on_actionFT4_triggered()
   m_send_RR73=true;
   VHF_features_enabled(bVHF);
   ui->cbAutoSeq->setChecked(true);
-  m_fastGraph->hide();
+  if (m_fastGraph) m_fastGraph->hide();
   m_wideGraph->show();
   ui->rh_decodes_headings_label->setText("  UTC   dB   DT Freq    " + tr ("Message"));
   m_wideGraph->setPeriod(m_TRperiod,m_nsps);
@@ -9691,7 +9714,7 @@ void MainWindow::on_actionFT8_triggered()
   ui->cbAutoSeq->setChecked(true);
   m_TRperiod=15.0;
   ui->sbFtol->setValue (m_settings->value ("Ftol_SF", 50).toInt()); // restore last used Ftol parameter
-  m_fastGraph->hide();
+  if (m_fastGraph) m_fastGraph->hide();
   m_wideGraph->show();
   ui->rh_decodes_headings_label->setText("  UTC   dB   DT Freq    " + tr ("Message"));
   m_wideGraph->setPeriod(m_TRperiod,m_nsps);
@@ -9919,7 +9942,7 @@ void MainWindow::on_actionJT9_triggered()
     if(bVHF && m_mode!="JT65" && !blocked) ui->sbTR->setValue (m_settings->value ("TRPeriod", 15).toInt());  // restore last used TRperiod
     on_sbTR_valueChanged (ui->sbTR->value());
     m_wideGraph->hide();
-    m_fastGraph->showNormal();
+    fastGraph()->showNormal();
     ui->TxFreqSpinBox->setValue(700);
     ui->RxFreqSpinBox->setValue(700);
     ui->lh_decodes_headings_label->setText("  UTC   dB    T Freq    " + tr ("Message"));
@@ -10138,7 +10161,7 @@ void MainWindow::on_actionMSK144_triggered()
   m_bShMsgs=m_settings->value("ShMsgs_MSK144",false).toBool();
   ui->cbShMsgs->setChecked(m_bShMsgs);
   m_wideGraph->hide();
-  m_fastGraph->showNormal();
+  fastGraph()->showNormal();
   ui->TxFreqSpinBox->setValue(1500);
   ui->RxFreqSpinBox->setValue(1500);
   ui->RxFreqSpinBox->setMinimum(1400);
@@ -10148,7 +10171,7 @@ void MainWindow::on_actionMSK144_triggered()
   ui->rh_decodes_headings_label->setText("  UTC   dB    T Freq    " + tr ("Message"));
   m_modulator->setTRPeriod(m_TRperiod); // TODO - not thread safe
   m_detector->setTRPeriod(m_TRperiod);  // TODO - not thread safe
-  m_fastGraph->setTRPeriod(m_TRperiod);
+  if (m_fastGraph) m_fastGraph->setTRPeriod (m_TRperiod);
   ui->lh_decodes_title_label->setText(tr ("Band Activity"));
   ui->rh_decodes_title_label->setText(tr ("Tx Messages"));
   ui->actionMSK144->setChecked(true);
@@ -10235,7 +10258,7 @@ void MainWindow::on_actionEcho_triggered()
   m_wideGraph->setMode(m_mode);
   ui->TxFreqSpinBox->setValue(1500);
   ui->TxFreqSpinBox->setEnabled (false);
-  if(!m_echoGraph->isVisible()) m_echoGraph->show();
+  if(!echoGraph()->isVisible()) m_echoGraph->show();
   if (!ui->actionAstronomical_data->isChecked ()) {
     ui->actionAstronomical_data->setChecked (true);
   }
@@ -10246,7 +10269,7 @@ void MainWindow::on_actionEcho_triggered()
   //                       01234567890123456789012345678901234567
   displayWidgets(nWidgets("00000000000000000010001000000000000000"));
   fast_config(false);
-  ui->sbEchoAvg->values ({1, 2, 5, 10, 20, 50, 100});
+  ui->sbEchoAvg->values ({1, 2, 5, 10, 20, 50, 100, 200, 500, 1000});
   statusChanged();
   monitor(false);
 }
@@ -10292,7 +10315,7 @@ void MainWindow::switch_mode (Mode mode)
       ui->tx1->setEnabled(true);
       ui->txb1->setEnabled(true);
    }
-  m_fastGraph->setMode(m_mode);
+  if (m_fastGraph) m_fastGraph->setMode(m_mode);
   m_config.frequencies ()->filter (m_config.region (), mode, true); // filter on current time
   auto const& row = m_config.frequencies ()->best_working_frequency (m_freqNominal);
   if (!keep_frequency) {
@@ -10369,10 +10392,10 @@ void MainWindow::fast_config(bool b)
   ui->sbTR->setVisible(b);
   if(b and (m_bFast9 or m_mode=="MSK144")) {
     m_wideGraph->hide();
-    m_fastGraph->showNormal();
+    fastGraph()->showNormal();
   } else {
     m_wideGraph->showNormal();
-    m_fastGraph->hide();
+    if (m_fastGraph) m_fastGraph->hide();
   }
 }
 
@@ -10505,8 +10528,7 @@ void MainWindow::on_actionErase_ALL_TXT_triggered()          //Erase ALL.TXT
   int ret = MessageBox::query_message (this, tr ("Confirm Erase"),
                                          tr ("Are you sure you want to erase file ALL.TXT?"));
   if(ret==MessageBox::Yes) {
-    QFile f {m_config.writeable_data_dir ().absoluteFilePath ("ALL.TXT")};
-    f.remove();
+    m_allTxt.remove (m_config.writeable_data_dir ().absoluteFilePath ("ALL.TXT"));
     m_RxLog=1;
   }
 }
@@ -10531,7 +10553,7 @@ void MainWindow::on_reset_cabrillo_log_action_triggered ()
     {
       if(m_config.RTTY_Exchange()!="SCC") ui->sbSerialNumber->setValue(1);
       m_logBook.contest_log ()->reset ();
-      m_activeCall.clear();                      //Erase the QMap of active calls
+      m_stationActivity.clear();                 //Erase the active calls
       m_EMECall.clear();                         //ditto for EME calls
       m_score=0;
       if (m_ActiveStationsWidget) {
@@ -11037,7 +11059,7 @@ void MainWindow::handle_transceiver_update (Transceiver::TransceiverState const&
                || !(ui->cbCQTx->isEnabled () && ui->cbCQTx->isVisible () && ui->cbCQTx->isChecked()))) {
 
             if (m_lastDialFreq != m_freqNominal and m_ActiveStationsWidget != NULL) {
-              m_recentCall.clear();
+              m_stationActivity.forget_all();
               if(m_mode!="Q65") m_ActiveStationsWidget->erase();
             }
 
@@ -11483,7 +11505,7 @@ void MainWindow::on_sbTR_valueChanged(int value)
               }
           }
        } 
-    m_fastGraph->setTRPeriod (value);
+    if (m_fastGraph) m_fastGraph->setTRPeriod (value);
     m_modulator->setTRPeriod (value); // TODO - not thread safe
     m_detector->setTRPeriod (value);  // TODO - not thread safe
     m_wideGraph->setPeriod (value, m_nsps);
@@ -13238,12 +13260,12 @@ Transmit:
 //  qDebug() << "cc" << foxcom_.bMoreCQs << foxcom_.bSendMsg << foxcom_.nslots
 //           << m_Nslots << m_freeTextMsg0;
   ::memcpy(foxcom_.textMsg, m_freeTextMsg0.leftJustified(26,' ').toLatin1(),26);
-  auto fname {QDir::toNativeSeparators(m_config.writeable_data_dir().absoluteFilePath("sfox_1.dat")).toLocal8Bit()};
-  foxgen_(&bSuperFox, fname.constData(), (FCL)fname.size());
+  foxgen_(&bSuperFox);
   if(bSuperFox) {
     writeFoxTxMsgs();
     sfox_tx();
   }
+  Q_EMIT transmitTonesChanged ();   // new foxcom_.wave, also mid transmission
   m_tFoxTxSinceCQ++;
 
   for(QString hc: m_foxQSO.keys()) {               //Check for strikeout or timeout
@@ -13596,23 +13618,9 @@ void MainWindow::write_all(QString txRx, QString message)
     line=message;
   }
 
-  QFile f{m_config.writeable_data_dir().absoluteFilePath(file_name)};
-  if (f.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-    QTextStream out(&f);
-    out << line.trimmed()
-#if QT_VERSION >= QT_VERSION_CHECK (5, 15, 0)
-        << Qt::endl
-#else
-        << endl
-#endif
-      ;
-    f.close();
-  } else {
-    auto const& message2 = tr ("Cannot open \"%1\" for append: %2")
-        .arg (f.fileName ()).arg (f.errorString ());
-    QTimer::singleShot (0, [=] {                   // don't block guiUpdate
-      MessageBox::warning_message(this, tr ("Log File Error"), message2); });
-  }
+  // written on the journal's own thread, errors come back through
+  // its error signal
+  m_allTxt.append (m_config.writeable_data_dir ().absoluteFilePath (file_name), line.trimmed ());
  }
 }
 
@@ -13862,7 +13870,6 @@ void MainWindow::on_echoButton_clicked()
 }
 
 void MainWindow::sfox_tx() {
-  auto fname{QDir::toNativeSeparators(m_config.writeable_data_dir().absoluteFilePath("sfox_1.dat")).toLocal8Bit()};
   QString ckey{"OTP:000000"};
   LOG_INFO(QString("sfox_tx: OTP code is %1").arg(foxOTPcode()));
 #ifdef FOX_OTP
@@ -13889,8 +13896,15 @@ void MainWindow::sfox_tx() {
       }
   }
 #endif
+  // Encode and generate the waveform straight into foxcom_.wave, in
+  // time for the start of the Tx slot
+  QElapsedTimer timer;
+  timer.start ();
   sftx_sub_(ckey.toLatin1().constData(), (FCL)ckey.size());
   sfox_wave_gfsk_();
+  auto ms = timer.nsecsElapsed () / 1.e6;
+  LOG_INFO(QString("sfox_tx: waveform generated in %1 ms").arg(ms, 0, 'f', 1));
+  if (ms > 50.) LOG_WARN(QString("sfox_tx: waveform generation took over 50 ms"));
 }
 
 void MainWindow::on_pb30B_clicked()
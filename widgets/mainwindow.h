@@ -42,6 +42,10 @@
 #include "Network/PSKReporter.hpp"
 #include "Network/Cloudlog.hpp"
 #include "logbook/logbook.h"
+#include "logbook/AllTxtJournal.hpp"
+#include "Audio/RxArchive.hpp"
+#include "Network/SpectrumFeed.hpp"
+#include "models/StationActivity.hpp"
 #include "astro.h"
 #include "MessageBox.hpp"
 #include "Network/NetworkAccessManager.hpp"
@@ -212,6 +216,7 @@ private slots:
   void on_actionOpen_log_directory_triggered ();
   void on_actionNone_triggered();
   void on_actionSave_all_triggered();
+  void on_actionArchive_all_triggered();
   void on_actionDefault_event_logging_triggered();
   void on_actionDiagnostic_mode_triggered();
   void on_actionDisable_event_logging_triggered();
@@ -406,6 +411,7 @@ private:
   Q_SIGNAL void detectorClose () const;
   Q_SIGNAL void finished () const;
   Q_SIGNAL void transmitFrequency (double) const;
+  Q_SIGNAL void transmitTonesChanged () const;
   Q_SIGNAL void endTransmitMessage (bool quick = false) const;
   Q_SIGNAL void tune (bool = true) const;
   Q_SIGNAL void sendMessage (QString mode, unsigned symbolsLength,
@@ -584,6 +590,7 @@ private:
   bool    m_startAnother;
   bool    m_saveDecoded;
   bool    m_saveAll;
+  bool    m_archiveAll;
   bool    m_widebandDecode;
   bool    m_call3Modified;
   bool    m_dataAvailable;
@@ -674,6 +681,7 @@ private:
   QFutureWatcher<void> m_wav_future_watcher;
   QFutureWatcher<void> watcher3;
   QFutureWatcher<QString> m_saveWAVWatcher;
+  QFutureWatcher<QString> m_archiveWatcher;
 
   NonInheritingProcess proc_jt9;
   NonInheritingProcess p1;
@@ -767,14 +775,7 @@ private:
   };
   QMap<QString,FixupQSO> m_fixupQSO;       //Key = HoundCall, value = info for QSO in progress
 
-  struct ActiveCall
-  {
-    QString grid4;
-    QString bands;
-    qint32 az;
-    qint32 points;
-  };
-  QMap<QString,ActiveCall> m_activeCall;   //Key = callsign, value = grid4, az, points for ARRL_DIGI
+  StationActivity m_stationActivity;       //Calls heard with grid4, az, points, bands worked for ARRL_DIGI
 
   struct EMECall
   {
@@ -791,16 +792,6 @@ private:
 
   QMap<QString,bool> m_EMEworked;
 
-  struct RecentCall
-  {
-    qint64 dialFreq;
-    qint32 audioFreq;
-    qint32 snr;
-    qint32 decodeTime;
-    bool   txEven;
-    bool   ready2call;
-  };
-  QMap<QString,RecentCall> m_recentCall;   //Key = callsign, value = snr, dialFreq, audioFreq, decodeTime
   struct ARRL_logged
   {
     QDateTime time;
@@ -842,6 +833,10 @@ private:
   QTimer m_heartbeat;
   MessageClient * m_messageClient;
   PSKReporter m_psk_Reporter;
+  AllTxtJournal m_allTxt;
+  RxArchive m_rxArchive;
+  SpectrumFeed m_spectrumFeed;
+  QString m_spectrumFeedFailedKey; // not retried until it changes
   DisplayManual m_manual;
   QHash<QString, QVariant> m_pwrBandTxMemory; // Remembers power level by band
   QHash<QString, QVariant> m_pwrBandTuneMemory; // Remembers power level by band for tuning
@@ -905,6 +900,9 @@ private:
                           , Frequency frequency
                           , QString const& his_call
                           , QString const& his_grid) const;
+  void archive_rx_period (QDateTime const& period_start, int samples, Frequency);
+  EchoGraph * echoGraph ();
+  FastGraph * fastGraph ();
   void hound_reply ();
   QString sortHoundCalls(QString t, int isort, int max_dB);
   void rm_tb4(QString houndCall);
@@ -60,7 +60,7 @@ include(Transceiver/Transceiver.pri)
 include(Network/Network.pri)
 
 SOURCES += \
-  ExceptionCatchingApplication.cpp Logger.cpp WSJTXLogging.cpp \
+  ExceptionCatchingApplication.cpp Logger.cpp StartupTimer.cpp WSJTXLogging.cpp \
   Radio.cpp NetworkServerLookup.cpp revision_utils.cpp \
   Configuration.cpp PSK_Reporter.cpp NonInheritingProcess.cpp \
   getfile.cpp \
@@ -76,7 +76,7 @@ SOURCES += \
 HEADERS  += qt_helpers.hpp qt_db_helpers.hpp \
   helper_functions.h \
   pimpl_h.hpp pimpl_impl.hpp \
-  ExceptionCatchingApplication.hpp Logger.hpp WSJTXLogging.hpp \
+  ExceptionCatchingApplication.hpp Logger.hpp StartupTimer.hpp WSJTXLogging.hpp \
   Radio.hpp NetworkServerLookup.hpp revision_utils.hpp \
   WFPalette.hpp getfile.h decodedtext.h \
   commons.h sleep.h \